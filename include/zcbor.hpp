@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZCBOR_HPP__
+#define ZCBOR_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#if __has_include(<version>)
+#include <version>
+#endif
+#ifdef __cpp_lib_span
+#include <span>
+#endif
+#include "zcbor_common.h"
+
+/** The C++ layer on top of the generated C code (see --cpp).
+ *
+ *  The generated <project>.hpp has a class for each generated struct, which gives typed access to
+ *  the struct's members without copying them, and a <Type>_codec struct for each entry type, which
+ *  calls the generated C functions. This file has the common types and the functions that take the
+ *  codecs as template arguments. Needs C++17.
+ */
+namespace zcbor {
+
+#ifdef __cpp_lib_span
+template <typename T>
+using span = std::span<T>;
+#else
+/** The subset of std::span (C++20) that is used here, for C++17. */
+template <typename T>
+class span {
+public:
+	using element_type = T;
+	using value_type = std::remove_cv_t<T>;
+	using iterator = T *;
+
+	constexpr span() noexcept = default;
+	constexpr span(T *data, size_t size) noexcept : data_(data), size_(size) {}
+	template <size_t N>
+	constexpr span(T (&array)[N]) noexcept : data_(array), size_(N) {}
+	template <typename C, typename = std::enable_if_t<
+		std::is_convertible_v<decltype(std::data(std::declval<C &>())), T *>>>
+	constexpr span(C &container) noexcept : data_(std::data(container)), size_(std::size(container)) {}
+	template <typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+	constexpr span(const span<U> &other) noexcept : data_(other.data()), size_(other.size()) {}
+
+	constexpr T *data() const noexcept { return data_; }
+	constexpr size_t size() const noexcept { return size_; }
+	constexpr bool empty() const noexcept { return size_ == 0; }
+	constexpr T &operator[](size_t i) const { return data_[i]; }
+	constexpr iterator begin() const noexcept { return data_; }
+	constexpr iterator end() const noexcept { return data_ + size_; }
+	constexpr span first(size_t count) const { return {data_, count}; }
+	constexpr span subspan(size_t offset) const { return {data_ + offset, size_ - offset}; }
+
+private:
+	T *data_ = nullptr;
+	size_t size_ = 0;
+};
+#endif
+
+/** The contents of a bstr, or a payload. */
+using bytes = span<const uint8_t>;
+
+/** The type of the codecs and views of types that have no result. */
+struct none {};
+
+
+/** Convert a member of a generated struct to the C++ type that its view returns it as (R).
+ *
+ *  tstrs become std::string_view, bstrs zcbor::bytes, and structs their views. Other values,
+ *  e.g. integers and enums, are returned as they are.
+ */
+template <typename R, typename T>
+constexpr R value(const T &member)
+{
+	if constexpr (std::is_same_v<R, std::string_view>) {
+		return R(reinterpret_cast<const char *>(member.value), member.len);
+	} else if constexpr (std::is_same_v<R, bytes>) {
+		return R(member.value, member.len);
+	} else if constexpr (std::is_same_v<R, T>) {
+		return member;
+	} else {
+		return R(member);
+	}
+}
+
+
+/** Like value(), but return std::nullopt if the member is not present. */
+template <typename R, typename T>
+constexpr std::optional<R> optional(bool present, const T &member)
+{
+	if (!present) {
+		return std::nullopt;
+	}
+	return value<R>(member);
+}
+
+
+/** Make a struct zcbor_string (for encoding) that points to @p str. */
+inline zcbor_string string(std::string_view str)
+{
+	return {reinterpret_cast<const uint8_t *>(str.data()), str.size()};
+}
+
+
+/** Make a struct zcbor_string (for encoding) that points to @p str. */
+inline zcbor_string string(bytes str)
+{
+	return {str.data(), str.size()};
+}
+
+
+/** A read-only range over a repeated member of a generated struct, i.e. over an array of the C
+ *  type T, which returns the elements as the C++ type R (see value()).
+ */
+template <typename R, typename T>
+class list_view {
+public:
+	using value_type = R;
+
+	class iterator {
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = R;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = R;
+
+		constexpr explicit iterator(const T *elem) : elem_(elem) {}
+
+		constexpr R operator*() const { return value<R>(*elem_); }
+		constexpr R operator[](difference_type i) const { return value<R>(elem_[i]); }
+		constexpr iterator &operator++() { ++elem_; return *this; }
+		constexpr iterator operator++(int) { return iterator(elem_++); }
+		constexpr iterator &operator--() { --elem_; return *this; }
+		constexpr iterator operator--(int) { return iterator(elem_--); }
+		constexpr iterator &operator+=(difference_type n) { elem_ += n; return *this; }
+		constexpr iterator &operator-=(difference_type n) { elem_ -= n; return *this; }
+		constexpr iterator operator+(difference_type n) const { return iterator(elem_ + n); }
+		constexpr iterator operator-(difference_type n) const { return iterator(elem_ - n); }
+		constexpr difference_type operator-(const iterator &other) const { return elem_ - other.elem_; }
+		constexpr bool operator==(const iterator &other) const { return elem_ == other.elem_; }
+		constexpr bool operator!=(const iterator &other) const { return elem_ != other.elem_; }
+		constexpr bool operator<(const iterator &other) const { return elem_ < other.elem_; }
+
+	private:
+		const T *elem_;
+	};
+
+	constexpr list_view(const T *elems, size_t count) : elems_(elems), count_(count) {}
+
+	constexpr size_t size() const { return count_; }
+	constexpr bool empty() const { return count_ == 0; }
+	constexpr R operator[](size_t i) const { return value<R>(elems_[i]); }
+	constexpr iterator begin() const { return iterator(elems_); }
+	constexpr iterator end() const { return iterator(elems_ + count_); }
+
+	/** The elements as their C type. */
+	constexpr span<const T> c_elems() const { return {elems_, count_}; }
+
+private:
+	const T *elems_;
+	size_t count_;
+};
+
+
+/** Decode @p payload as the entry type of @p Codec into @p result.
+ *
+ *  @p args are the extra arguments of the entry function, e.g. the arena with --repeated-arena.
+ *
+ *  @return A view of @p result, or std::nullopt if decoding failed. Use Codec::decode() directly
+ *          to get the error code or the length of the decoded payload.
+ */
+template <typename Codec, typename... Args>
+std::optional<typename Codec::view_type> decode(bytes payload,
+		typename Codec::c_type &result, Args... args)
+{
+	static_assert(Codec::can_decode, "The code was generated without --decode.");
+
+	if (Codec::decode(payload.data(), payload.size(), &result, nullptr, args...) != ZCBOR_SUCCESS) {
+		return std::nullopt;
+	}
+	return Codec::view(result);
+}
+
+
+/** Encode @p input as the entry type of @p Codec into @p payload.
+ *
+ *  @p args are the extra arguments of the entry function, if any.
+ *
+ *  @return The encoded part of @p payload, or std::nullopt if encoding failed. Use
+ *          Codec::encode() directly to get the error code.
+ */
+template <typename Codec, typename... Args>
+std::optional<bytes> encode(span<uint8_t> payload,
+		const typename Codec::c_type &input, Args... args)
+{
+	static_assert(Codec::can_encode, "The code was generated without --encode.");
+	size_t payload_len_out;
+
+	if (Codec::encode(payload.data(), payload.size(), &input, &payload_len_out, args...)
+			!= ZCBOR_SUCCESS) {
+		return std::nullopt;
+	}
+	return bytes(payload.data(), payload_len_out);
+}
+
+} /* namespace zcbor */
+
+#endif /* ZCBOR_HPP__ */
@@ -42,6 +42,20 @@ struct zcbor_string {
 	size_t len;
 };
 
+/** Compact alternative to struct zcbor_string, for keeping many decoded strings around.
+ *
+ *  The string is stored as a 32-bit offset from a base pointer and a 32-bit length,
+ *  so it is half the size of struct zcbor_string on 64-bit platforms.
+ *  The base pointer is not stored, so it must be provided to access the string, see
+ *  @ref zcbor_string_off_ptr and @ref zcbor_string_off_get.
+ *  When decoding with ZCBOR_STRING_OFFSETS, the base pointer is the start of the payload,
+ *  see @ref zcbor_bstr_off_decode.
+ */
+struct zcbor_string_off {
+	uint32_t offset; ///! The offset of the string from the base pointer.
+	uint32_t len;    ///! The length of the string.
+};
+
 
 /** Type representing a string fragment.
  *
@@ -57,6 +71,26 @@ struct zcbor_string_fragment {
 /** Size to use in struct zcbor_string_fragment when the real size is unknown. */
 #define ZCBOR_STRING_FRAGMENT_UNKNOWN_LENGTH SIZE_MAX
 
+/** A position inside a payload, recorded with zcbor_view_pos_record().
+ *
+ *  Used in the view structs generated with --view-entry-types, to decode single
+ *  members on demand, see @ref zcbor_view_entry_function_with_elem_states.
+ */
+struct zcbor_view_pos {
+	size_t offset;     ///! The offset of the position from the start of the encoded value.
+	size_t elem_count; ///! The elem_count of the state at the position.
+};
+
+/** The state of an incremental UTF-8 validation, see @ref zcbor_validate_utf8_partial.
+ *
+ *  Zero-initialize before validating the first part of a string.
+ */
+struct zcbor_utf8_state {
+	uint8_t num_cont; ///! The number of continuation bytes still expected.
+	uint8_t min;      ///! The smallest allowed value of the next continuation byte.
+	uint8_t max;      ///! The largest allowed value of the next continuation byte.
+};
+
 #ifndef MIN
 #define MIN(a, b) (((a) < (b)) ? (a) : (b))
 #endif
@@ -85,6 +119,31 @@ struct zcbor_string_fragment {
 #warning "zcbor: Unsupported size_t encoding size"
 #endif
 
+#ifdef ZCBOR_ARENA
+#ifndef ZCBOR_ARENA_ALIGN
+#define ZCBOR_ARENA_ALIGN 8 ///! The alignment of all allocations from a struct zcbor_arena. Must be a power of 2.
+#endif
+
+/** A bump allocator for the elements of repeated members, see @ref zcbor_multi_decode_arena.
+ *
+ *  Finished arrays are placed consecutively from the start of the buffer. While an array is
+ *  being decoded, its elements are placed at the end of the buffer, so that nested arrays can
+ *  be placed at the start in the meantime. When the array is finished, its elements are copied
+ *  to the start.
+ *
+ *  Initialize with @ref zcbor_arena_init or @ref zcbor_arena_count_init.
+ *  Don't modify any member variables while decoding.
+ */
+struct zcbor_arena {
+	uint8_t *buf;
+	size_t size;
+	size_t used; ///! The number of bytes used by finished arrays, from the start of buf.
+	size_t scratch; ///! The number of bytes used by arrays that are being decoded, from the end of buf.
+	size_t peak; ///! The largest number of bytes that has been needed at any one time.
+	bool count_only; ///! Whether finished arrays are only counted in used, and not stored.
+};
+#endif
+
 struct zcbor_state_constant;
 
 /** The zcbor_state_t structure is used for both encoding and decoding. */
@@ -124,6 +183,17 @@ union {
 	                                 started in this payload section. */
 	size_t str_total_len_cbor; /**< The total length of the string this fragment is a part of.
 	                                Used for CBOR-encoded strings. */
+#ifdef ZCBOR_VALIDATE_UTF8
+	bool frag_str_utf8; /**< True if the current fragmented string is a tstr being decoded,
+	                         so its fragments are validated as UTF-8. */
+	struct zcbor_utf8_state frag_utf8; /**< The UTF-8 validation state between fragments. */
+#endif
+#endif
+#ifdef ZCBOR_STRING_OFFSETS
+	const uint8_t *string_base; /**< The base pointer of the struct zcbor_string_off
+	                                 values that are decoded or encoded. The default/initial
+	                                 value is the payload pointer the state was created with.
+	                                 Not changed by @ref zcbor_update_state. */
 #endif
 
 /* This is the "decode state", the part of zcbor_state_t that is only used by zcbor_decode.c. */
@@ -136,9 +206,11 @@ struct {
 #ifdef ZCBOR_MAP_SMART_SEARCH
 	bool elem_state_backed_up; /**< Is set to true if the map elements have been backed up.
 	                                This flag is used internally by the backup process. */
-	uint8_t *map_search_elem_state; /**< This buffer is a single continuous array of bytes,
-	which are all used as 1 bit flags. If flag n is cleared, element n of the current unordered
-	map is skipped when searching the map with @ref zcbor_unordered_map_search.
+	uint8_t *map_search_elem_state; /**< This buffer is a single continuous array of
+	@ref zcbor_flag_word_t words, which are all used as 1 bit flags. If flag n is cleared,
+	element n of the current unordered map is skipped when searching the map with
+	@ref zcbor_unordered_map_search. Whole words are scanned at a time, so runs of processed
+	elements are skipped without testing each flag.
 
 	These flags are manipulated via @ref zcbor_elem_processed, or (when manually_process_elem is
 	set) automatically by @ref zcbor_unordered_map_search, and should not be manipulated directly.
@@ -176,11 +248,41 @@ struct {
 	size_t map_elem_count; /**< Number of elements in the current unordered map.
 	                            This also serves as the number of bits (not bytes)
 	                            in the map_search_elem_state array (when applicable). */
+#ifdef ZCBOR_WORK_BUDGET
+	size_t work_budget; /**< The number of decoding steps left before decoding fails with
+	                         ZCBOR_ERR_WORK_BUDGET. See @ref zcbor_work_spend. Not restored
+	                         together with the rest of the state when restoring a backup. */
+#endif
+#ifdef ZCBOR_ARENA
+	struct zcbor_arena *arena; /**< Where @ref zcbor_multi_decode_arena places the decoded
+	                                elements. The default/initial value is NULL. */
+#endif
+#ifdef ZCBOR_BSTR_STREAM
+	const struct zcbor_chunk_handler *chunk_handler; /**< Receives the contents of bstrs
+	                                                      decoded with @ref zcbor_bstr_stream_decode.
+	                                                      Set this directly. The default/initial
+	                                                      value is NULL. */
+#endif
 } decode_state;
 	struct zcbor_state_constant *constant_state; /**< The part of the state that is
 	                                                  not backed up and duplicated. */
 } zcbor_state_t;
 
+/** Callback that receives the bytes consumed inside a region.
+ *  See @ref zcbor_hash_region_start. */
+typedef void (*zcbor_consume_cb_t)(void *ctx, const uint8_t *data, size_t len);
+
+/** Callback that receives the contents of a streamed bstr, one chunk at a time.
+ *  See @ref zcbor_bstr_stream_decode. */
+typedef bool (*zcbor_chunk_cb_t)(void *ctx, zcbor_state_t *state,
+		const struct zcbor_string_fragment *chunk);
+
+/** A chunk callback together with its context. */
+struct zcbor_chunk_handler {
+	zcbor_chunk_cb_t cb;
+	void *ctx; /**< Passed as the first argument to cb. */
+};
+
 struct zcbor_state_constant {
 	zcbor_state_t *backup_list;
 	size_t current_backup;
@@ -193,6 +295,15 @@ struct zcbor_state_constant {
 	                             The default/initial value follows ZCBOR_CANONICAL */
 	bool manually_process_elem; /**< Whether an (unordered map) element should be automatically
 	                                 marked as processed when found via @ref zcbor_search_map_key. */
+#ifdef ZCBOR_TRUSTED_INPUT
+	bool trust_input; /**< Skip decoding checks that only fail on data that was not produced by a
+	                       conforming encoder, i.e. the canonical checks. The checks that
+	                       a value's header or string payload fits inside payload_end are
+	                       always done, so a truncated payload is never read out of bounds.
+	                       Only use this for payloads that are known to be well-formed, e.g.
+	                       because they have been authenticated before decoding.
+	                       The default/initial value is false. */
+#endif
 #ifdef ZCBOR_MAP_SMART_SEARCH
 	uint8_t *map_search_elem_state_end; /**< The end of the @ref map_search_elem_state buffer. */
 #endif
@@ -200,6 +311,12 @@ struct zcbor_state_constant {
 	                                          I.e. the payload pointer this state was created with,
 	                                          or the payload pointer of the most recent call to
 	                                          zcbor_update_state. */
+#ifdef ZCBOR_HASH_REGION
+	zcbor_consume_cb_t consume_cb; /**< Receives the consumed bytes while a region is active.
+	                                    NULL when no region is active. */
+	void *consume_ctx; /**< Passed to consume_cb. */
+	const uint8_t *consume_start; /**< The first consumed byte not yet passed to consume_cb. */
+#endif
 };
 
 #ifdef ZCBOR_CANONICAL
@@ -211,6 +328,34 @@ struct zcbor_state_constant {
 #define ZCBOR_ENFORCE_CANONICAL(state) (state->constant_state \
 	? state->constant_state->enforce_canonical : ZCBOR_ENFORCE_CANONICAL_DEFAULT)
 
+#ifdef ZCBOR_WORK_BUDGET
+#ifndef ZCBOR_WORK_BUDGET_PER_BYTE
+#define ZCBOR_WORK_BUDGET_PER_BYTE 16 ///! The number of decoding steps allowed per payload byte.
+#endif
+#ifndef ZCBOR_WORK_BUDGET_BASE
+#define ZCBOR_WORK_BUDGET_BASE 64 ///! The number of decoding steps allowed per payload, in addition to ZCBOR_WORK_BUDGET_PER_BYTE.
+#endif
+#endif
+
+#ifdef ZCBOR_TRUSTED_INPUT
+#define ZCBOR_TRUST_INPUT(state) (state->constant_state \
+	? state->constant_state->trust_input : false)
+#else
+#define ZCBOR_TRUST_INPUT(state) false
+#endif
+
+#ifdef ZCBOR_INLINE
+#define ZCBOR_INLINE_API static inline ///! Linkage of the functions in zcbor_decode_inline.h and zcbor_encode_inline.h.
+#else
+#define ZCBOR_INLINE_API
+#endif
+
+/* The inline functions handle values that are encoded entirely in the header byte
+ * themselves, unless a configuration that must see every value is enabled. */
+#if defined(ZCBOR_INLINE) && !defined(ZCBOR_VERBOSE) && !defined(ZCBOR_WORK_BUDGET)
+#define ZCBOR_INLINE_FAST_PATH
+#endif
+
 #define ZCBOR_MANUALLY_PROCESS_ELEM_DEFAULT false
 
 #define ZCBOR_MANUALLY_PROCESS_ELEM(state) (state->constant_state \
@@ -224,6 +369,20 @@ struct zcbor_state_constant {
 typedef bool(zcbor_encoder_t)(zcbor_state_t *, const void *);
 typedef bool(zcbor_decoder_t)(zcbor_state_t *, void *);
 
+/** Function pointer type used with zcbor_multi_decode_soa and zcbor_multi_encode_soa_minmax.
+ *
+ * Like @ref zcbor_decoder_t, but the function also gets the index of the element,
+ * i.e. where to place it in the arrays of a struct-of-arrays result.
+ */
+typedef bool(zcbor_soa_encoder_t)(zcbor_state_t *, const void *, size_t);
+typedef bool(zcbor_soa_decoder_t)(zcbor_state_t *, void *, size_t);
+
+/** The number of bytes in a "present" bitmap for @p n elements of a struct-of-arrays. */
+#define ZCBOR_SOA_BITMAP_LEN(n) (((n) + 7) / 8)
+
+/** Whether bit @p index is set in a "present" bitmap of a struct-of-arrays. */
+#define ZCBOR_SOA_PRESENT(bitmap, index) (((bitmap)[(index) / 8] >> ((index) % 8)) & 1)
+
 /** Enumeration representing the major types available in CBOR.
  *
  * The major type is represented in the 3 first bits of the header byte.
@@ -346,7 +505,10 @@ do { \
 #define ZCBOR_ERR_TOO_LARGE_FOR_STRING 26 ///! Trying to start a nested string that is too large to fit in the container string.
 #define ZCBOR_ERR_NOT_IN_FRAGMENT 27 ///! The action requires being inside a fragmented string, but we are currently not inside one.
 #define ZCBOR_ERR_INSIDE_STRING 28 ///! Currently encoding/decoding a non-CBOR-encoded string, so cannot use most zcbor encoding/decoding functions
-#define ZCBOR_ERR_UNKNOWN 31
+#define ZCBOR_ERR_INVALID_UTF8 29 ///! When ZCBOR_VALIDATE_UTF8 is defined, and a decoded tstr is not valid UTF-8.
+#define ZCBOR_ERR_WORK_BUDGET 30 ///! When ZCBOR_WORK_BUDGET is defined, and decoding has used up its work budget.
+#define ZCBOR_ERR_NO_ARENA_MEM 31 ///! There is no arena, or the arena is too small for the decoded repetitions or coalesced indefinite length strings. See @ref zcbor_arena.
+#define ZCBOR_ERR_UNKNOWN 32
 
 /** The largest possible elem_count. */
 #define ZCBOR_MAX_ELEM_COUNT SIZE_MAX
@@ -453,6 +615,330 @@ int zcbor_entry_function_with_elem_states(const uint8_t *payload, size_t payload
  */
 #define zcbor_entry_function(...) zcbor_entry_function_with_elem_states(__VA_ARGS__, 0)
 
+#ifdef ZCBOR_TRUSTED_INPUT
+/** Like @ref zcbor_entry_function_with_elem_states, but for payloads from a trusted source.
+ *
+ *  This sets `trust_input` to true, so the per-value canonical checks are skipped,
+ *  see @ref zcbor_state_constant.trust_input. Headers and strings are still checked
+ *  against the end of the payload, so a truncated payload fails with ZCBOR_ERR_NO_PAYLOAD
+ *  instead of being read out of bounds.
+ *
+ *  @warning Only use this for payloads that are known to be well-formed, e.g. payloads that
+ *           were produced by a conforming encoder and whose integrity has been verified.
+ *           Non-canonical payloads are accepted.
+ */
+int zcbor_trusted_entry_function_with_elem_states(const uint8_t *payload, size_t payload_len,
+	void *result, size_t *payload_len_out, zcbor_state_t *states, zcbor_decoder_t func,
+	size_t n_states, size_t elem_count, size_t n_elem_states);
+
+/** Equivalent to @ref zcbor_trusted_entry_function_with_elem_states with @p n_elem_states = 0 */
+#define zcbor_trusted_entry_function(...) \
+	zcbor_trusted_entry_function_with_elem_states(__VA_ARGS__, 0)
+#endif
+
+#ifdef ZCBOR_BSTR_STREAM
+/** Like @ref zcbor_entry_function_with_elem_states, but with a callback for streamed bstrs.
+ *
+ *  @p chunk_cb and @p chunk_ctx are placed in the state (see
+ *  `decode_state.chunk_handler`) before calling @p func, so the contents of
+ *  all bstrs decoded with @ref zcbor_bstr_stream_decode are passed to @p chunk_cb.
+ *  @p chunk_cb can introduce new payload sections with @ref zcbor_update_state, so
+ *  in that case, @p payload_len_out is the number of bytes consumed from the last
+ *  payload section.
+ */
+int zcbor_stream_entry_function_with_elem_states(const uint8_t *payload, size_t payload_len,
+	void *result, size_t *payload_len_out, zcbor_chunk_cb_t chunk_cb, void *chunk_ctx,
+	zcbor_state_t *states, zcbor_decoder_t func,
+	size_t n_states, size_t elem_count, size_t n_elem_states);
+
+/** Equivalent to @ref zcbor_stream_entry_function_with_elem_states with @p n_elem_states = 0 */
+#define zcbor_stream_entry_function(...) \
+	zcbor_stream_entry_function_with_elem_states(__VA_ARGS__, 0)
+#endif
+
+/** Like @ref zcbor_entry_function_with_elem_states, but resume decoding at a position
+ *  recorded with zcbor_view_pos_record().
+ *
+ *  @p payload and @p payload_len are the encoded value that @p pos is relative to (or a
+ *  copy of it), e.g. the `raw` member of a generated view struct. The state is initialized
+ *  at `payload + pos->offset` with the elem_count from @p pos, so @p func can decode a
+ *  member in the middle of a list or map without decoding the members before it.
+ *
+ *  @return ZCBOR_ERR_NO_PAYLOAD if @p pos is outside the payload, otherwise like
+ *          @ref zcbor_entry_function_with_elem_states.
+ */
+int zcbor_view_entry_function_with_elem_states(const uint8_t *payload, size_t payload_len,
+	const struct zcbor_view_pos *pos, void *result, zcbor_state_t *states,
+	zcbor_decoder_t func, size_t n_states, size_t n_elem_states);
+
+/** Equivalent to @ref zcbor_view_entry_function_with_elem_states with @p n_elem_states = 0 */
+#define zcbor_view_entry_function(...) \
+	zcbor_view_entry_function_with_elem_states(__VA_ARGS__, 0)
+
+/** Decode consecutive items of a CBOR sequence (RFC 8742) into an array of results.
+ *
+ *  @note This function is tailored for use with the generated code.
+ *
+ *  Like @ref zcbor_entry_function_with_elem_states, but the state is only initialized once,
+ *  and @p func is called repeatedly, once for each item, until the payload is exhausted or
+ *  @p max_results items have been decoded. Item n is decoded into
+ *  `(uint8_t *)results + n * result_size`.
+ *
+ *  @param[out] num_results      The number of items that were successfully decoded.
+ *  @param[out] payload_len_out  The number of payload bytes consumed by the successfully
+ *                               decoded items. If this is less than @p payload_len when
+ *                               returning ZCBOR_SUCCESS, @p max_results was reached.
+ *
+ *  @return ZCBOR_SUCCESS if all items were decoded, or the error from the first item
+ *          that failed.
+ */
+int zcbor_entry_function_seq_with_elem_states(const uint8_t *payload, size_t payload_len,
+	void *results, size_t result_size, size_t max_results, size_t *num_results,
+	size_t *payload_len_out, zcbor_state_t *states, zcbor_decoder_t func,
+	size_t n_states, size_t n_elem_states);
+
+/** Equivalent to @ref zcbor_entry_function_seq_with_elem_states with @p n_elem_states = 0 */
+#define zcbor_entry_function_seq(...) zcbor_entry_function_seq_with_elem_states(__VA_ARGS__, 0)
+
+/** Encode an array of inputs as consecutive items of a CBOR sequence (RFC 8742).
+ *
+ *  @note This function is tailored for use with the generated code.
+ *
+ *  Like @ref zcbor_entry_function_seq_with_elem_states, but @p func is called once for each
+ *  of the @p num_inputs inputs, regardless of how much of the payload buffer is left.
+ *  Item n is encoded from `(const uint8_t *)results + n * result_size`.
+ *
+ *  @param[out] num_results      The number of items that were successfully encoded.
+ *  @param[out] payload_len_out  The number of payload bytes written by the successfully
+ *                               encoded items.
+ *
+ *  @return ZCBOR_SUCCESS if all inputs were encoded, or the error from the first item
+ *          that failed, e.g. ZCBOR_ERR_NO_PAYLOAD if the payload buffer is too small.
+ */
+int zcbor_entry_function_seq_encode_with_elem_states(uint8_t *payload, size_t payload_len,
+	const void *results, size_t result_size, size_t num_inputs, size_t *num_results,
+	size_t *payload_len_out, zcbor_state_t *states, zcbor_decoder_t func,
+	size_t n_states, size_t n_elem_states);
+
+/** Equivalent to @ref zcbor_entry_function_seq_encode_with_elem_states with
+ *  @p n_elem_states = 0 */
+#define zcbor_entry_function_seq_encode(...) \
+	zcbor_entry_function_seq_encode_with_elem_states(__VA_ARGS__, 0)
+
+#ifdef ZCBOR_ARENA
+/** Like @ref zcbor_entry_function_with_elem_states, but with an arena for repeated members.
+ *
+ *  @p arena is placed in the state (see @ref zcbor_multi_decode_arena) before calling @p func.
+ *  The arena is not reset, so the results of consecutive calls are placed after each other.
+ */
+int zcbor_arena_entry_function_with_elem_states(const uint8_t *payload, size_t payload_len,
+	void *result, size_t *payload_len_out, struct zcbor_arena *arena,
+	zcbor_state_t *states, zcbor_decoder_t func,
+	size_t n_states, size_t elem_count, size_t n_elem_states);
+
+/** Equivalent to @ref zcbor_arena_entry_function_with_elem_states with @p n_elem_states = 0 */
+#define zcbor_arena_entry_function(...) \
+	zcbor_arena_entry_function_with_elem_states(__VA_ARGS__, 0)
+
+/** Initialize @p arena to allocate from the @p size bytes at @p buf.
+ *
+ *  If @p buf is not aligned to ZCBOR_ARENA_ALIGN, the first bytes are not used.
+ */
+void zcbor_arena_init(struct zcbor_arena *arena, void *buf, size_t size);
+
+/** Initialize @p arena for a counting pass, which finds the exact arena size needed for a
+ *  payload.
+ *
+ *  Decode the payload once with this arena, then allocate a buffer of `arena->peak` bytes
+ *  (aligned to ZCBOR_ARENA_ALIGN), and decode it again with an arena from
+ *  @ref zcbor_arena_init. In the counting pass, finished arrays are not stored, and the
+ *  pointers to them are NULL, so @p buf only needs room for the elements of the arrays that
+ *  are being decoded at the same time, i.e. the arrays that are nested inside each other.
+ */
+void zcbor_arena_count_init(struct zcbor_arena *arena, void *buf, size_t size);
+#endif
+
+/** Get a pointer to the string described by @p str.
+ *
+ *  @p base must be the base pointer @p str was created with.
+ */
+static inline const uint8_t *zcbor_string_off_ptr(const uint8_t *base,
+		const struct zcbor_string_off *str)
+{
+	return base + str->offset;
+}
+
+/** Get @p str as a struct zcbor_string.
+ *
+ *  @p base must be the base pointer @p str was created with.
+ */
+static inline struct zcbor_string zcbor_string_off_get(const uint8_t *base,
+		const struct zcbor_string_off *str)
+{
+	struct zcbor_string result = {base + str->offset, str->len};
+
+	return result;
+}
+
+/** Describe @p str as an offset from @p base and a length.
+ *
+ *  @retval false  @p str starts before @p base, or its offset or length don't fit in
+ *                 32 bits. @p result is not changed.
+ */
+bool zcbor_string_off_set(struct zcbor_string_off *result, const uint8_t *base,
+		const struct zcbor_string *str);
+
+#ifdef ZCBOR_STRING_OFFSETS
+/** Like @ref zcbor_entry_function_with_elem_states, but with a base pointer for the
+ *  struct zcbor_string_off members.
+ *
+ *  @p string_base is placed in the state (see @ref zcbor_bstr_off_encode) before calling
+ *  @p func. Only needed when encoding, since the base pointer defaults to @p payload.
+ */
+int zcbor_string_base_entry_function_with_elem_states(const uint8_t *payload,
+	size_t payload_len, void *result, size_t *payload_len_out, const uint8_t *string_base,
+	zcbor_state_t *states, zcbor_decoder_t func,
+	size_t n_states, size_t elem_count, size_t n_elem_states);
+
+/** Equivalent to @ref zcbor_string_base_entry_function_with_elem_states with
+ *  @p n_elem_states = 0 */
+#define zcbor_string_base_entry_function(...) \
+	zcbor_string_base_entry_function_with_elem_states(__VA_ARGS__, 0)
+#endif
+
+#ifdef ZCBOR_TRACE_BUFFER
+/** Kinds of @ref zcbor_trace_event. */
+enum zcbor_trace_event_type {
+	ZCBOR_TRACE_NONE = 0, ///! Unused slot in the buffer.
+	ZCBOR_TRACE_ENTER = 1, ///! A generated function was called.
+	ZCBOR_TRACE_SUCCESS = 2, ///! A generated function returned true.
+	ZCBOR_TRACE_FAIL = 3, ///! A generated function returned false.
+	ZCBOR_TRACE_ERROR = 4, ///! An error code was written to the state.
+};
+
+/** A compact binary trace event. See @ref zcbor_trace_start.
+ *
+ *  The layout is fixed (12 bytes, no padding) so that a dump of the events can
+ *  be decoded on the host with `zcbor trace`.
+ */
+struct zcbor_trace_event {
+	uint32_t payload_offset; /**< Offset of the payload pointer in the current
+	                              payload section (see @ref zcbor_update_state). */
+	uint32_t elem_count; /**< The elem_count of the state. */
+	uint16_t func_id; /**< The id of the generated function, or 0 for events
+	                       from the library itself. */
+	uint8_t type; /**< The @ref zcbor_trace_event_type. */
+	int8_t error; /**< The error code in the state. */
+};
+
+/** A ring buffer of trace events. */
+struct zcbor_trace_buffer {
+	struct zcbor_trace_event *events;
+	size_t num_events;
+	size_t next; /**< The total number of events recorded. The oldest event is at
+	                  index next % num_events once the buffer has wrapped. */
+};
+
+/** Start recording trace events into @p buffer, which is backed by @p events.
+ *
+ *  When ZCBOR_TRACE_BUFFER is defined, all generated functions record an event
+ *  when they are called and when they return, and an event is recorded whenever
+ *  an error is set. When the buffer is full, the oldest events are overwritten.
+ *  There is one active buffer, shared by all states, and it is not thread safe.
+ *
+ *  To decode the trace, dump the @p events array and use `zcbor trace`, passing
+ *  it buffer->next and the same CDDL arguments that the code was generated with.
+ */
+void zcbor_trace_start(struct zcbor_trace_buffer *buffer,
+		struct zcbor_trace_event *events, size_t num_events);
+
+/** Stop recording trace events. The buffer is left intact. */
+void zcbor_trace_stop(void);
+
+/** Record a trace event in the active buffer, if any. */
+void zcbor_trace_record(const zcbor_state_t *state, uint8_t type, uint16_t func_id);
+#endif
+
+/** The time spent in, and the number of calls to, one CDDL rule.
+ *
+ *  Code generated with `--profile` keeps a table of these, with one entry per
+ *  CDDL rule. See @ref zcbor_profile_print.
+ */
+struct zcbor_profile_entry {
+	const char *rule; /**< The name of the CDDL rule. */
+	uint64_t calls; /**< The number of times the rule was decoded/encoded. */
+	uint64_t ticks; /**< Clock ticks spent in the rule, including in the
+	                     rules it refers to. When a rule is recursive via
+	                     other rules, the inner calls are counted again. */
+	uint64_t self_ticks; /**< Clock ticks spent in the rule, excluding the
+	                          rules it refers to. */
+};
+
+/** The clock used by code generated with `--profile`.
+ *
+ *  Defaults to the time stamp counter on x86. On other architectures, or to
+ *  use another clock (e.g. a cycle counter or a hardware timer), define this
+ *  to an expression that returns a monotonic uint64_t timestamp.
+ */
+#ifndef ZCBOR_PROFILE_CLOCK
+#if defined(__x86_64__) || defined(__i386__)
+#define ZCBOR_PROFILE_CLOCK() __builtin_ia32_rdtsc()
+#endif
+#endif
+
+/** The bookkeeping of a running profiled function. Lives on its stack. */
+struct zcbor_profile_frame {
+	struct zcbor_profile_entry *entry; /**< The rule the function belongs to. */
+	struct zcbor_profile_frame *outer; /**< The frame of the calling profiled
+	                                        function, if any. */
+	uint64_t start; /**< When the function was called. */
+	uint64_t nested; /**< Ticks spent in profiled functions called from this one. */
+};
+
+#ifdef ZCBOR_PROFILE_CLOCK
+/** Start timing a profiled function.
+ *
+ *  @param[inout] current  The innermost running frame, or NULL.
+ *  @param[out] frame      The new frame, which becomes the innermost one.
+ *  @param[in] entry       The rule the function belongs to.
+ */
+static inline void zcbor_profile_enter(struct zcbor_profile_frame **current,
+		struct zcbor_profile_frame *frame, struct zcbor_profile_entry *entry)
+{
+	frame->entry = entry;
+	frame->outer = *current;
+	frame->nested = 0;
+	*current = frame;
+	frame->start = ZCBOR_PROFILE_CLOCK();
+}
+
+/** Stop timing a profiled function and add the time to its entry.
+ *
+ *  A call only counts as a call to the rule (and adds to its total ticks) if
+ *  the caller belongs to a different rule, so the functions that make up a
+ *  rule are counted as one.
+ */
+static inline void zcbor_profile_exit(struct zcbor_profile_frame **current,
+		struct zcbor_profile_frame *frame)
+{
+	uint64_t elapsed = ZCBOR_PROFILE_CLOCK() - frame->start;
+	struct zcbor_profile_frame *outer = frame->outer;
+
+	frame->entry->self_ticks += elapsed - frame->nested;
+	if (!outer || (outer->entry != frame->entry)) {
+		frame->entry->calls++;
+		frame->entry->ticks += elapsed;
+	}
+	if (outer) {
+		outer->nested += elapsed;
+	}
+	*current = outer;
+}
+#endif
+
+/** Zero the counters of all entries in a profile table. */
+void zcbor_profile_reset(struct zcbor_profile_entry *entries, size_t num_entries);
+
 #ifdef ZCBOR_STOP_ON_ERROR
 /** Check stored error and fail if present, but only if stop_on_error is true.
  *
@@ -498,15 +984,94 @@ static inline void zcbor_error(zcbor_state_t *state, int err)
 		if (state->constant_state) {
 			state->constant_state->error = err;
 		}
+#ifdef ZCBOR_TRACE_BUFFER
+		zcbor_trace_record(state, ZCBOR_TRACE_ERROR, 0);
+#endif
 	}
 }
 
+#ifdef ZCBOR_WORK_BUDGET
+/** Spend @p steps of the work budget of @p state.
+ *
+ *  When ZCBOR_WORK_BUDGET is defined, each CBOR header that is decoded,
+ *  including those of elements that are skipped, e.g. while searching
+ *  unordered maps, costs one step, and so does each restored backup. The budget is initialized to
+ *  ZCBOR_WORK_BUDGET_BASE + ZCBOR_WORK_BUDGET_PER_BYTE * payload_len, and
+ *  each new payload section (@ref zcbor_update_state) adds to it. This bounds
+ *  the decoding time per payload byte, also for payloads crafted to make the
+ *  decoder backtrack or search a lot, e.g. through nested unions or wide
+ *  unordered maps.
+ *
+ *  @retval true   There was budget left.
+ *  @retval false  The budget is used up. The error is set to ZCBOR_ERR_WORK_BUDGET.
+ */
+static inline bool zcbor_work_spend(zcbor_state_t *state, size_t steps)
+{
+	if (state->decode_state.work_budget < steps) {
+		state->decode_state.work_budget = 0;
+		zcbor_error(state, ZCBOR_ERR_WORK_BUDGET);
+		return false;
+	}
+	state->decode_state.work_budget -= steps;
+	return true;
+}
+#endif
+
 /** Whether the current payload (section) is exhausted. */
 static inline bool zcbor_payload_at_end(const zcbor_state_t *state)
 {
 	return (state->payload == state->payload_end);
 }
 
+#ifdef ZCBOR_HASH_REGION
+/** Start feeding all consumed payload bytes to a callback, e.g. an incremental hash.
+ *
+ *  All bytes consumed from the current payload position until the call to
+ *  @ref zcbor_hash_region_end are passed to @p cb, in order, in multiple calls.
+ *  This includes the bytes consumed from each payload section when the payload
+ *  is divided into sections with @ref zcbor_update_state.
+ *  The bytes are passed as they are decoded: after each string, after each
+ *  list/map header and list/map end, when a section is left, and when the
+ *  region ends. Values between these points (e.g. integers) are passed together
+ *  with the next ones.
+ *
+ *  Only the net progress through the payload is passed, so bytes that are
+ *  consumed multiple times, e.g. because of backups being restored, are only
+ *  passed once. Bytes that have been passed are not taken back if the decoding
+ *  later backtracks, e.g. when a union member fails to decode, so the bytes
+ *  passed until the region ends are the bytes from the start of the region to
+ *  the furthest point reached in the payload.
+ *
+ *  To hash only the contents of a bstr, start the region after
+ *  @ref zcbor_bstr_start_decode and end it before @ref zcbor_bstr_end_decode.
+ *
+ *  @param[inout] state  The current state. Must have a constant state.
+ *  @param[in]    cb     The callback to pass the bytes to.
+ *  @param[in]    ctx    Passed as the first argument to @p cb.
+ *
+ *  @retval true   if the region was started.
+ *  @retval false  if a region is already active, or @p cb is NULL.
+ */
+bool zcbor_hash_region_start(zcbor_state_t *state, zcbor_consume_cb_t cb, void *ctx);
+
+/** End the region started with @ref zcbor_hash_region_start.
+ *
+ *  Passes the remaining consumed bytes to the callback.
+ *
+ *  @retval true   if the region was ended.
+ *  @retval false  if no region is active.
+ */
+bool zcbor_hash_region_end(zcbor_state_t *state);
+
+/** Pass the bytes consumed since the last call to the callback of the active region.
+ *
+ *  The decoding functions call this, so it is only needed to pass the bytes of
+ *  values that are decoded manually, without the zcbor decoding functions.
+ *  Does nothing if no region is active.
+ */
+void zcbor_hash_region_flush(zcbor_state_t *state);
+#endif /* ZCBOR_HASH_REGION */
+
 /** Introduce a new payload section.
  *
  *  Updates the current payload pointer (and payload_end and frag_offset(_cbor)).
@@ -522,6 +1087,9 @@ static inline bool zcbor_payload_at_end(const zcbor_state_t *state)
  *  processed with the flag @ref ZCBOR_FLAG_RESTORE, but without the flag
  *  @ref ZCBOR_FLAG_KEEP_PAYLOAD since this would cause an invalid state.
  *
+ *  With ZCBOR_HASH_REGION, if a region started with @ref zcbor_hash_region_start
+ *  is active, the bytes consumed from the old section are passed to its callback.
+ *
  *  @param[inout]  state              The current state, will be updated with
  *                                    the new payload pointer.
  *  @param[in]     payload            The new payload chunk.
@@ -588,6 +1156,36 @@ bool zcbor_splice_string_fragments(struct zcbor_string_fragment *fragments,
 bool zcbor_compare_strings(const struct zcbor_string *str1,
 		const struct zcbor_string *str2);
 
+/** Check whether a string is valid UTF-8 (RFC 3629).
+ *
+ *  Overlong encodings, surrogates (U+D800 to U+DFFF), and code points above
+ *  U+10FFFF are rejected.
+ *  When ZCBOR_VALIDATE_UTF8 is defined, this is done for all decoded tstrs,
+ *  including chunks and fragments.
+ *
+ *  @param[in] str  The string to check.
+ *  @param[in] len  The length of @p str in bytes.
+ *
+ *  @retval true   if @p str is valid UTF-8.
+ *  @retval false  otherwise.
+ */
+bool zcbor_validate_utf8(const uint8_t *str, size_t len);
+
+/** Check whether a part of a string is valid UTF-8, continuing from a previous part.
+ *
+ *  Like @ref zcbor_validate_utf8, but a character can be split between parts, so a
+ *  string can be validated one fragment at a time. The string as a whole is valid if
+ *  all parts are, and `utf8->num_cont` is 0 after the last part.
+ *
+ *  @param[inout] utf8  The validation state, carried from the previous part.
+ *  @param[in]    str   The part to check.
+ *  @param[in]    len   The length of @p str in bytes.
+ *
+ *  @retval true   if @p str is valid UTF-8 so far.
+ *  @retval false  otherwise. @p utf8 is then undefined.
+ */
+bool zcbor_validate_utf8_partial(struct zcbor_utf8_state *utf8, const uint8_t *str, size_t len);
+
 /** Calculate the length of a CBOR string, list, or map header.
  *
  *  This can be used to find the start of the CBOR object when you have a
@@ -637,11 +1235,45 @@ uint16_t zcbor_float32_to_16(float input);
 #ifdef ZCBOR_MAP_SMART_SEARCH
 #define ZCBOR_BITS_PER_BYTE 8
 
+/** The word type that map search flags are stored and scanned in. */
+typedef uint32_t zcbor_flag_word_t;
+
+#define ZCBOR_BITS_PER_FLAG_WORD (sizeof(zcbor_flag_word_t) * ZCBOR_BITS_PER_BYTE)
+
+/** Calculate the number of flag words needed to hold @p num_flags 1 bit flags
+ */
+static inline size_t zcbor_flags_to_words(size_t num_flags)
+{
+	return ZCBOR_ROUND_UP(num_flags, ZCBOR_BITS_PER_FLAG_WORD) / ZCBOR_BITS_PER_FLAG_WORD;
+}
+
+/** Read flag word number @p index from the flags buffer @p flags.
+ *
+ *  The buffer can be carved out of a @ref zcbor_state_t array, so it is accessed via memcpy()
+ *  instead of through a zcbor_flag_word_t pointer, to avoid breaking strict aliasing.
+ */
+static inline zcbor_flag_word_t zcbor_flag_word_get(const uint8_t *flags, size_t index)
+{
+	zcbor_flag_word_t word;
+
+	memcpy(&word, &flags[index * sizeof(zcbor_flag_word_t)], sizeof(word));
+	return word;
+}
+
+/** Write @p word to flag word number @p index in the flags buffer @p flags.
+ *  See @ref zcbor_flag_word_get. */
+static inline void zcbor_flag_word_set(uint8_t *flags, size_t index, zcbor_flag_word_t word)
+{
+	memcpy(&flags[index * sizeof(zcbor_flag_word_t)], &word, sizeof(word));
+}
+
 /** Calculate the number of bytes needed to hold @p num_flags 1 bit flags
+ *
+ *  This is always a whole number of flag words.
  */
 static inline size_t zcbor_flags_to_bytes(size_t num_flags)
 {
-	return ZCBOR_ROUND_UP(num_flags, ZCBOR_BITS_PER_BYTE) / ZCBOR_BITS_PER_BYTE;
+	return zcbor_flags_to_words(num_flags) * sizeof(zcbor_flag_word_t);
 }
 
 /** Calculate the number of zcbor_state_t instances needed to hold @p num_flags 1 bit flags
@@ -656,6 +1288,46 @@ static inline size_t zcbor_flags_to_bytes(size_t num_flags)
 #define ZCBOR_FLAG_STATES(n_flags) (n_flags * 0)
 #endif
 
+#ifdef ZCBOR_STATS
+/** Counters for the events that drive the cost of encoding and decoding.
+ *
+ *  Only available when ZCBOR_STATS is defined. The counters are global, i.e.
+ *  shared by all states, and are not updated atomically, so they are only
+ *  accurate when zcbor is used from one thread at a time.
+ */
+struct zcbor_stats {
+	size_t backups_created; /**< Backups made by @ref zcbor_new_backup and friends. */
+	size_t backups_restored; /**< Backups restored by @ref zcbor_process_backup
+	                              and friends (ZCBOR_FLAG_RESTORE). */
+	size_t backup_bytes; /**< Bytes copied into backups, including map search flags. */
+	size_t skip_calls; /**< Calls to @ref zcbor_any_skip, including recursive calls
+	                        for list and map elements. */
+	size_t skip_bytes; /**< Bytes skipped by @ref zcbor_any_skip. */
+	size_t map_search_iterations; /**< Map elements visited by
+	                                   @ref zcbor_unordered_map_search. */
+	size_t map_flag_ops; /**< Reads and writes of single map search flags, and flag
+	                          words scanned (ZCBOR_MAP_SMART_SEARCH only). */
+	size_t canonical_memmoves; /**< Times a list or map body was moved to fit its
+	                                header when encoding (ZCBOR_CANONICAL only). */
+	size_t canonical_bytes_moved; /**< Bytes moved by the above. */
+	size_t union_alternatives; /**< Union alternatives tried, i.e. calls to
+	                                @ref zcbor_union_start_code and
+	                                @ref zcbor_union_elem_code. */
+};
+
+extern struct zcbor_stats zcbor_stats_global;
+
+/** Copy the current value of all the counters into @p stats. */
+void zcbor_stats_read(struct zcbor_stats *stats);
+
+/** Set all the counters to 0. */
+void zcbor_stats_reset(void);
+
+#define ZCBOR_STATS_ADD(counter, n) (zcbor_stats_global.counter += (size_t)(n))
+#else
+#define ZCBOR_STATS_ADD(counter, n) ((void)0)
+#endif
+
 size_t strnlen(const char *, size_t);
 
 bool zcbor_cast_error(zcbor_state_t *state, void *unused);
@@ -700,6 +1372,7 @@ bool zcbor_cast_error(zcbor_state_t *state, void *unused);
 	bool(*)(zcbor_state_t *, float *):                     ((zcbor_decoder_t *)func), \
 	bool(*)(zcbor_state_t *, double *):                    ((zcbor_decoder_t *)func), \
 	bool(*)(zcbor_state_t *, struct zcbor_string *):       ((zcbor_decoder_t *)func), \
+	bool(*)(zcbor_state_t *, struct zcbor_string_off *):   ((zcbor_decoder_t *)func), \
 	bool(*)(zcbor_state_t *, const void *):                func, \
 	bool(*)(zcbor_state_t *, const int8_t *):              ((zcbor_encoder_t *)func), \
 	bool(*)(zcbor_state_t *, const int16_t *):             ((zcbor_encoder_t *)func), \
@@ -713,6 +1386,7 @@ bool zcbor_cast_error(zcbor_state_t *state, void *unused);
 	bool(*)(zcbor_state_t *, const float *):               ((zcbor_encoder_t *)func), \
 	bool(*)(zcbor_state_t *, const double *):              ((zcbor_encoder_t *)func), \
 	bool(*)(zcbor_state_t *, const struct zcbor_string *): ((zcbor_encoder_t *)func), \
+	bool(*)(zcbor_state_t *, const struct zcbor_string_off *): ((zcbor_encoder_t *)func), \
 	default: (size_t)zcbor_cast_error /* A compile error here means your function pointer is bad. */ \
 )
 
@@ -63,15 +63,15 @@ do { \
  *                fit in the result variable.
  *                Use zcbor_peek_error() to see the error code.
  */
-bool zcbor_int8_decode(zcbor_state_t *state, int8_t *result);
-bool zcbor_int16_decode(zcbor_state_t *state, int16_t *result);
-bool zcbor_int32_decode(zcbor_state_t *state, int32_t *result); /* pint/nint */
-bool zcbor_int64_decode(zcbor_state_t *state, int64_t *result); /* pint/nint */
-bool zcbor_uint8_decode(zcbor_state_t *state, uint8_t *result);
-bool zcbor_uint16_decode(zcbor_state_t *state, uint16_t *result);
-bool zcbor_uint32_decode(zcbor_state_t *state, uint32_t *result); /* pint */
-bool zcbor_uint64_decode(zcbor_state_t *state, uint64_t *result); /* pint */
-bool zcbor_size_decode(zcbor_state_t *state, size_t *result); /* pint */
+ZCBOR_INLINE_API bool zcbor_int8_decode(zcbor_state_t *state, int8_t *result);
+ZCBOR_INLINE_API bool zcbor_int16_decode(zcbor_state_t *state, int16_t *result);
+ZCBOR_INLINE_API bool zcbor_int32_decode(zcbor_state_t *state, int32_t *result); /* pint/nint */
+ZCBOR_INLINE_API bool zcbor_int64_decode(zcbor_state_t *state, int64_t *result); /* pint/nint */
+ZCBOR_INLINE_API bool zcbor_uint8_decode(zcbor_state_t *state, uint8_t *result);
+ZCBOR_INLINE_API bool zcbor_uint16_decode(zcbor_state_t *state, uint16_t *result);
+ZCBOR_INLINE_API bool zcbor_uint32_decode(zcbor_state_t *state, uint32_t *result); /* pint */
+ZCBOR_INLINE_API bool zcbor_uint64_decode(zcbor_state_t *state, uint64_t *result); /* pint */
+ZCBOR_INLINE_API bool zcbor_size_decode(zcbor_state_t *state, size_t *result); /* pint */
 bool zcbor_int_decode(zcbor_state_t *state, void *result, size_t result_size); /* pint/nint */
 bool zcbor_uint_decode(zcbor_state_t *state, void *result, size_t result_size); /* pint */
 bool zcbor_bstr_decode(zcbor_state_t *state, struct zcbor_string *result); /* bstr */
@@ -86,6 +86,27 @@ bool zcbor_float32_64_decode(zcbor_state_t *state, double *result); /* IEEE754 f
 bool zcbor_float64_decode(zcbor_state_t *state, double *result); /* IEEE754 float64 */
 bool zcbor_float_decode(zcbor_state_t *state, double *result); /* IEEE754 float16, float32, or float64 */
 
+/* zcbor_bstr_decode() and zcbor_tstr_decode() (and the bstr/tstr _expect() functions) also
+ * accept indefinite length strings, except when enforcing canonical CBOR. If such a string has
+ * at most one non-empty chunk, the result points to that chunk in the payload. Otherwise, the
+ * chunks are coalesced into the state's arena (see @ref zcbor_multi_decode_arena), and decoding
+ * fails with ZCBOR_ERR_NO_ARENA_MEM if there is no arena (or ZCBOR_ARENA is not defined).
+ * To access the chunks without copying, use @ref zcbor_bstr_chunks_start_decode instead. */
+
+#ifdef ZCBOR_STRING_OFFSETS
+/** Decode a bstr or tstr like @ref zcbor_bstr_decode or @ref zcbor_tstr_decode, but into a
+ *  struct zcbor_string_off relative to `state->string_base`.
+ *
+ * By default, `state->string_base` is the start of the payload the state was created with,
+ * so the string can be accessed with e.g. zcbor_string_off_ptr(payload, &result).
+ *
+ * @retval false  In addition to the reasons for @ref zcbor_bstr_decode, if the string is
+ *                not within 4 GiB of `state->string_base` (ZCBOR_ERR_INT_SIZE).
+ */
+bool zcbor_bstr_off_decode(zcbor_state_t *state, struct zcbor_string_off *result); /* bstr */
+bool zcbor_tstr_off_decode(zcbor_state_t *state, struct zcbor_string_off *result); /* tstr */
+#endif
+
 /** The following applies to all _expect() and _pexpect() functions listed directly below.
  *
  * @param[inout] state     The current state of the decoding.
@@ -96,15 +117,15 @@ bool zcbor_float_decode(zcbor_state_t *state, double *result); /* IEEE754 float1
  *                expected value.
  *                Use zcbor_peek_error() to see the error code.
  */
-bool zcbor_int8_expect(zcbor_state_t *state, int8_t expected); /* pint/nint */
-bool zcbor_int16_expect(zcbor_state_t *state, int16_t expected); /* pint/nint */
-bool zcbor_int32_expect(zcbor_state_t *state, int32_t expected); /* pint/nint */
+ZCBOR_INLINE_API bool zcbor_int8_expect(zcbor_state_t *state, int8_t expected); /* pint/nint */
+ZCBOR_INLINE_API bool zcbor_int16_expect(zcbor_state_t *state, int16_t expected); /* pint/nint */
+ZCBOR_INLINE_API bool zcbor_int32_expect(zcbor_state_t *state, int32_t expected); /* pint/nint */
 bool zcbor_int64_expect(zcbor_state_t *state, int64_t expected); /* pint/nint */
-bool zcbor_uint8_expect(zcbor_state_t *state, uint8_t expected); /* pint */
-bool zcbor_uint16_expect(zcbor_state_t *state, uint16_t expected); /* pint */
-bool zcbor_uint32_expect(zcbor_state_t *state, uint32_t expected); /* pint */
+ZCBOR_INLINE_API bool zcbor_uint8_expect(zcbor_state_t *state, uint8_t expected); /* pint */
+ZCBOR_INLINE_API bool zcbor_uint16_expect(zcbor_state_t *state, uint16_t expected); /* pint */
+ZCBOR_INLINE_API bool zcbor_uint32_expect(zcbor_state_t *state, uint32_t expected); /* pint */
 bool zcbor_uint64_expect(zcbor_state_t *state, uint64_t expected); /* pint */
-bool zcbor_size_expect(zcbor_state_t *state, size_t expected); /* pint */
+ZCBOR_INLINE_API bool zcbor_size_expect(zcbor_state_t *state, size_t expected); /* pint */
 bool zcbor_bstr_expect(zcbor_state_t *state, struct zcbor_string *expected); /* bstr */
 bool zcbor_tstr_expect(zcbor_state_t *state, struct zcbor_string *expected); /* tstr */
 bool zcbor_tag_expect(zcbor_state_t *state, uint32_t expected); /* CBOR tag */
@@ -121,24 +142,24 @@ bool zcbor_float_expect(zcbor_state_t *state, double expected); /* IEEE754 float
 
 /** Like the _expect() functions but the value is passed through a pointer.
  * (for use as a zcbor_decoder_t function) */
-bool zcbor_int8_pexpect(zcbor_state_t *state, int8_t *expected); /* pint/nint */
-bool zcbor_int16_pexpect(zcbor_state_t *state, int16_t *expected); /* pint/nint */
-bool zcbor_int32_pexpect(zcbor_state_t *state, int32_t *expected); /* pint/nint */
-bool zcbor_int64_pexpect(zcbor_state_t *state, int64_t *expected); /* pint/nint */
-bool zcbor_uint8_pexpect(zcbor_state_t *state, uint8_t *expected); /* pint */
-bool zcbor_uint16_pexpect(zcbor_state_t *state, uint16_t *expected); /* pint */
-bool zcbor_uint32_pexpect(zcbor_state_t *state, uint32_t *expected); /* pint */
-bool zcbor_uint64_pexpect(zcbor_state_t *state, uint64_t *expected); /* pint */
-bool zcbor_size_pexpect(zcbor_state_t *state, size_t *expected); /* pint */
-bool zcbor_tag_pexpect(zcbor_state_t *state, uint32_t *expected); /* CBOR tag */
+ZCBOR_INLINE_API bool zcbor_int8_pexpect(zcbor_state_t *state, int8_t *expected); /* pint/nint */
+ZCBOR_INLINE_API bool zcbor_int16_pexpect(zcbor_state_t *state, int16_t *expected); /* pint/nint */
+ZCBOR_INLINE_API bool zcbor_int32_pexpect(zcbor_state_t *state, int32_t *expected); /* pint/nint */
+ZCBOR_INLINE_API bool zcbor_int64_pexpect(zcbor_state_t *state, int64_t *expected); /* pint/nint */
+ZCBOR_INLINE_API bool zcbor_uint8_pexpect(zcbor_state_t *state, uint8_t *expected); /* pint */
+ZCBOR_INLINE_API bool zcbor_uint16_pexpect(zcbor_state_t *state, uint16_t *expected); /* pint */
+ZCBOR_INLINE_API bool zcbor_uint32_pexpect(zcbor_state_t *state, uint32_t *expected); /* pint */
+ZCBOR_INLINE_API bool zcbor_uint64_pexpect(zcbor_state_t *state, uint64_t *expected); /* pint */
+ZCBOR_INLINE_API bool zcbor_size_pexpect(zcbor_state_t *state, size_t *expected); /* pint */
+ZCBOR_INLINE_API bool zcbor_tag_pexpect(zcbor_state_t *state, uint32_t *expected); /* CBOR tag */
 bool zcbor_bool_pexpect(zcbor_state_t *state, bool *expected); /* boolean CBOR simple value */
-bool zcbor_float16_pexpect(zcbor_state_t *state, float *expected); /* IEEE754 float16 */
-bool zcbor_float16_bytes_pexpect(zcbor_state_t *state, uint16_t *expected); /* IEEE754 float16 raw bytes */
-bool zcbor_float16_32_pexpect(zcbor_state_t *state, float *expected); /* IEEE754 float16 or float32 */
-bool zcbor_float32_pexpect(zcbor_state_t *state, float *expected); /* IEEE754 float32 */
-bool zcbor_float32_64_pexpect(zcbor_state_t *state, double *expected); /* IEEE754 float32 or float64 */
-bool zcbor_float64_pexpect(zcbor_state_t *state, double *expected); /* IEEE754 float64 */
-bool zcbor_float_pexpect(zcbor_state_t *state, double *expected); /* IEEE754 float16, float32, or float64 */
+ZCBOR_INLINE_API bool zcbor_float16_pexpect(zcbor_state_t *state, float *expected); /* IEEE754 float16 */
+ZCBOR_INLINE_API bool zcbor_float16_bytes_pexpect(zcbor_state_t *state, uint16_t *expected); /* IEEE754 float16 raw bytes */
+ZCBOR_INLINE_API bool zcbor_float16_32_pexpect(zcbor_state_t *state, float *expected); /* IEEE754 float16 or float32 */
+ZCBOR_INLINE_API bool zcbor_float32_pexpect(zcbor_state_t *state, float *expected); /* IEEE754 float32 */
+ZCBOR_INLINE_API bool zcbor_float32_64_pexpect(zcbor_state_t *state, double *expected); /* IEEE754 float32 or float64 */
+ZCBOR_INLINE_API bool zcbor_float64_pexpect(zcbor_state_t *state, double *expected); /* IEEE754 float64 */
+ZCBOR_INLINE_API bool zcbor_float_pexpect(zcbor_state_t *state, double *expected); /* IEEE754 float16, float32, or float64 */
 
 /** Consume and expect a pint/nint with a certain value, within a union.
  *
@@ -295,6 +316,58 @@ bool zcbor_array_at_end(zcbor_state_t *state);
  */
 bool zcbor_any_skip(zcbor_state_t *state, void *unused);
 
+/** Skip a single element like @ref zcbor_any_skip, and return its encoded bytes.
+ *
+ * @p result points to the whole element inside the payload, including any tags
+ * and nested elements, so it can be kept, or passed on with @ref zcbor_raw_encode,
+ * without decoding it. The element is only checked for being well-formed.
+ *
+ * @param[inout] state   The current state of the decoding.
+ * @param[out]   result  The encoded element.
+ */
+bool zcbor_raw_decode(zcbor_state_t *state, struct zcbor_string *result);
+
+/** Find the boundaries of consecutive elements, by skipping over them.
+ *
+ * Skips elements with @ref zcbor_any_skip until the end of the current list,
+ * map, or CBOR sequence, or until @p max_items elements have been skipped.
+ * The offset of the start of each element, relative to the payload position
+ * when the function was called, is stored in @p offsets, followed by the
+ * offset of the end of the last skipped element.
+ *
+ * This can be used to split a long CBOR sequence, or the elements of a large
+ * list, into chunks that can be decoded independently, e.g. by different
+ * threads, each with its own state array. For example, elements a through b-1
+ * can be decoded as a CBOR sequence of length offsets[b] - offsets[a] starting
+ * at offsets[a].
+ *
+ * @param[inout] state      The current state of the decoding.
+ * @param[out]   offsets    Array of at least @p max_items + 1 offsets.
+ * @param[in]    max_items  The maximum number of elements to skip.
+ * @param[out]   num_items  The number of elements skipped. This is also set
+ *                          when the function fails, in which case @p offsets
+ *                          is valid up to and including index @p num_items.
+ */
+bool zcbor_index_items(zcbor_state_t *state, size_t *offsets, size_t max_items,
+		size_t *num_items);
+
+/** Record the current position of the decoding, so it can be resumed there later.
+ *
+ * The offset of the payload position relative to @p start, and the current
+ * elem_count, are stored in @p pos. Decoding can later be resumed at the position
+ * with @ref zcbor_view_entry_function_with_elem_states, e.g. to decode a single
+ * member of a list or map on demand. This is used by the view structs generated
+ * with --view-entry-types.
+ *
+ * @param[in]  state  The current state of the decoding.
+ * @param[in]  start  The start of the region that the offset is relative to.
+ * @param[out] pos    The recorded position.
+ *
+ * @return Always true, so it can be chained with decoding functions.
+ */
+bool zcbor_view_pos_record(zcbor_state_t *state, const uint8_t *start,
+		struct zcbor_view_pos *pos);
+
 /** Decode 0 or more elements with the same type and constraints.
  *
  * The decoded values will appear consecutively in the @p result array.
@@ -363,6 +436,29 @@ bool zcbor_multi_decode_w_backup(size_t min_decode, size_t max_decode, size_t *n
 		zcbor_decoder_t decoder, zcbor_state_t *state, void *result,
 		size_t result_len);
 
+#ifdef ZCBOR_ARENA
+/** Like @ref zcbor_multi_decode, but place the decoded values in the state's arena.
+ *
+ * The arena is taken from `state->decode_state.arena`, see @ref zcbor_arena and
+ * @ref zcbor_arena_entry_function_with_elem_states. The decoded values are placed
+ * consecutively in the arena, and a pointer to the first one is written to @p result,
+ * so there is no need to reserve room for @p max_decode elements up front.
+ * If no values were decoded, or the arena is only counting, the pointer is NULL.
+ *
+ * @param[out] result  Pointer to the pointer that receives the location of the values,
+ *                     e.g. `&my_struct.elems` when `my_struct.elems` is a `uint32_t *`.
+ *
+ * @retval false  Also if the arena runs out of room, in which case the error is
+ *                ZCBOR_ERR_NO_ARENA_MEM.
+ */
+bool zcbor_multi_decode_arena(size_t min_decode, size_t max_decode, size_t *num_decode,
+		zcbor_decoder_t decoder, zcbor_state_t *state, void *result,
+		size_t result_len);
+bool zcbor_multi_decode_arena_w_backup(size_t min_decode, size_t max_decode, size_t *num_decode,
+		zcbor_decoder_t decoder, zcbor_state_t *state, void *result,
+		size_t result_len);
+#endif
+
 /** Attempt to decode a value that might not be present in the data.
  *
  * Works like @ref zcbor_multi_decode, with @p present as num_decode.
@@ -388,6 +484,29 @@ bool zcbor_present_decode_w_backup(bool *present,
 		zcbor_state_t *state,
 		void *result);
 
+/** Like @ref zcbor_multi_decode, but for results in a struct-of-arrays layout.
+ *
+ * Instead of moving the result pointer for each element, @p result is passed
+ * unchanged to @p decoder, together with the index of the element. The decoder
+ * places each member of the element in its own array in @p result, at that index.
+ * This is what the code generated with --soa-types uses.
+ *
+ * @param[in]  decoder  The decoder function to call under the hood, with the index
+ *                      of each element.
+ * @param[out] result   The struct-of-arrays to place the decoded values in. Each
+ *                      array must have room for at least @p max_decode elements.
+ */
+bool zcbor_multi_decode_soa(size_t min_decode, size_t max_decode, size_t *num_decode,
+		zcbor_soa_decoder_t decoder, zcbor_state_t *state, void *result);
+
+/** Set or clear bit @p index in a "present" bitmap of a struct-of-arrays.
+ *
+ * See also @ref ZCBOR_SOA_PRESENT.
+ *
+ * @return Always returns true.
+ */
+bool zcbor_soa_present_set(uint8_t *bitmap, size_t index, bool present);
+
 /** Supplementary string (bstr/tstr) decoding functions: */
 
 /** Consume and expect a bstr/tstr with the value of the provided char/uint8_t array.
@@ -401,8 +520,8 @@ bool zcbor_present_decode_w_backup(bool *present,
  * @param[in]    maxlen  (if present) The maximum length of the string pointed to by @p str.
  *                       This value is passed to strnlen.
  */
-bool zcbor_bstr_expect_ptr(zcbor_state_t *state, char const *ptr, size_t len);
-bool zcbor_tstr_expect_ptr(zcbor_state_t *state, char const *ptr, size_t len);
+ZCBOR_INLINE_API bool zcbor_bstr_expect_ptr(zcbor_state_t *state, char const *ptr, size_t len);
+ZCBOR_INLINE_API bool zcbor_tstr_expect_ptr(zcbor_state_t *state, char const *ptr, size_t len);
 bool zcbor_bstr_expect_term(zcbor_state_t *state, char const *str, size_t maxlen);
 bool zcbor_tstr_expect_term(zcbor_state_t *state, char const *str, size_t maxlen);
 #define zcbor_bstr_expect_lit(state, str) zcbor_bstr_expect_ptr(state, str, sizeof(str) - 1)
@@ -410,6 +529,116 @@ bool zcbor_tstr_expect_term(zcbor_state_t *state, char const *str, size_t maxlen
 #define zcbor_bstr_expect_arr(state, str) zcbor_bstr_expect_ptr(state, str, sizeof(str))
 #define zcbor_tstr_expect_arr(state, str) zcbor_tstr_expect_ptr(state, str, sizeof(str))
 
+/** Consume and expect a bstr/tstr, given the expected value in its encoded form (header + contents).
+ *
+ * This is faster than the other _expect() functions since the first byte of the
+ * payload is compared to the first byte of @p encoded before anything else, and
+ * a matching string is then matched with a single memcmp().
+ * This is used by the generated code for string literals, e.g. map keys.
+ *
+ * If the payload's header is longer than the one in @p encoded, it might be a
+ * non-canonical encoding of the same length, so in that case the function falls
+ * back to comparing the decoded string.
+ *
+ * @param[inout] state    The current state of the decoding.
+ * @param[in]    encoded  The expected string, encoded with the shortest possible header.
+ */
+bool zcbor_bstr_expect_encoded(zcbor_state_t *state, struct zcbor_string *encoded);
+bool zcbor_tstr_expect_encoded(zcbor_state_t *state, struct zcbor_string *encoded);
+
+#ifdef ZCBOR_BSTR_STREAM
+/** Decode a bstr and pass its contents to a callback instead of returning a pointer to them.
+ *
+ * The contents are passed to `decode_state.chunk_handler` in one or more chunks,
+ * one for each payload section the string spans. The chunk that ends a payload section
+ * before the end of the string is reached is the callback's opportunity to introduce
+ * the next section with @ref zcbor_update_state, so the full string never needs to be
+ * in memory at once. If the callback returns false, the decoding fails, and it can set
+ * an error code with @ref zcbor_error first.
+ *
+ * If no callback is set, this is equivalent to @ref zcbor_bstr_decode.
+ *
+ * This is used by the generated code for types listed in --stream-bstr-types.
+ * Only bstrs can be streamed, so there is no UTF-8 validation, see @ref ZCBOR_VALIDATE_UTF8.
+ *
+ * @param[inout] state   The current state of the decoding.
+ * @param[out]   result  The length of the string. If a callback is set, the value is NULL.
+ *
+ * @retval true   The whole string was decoded and passed to the callback.
+ * @retval false  The header could not be decoded, the callback returned false, or
+ *                the payload ended before the string did.
+ *                In this case, the state is not restored, since the payload
+ *                section might have changed.
+ */
+bool zcbor_bstr_stream_decode(zcbor_state_t *state, struct zcbor_string *result);
+#endif
+
+/** Iterator for decoding a string in chunks.
+ *
+ * See @ref zcbor_bstr_chunks_start_decode. Don't modify the members directly.
+ */
+struct zcbor_str_chunk_iter {
+	struct zcbor_string definite; /**< The contents, if the string has a definite length. */
+	zcbor_major_type_t major_type; /**< The major type of the string and its chunks. */
+	bool indefinite; /**< Whether the string has an indefinite length. */
+	bool done; /**< Whether the single chunk of a definite length string has been decoded. */
+};
+
+/** Start decoding a bstr/tstr which may have an indefinite length, i.e. be split into chunks.
+ *
+ * The chunks of an indefinite length string are separate definite length strings
+ * of the same type, terminated by a break marker (0xFF). A definite length string
+ * is treated as if it has a single chunk, so the same code can handle both.
+ *
+ * Retrieve the chunks with @ref zcbor_str_chunk_decode until @ref zcbor_str_chunks_at_end
+ * returns true, then call @ref zcbor_str_chunks_end_decode. The chunks are returned as
+ * pointers into the payload, so nothing is copied.
+ *
+ * Indefinite length strings are not allowed when enforcing canonical CBOR.
+ *
+ * @param[inout] state  The current state of the decoding.
+ * @param[out]   iter   The iterator to pass to the other zcbor_str_chunk*() functions.
+ */
+bool zcbor_bstr_chunks_start_decode(zcbor_state_t *state, struct zcbor_str_chunk_iter *iter);
+bool zcbor_tstr_chunks_start_decode(zcbor_state_t *state, struct zcbor_str_chunk_iter *iter);
+
+/** Whether all chunks of the string have been decoded. */
+bool zcbor_str_chunks_at_end(const zcbor_state_t *state, const struct zcbor_str_chunk_iter *iter);
+
+/** Decode the next chunk of a string started with zcbor_*str_chunks_start_decode().
+ *
+ * With @ref ZCBOR_VALIDATE_UTF8, each chunk of a tstr is validated before it is returned.
+ * Each chunk is validated on its own, since RFC 8949 requires every chunk of a tstr to be
+ * valid UTF-8, i.e. chunks cannot split characters.
+ *
+ * @param[inout] state  The current state of the decoding.
+ * @param[inout] iter   The iterator.
+ * @param[out]   chunk  The contents of the chunk.
+ */
+bool zcbor_str_chunk_decode(zcbor_state_t *state, struct zcbor_str_chunk_iter *iter,
+		struct zcbor_string *chunk);
+
+/** Finish decoding a string started with zcbor_*str_chunks_start_decode().
+ *
+ * Fails with ZCBOR_ERR_NOT_AT_END if not all chunks have been decoded.
+ */
+bool zcbor_str_chunks_end_decode(zcbor_state_t *state, struct zcbor_str_chunk_iter *iter);
+
+/** Decode a bstr/tstr which may have an indefinite length, copying its contents into @p buf.
+ *
+ * This combines the zcbor_str_chunk*() functions. If the string does not fit in @p buf,
+ * the decoding fails with ZCBOR_ERR_TOO_LARGE_FOR_STRING, and the state is not changed.
+ *
+ * @param[inout] state    The current state of the decoding.
+ * @param[out]   buf      The buffer to copy the contents into.
+ * @param[in]    buf_len  The size of @p buf.
+ * @param[out]   result   The resulting string, which points into @p buf.
+ */
+bool zcbor_bstr_coalesce_decode(zcbor_state_t *state, uint8_t *buf, size_t buf_len,
+		struct zcbor_string *result);
+bool zcbor_tstr_coalesce_decode(zcbor_state_t *state, uint8_t *buf, size_t buf_len,
+		struct zcbor_string *result);
+
 /** Decode and consume a bstr header.
  *
  * The rest of the string can be decoded as CBOR.
@@ -487,12 +716,20 @@ bool zcbor_cbor_bstr_fragments_start_decode(zcbor_state_t *state);
  * Any such call to this function will have no memory of previous calls to this function,
  * so the returned fragment always starts at the same point until the payload is updated.
  *
+ * With @ref ZCBOR_VALIDATE_UTF8, the fragments of a tstr are validated as they are
+ * decoded, and characters may be split between fragments. If a fragment is not valid,
+ * this fails with ZCBOR_ERR_INVALID_UTF8 without consuming the fragment.
+ *
  * @param[inout] state     The current state of the decoding.
  * @param[out]   fragment  The resulting string fragment.
  */
 bool zcbor_str_fragment_decode(zcbor_state_t *state, struct zcbor_string_fragment *fragment);
 
-/** Finish decoding a fragmented string. */
+/** Finish decoding a fragmented string.
+ *
+ * With @ref ZCBOR_VALIDATE_UTF8, this fails with ZCBOR_ERR_INVALID_UTF8 if a tstr ends
+ * in the middle of a character.
+ */
 bool zcbor_str_fragments_end_decode(zcbor_state_t *state);
 
 #endif /* ZCBOR_FRAGMENTS */
@@ -501,4 +738,8 @@ bool zcbor_str_fragments_end_decode(zcbor_state_t *state);
 }
 #endif
 
+#ifdef ZCBOR_INLINE
+#include "zcbor_decode_inline.h"
+#endif
+
 #endif /* ZCBOR_DECODE_H__ */
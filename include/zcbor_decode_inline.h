@@ -0,0 +1,433 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZCBOR_DECODE_INLINE_H__
+#define ZCBOR_DECODE_INLINE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "zcbor_common.h"
+#include "zcbor_print.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** The small decoding functions that forward to other public functions.
+ *
+ * With ZCBOR_INLINE, this file is included by zcbor_decode.h, and the functions
+ * are static inline, so they can be inlined into the generated code and
+ * specialized for its constant arguments. The integer functions then also
+ * handle values that are encoded entirely in the header byte themselves, and
+ * only call the out-of-line functions for other values and for errors.
+ * Without ZCBOR_INLINE, this file is included by zcbor_decode.c and the
+ * functions are compiled there like the rest.
+ *
+ * Don't include this file directly.
+ */
+
+
+#ifdef ZCBOR_INLINE_FAST_PATH
+/** Whether the next value can be consumed without the out-of-line checks, i.e.
+ *  whether the out-of-line function would get past its initial checks and its
+ *  element count check.
+ */
+static inline bool zcbor_fast_decode_ok(const zcbor_state_t *state)
+{
+	return (state != NULL) && (state->payload < state->payload_end)
+		&& (state->elem_count != 0)
+#ifdef ZCBOR_STOP_ON_ERROR
+		&& zcbor_check_error(state)
+#endif
+#ifdef ZCBOR_FRAGMENTS
+		&& !state->inside_frag_str
+#endif
+		;
+}
+
+
+/** Consume the header byte of a value that is encoded entirely in the header,
+ *  the same way as the out-of-line functions do.
+ */
+static inline void zcbor_fast_decode_consume(zcbor_state_t *state)
+{
+	state->payload_bak = state->payload;
+	state->payload++;
+	state->elem_count--;
+}
+
+
+/** Consume the next value if it is a pint that is encoded in the header byte.
+ *
+ *  Returns false without touching the state otherwise, in which case the caller
+ *  must fall back to the out-of-line function, which also reports any error.
+ */
+static inline bool zcbor_fast_uint_decode(zcbor_state_t *state, uint8_t *result)
+{
+	if (zcbor_fast_decode_ok(state) && (*state->payload <= ZCBOR_VALUE_IN_HEADER)) {
+		*result = *state->payload;
+		zcbor_fast_decode_consume(state);
+		return true;
+	}
+	return false;
+}
+
+
+/** Like @ref zcbor_fast_uint_decode, but also accepts a nint (-24 to -1). */
+static inline bool zcbor_fast_int_decode(zcbor_state_t *state, int8_t *result)
+{
+	if (zcbor_fast_decode_ok(state) && (ZCBOR_ADDITIONAL(*state->payload) <= ZCBOR_VALUE_IN_HEADER)) {
+		if (ZCBOR_MAJOR_TYPE(*state->payload) == ZCBOR_MAJOR_TYPE_PINT) {
+			*result = (int8_t)*state->payload;
+		} else if (ZCBOR_MAJOR_TYPE(*state->payload) == ZCBOR_MAJOR_TYPE_NINT) {
+			*result = (int8_t)(-1 - (int8_t)ZCBOR_ADDITIONAL(*state->payload));
+		} else {
+			return false;
+		}
+		zcbor_fast_decode_consume(state);
+		return true;
+	}
+	return false;
+}
+
+
+/** Consume the next value if its header byte is @p header. */
+static inline bool zcbor_fast_header_expect(zcbor_state_t *state, uint8_t header)
+{
+	if (zcbor_fast_decode_ok(state) && (*state->payload == header)) {
+		zcbor_fast_decode_consume(state);
+		return true;
+	}
+	return false;
+}
+
+
+/** Consume the next value if it is @p expected, encoded in the header byte. */
+static inline bool zcbor_fast_int_expect(zcbor_state_t *state, int64_t expected)
+{
+	if (expected >= 0 && expected <= ZCBOR_VALUE_IN_HEADER) {
+		return zcbor_fast_header_expect(state, (uint8_t)expected);
+	} else if (expected < 0 && expected >= -1 - ZCBOR_VALUE_IN_HEADER) {
+		return zcbor_fast_header_expect(state,
+			(uint8_t)((ZCBOR_MAJOR_TYPE_NINT << 5) | (uint8_t)(-1 - expected)));
+	}
+	return false;
+}
+
+
+#define ZCBOR_FAST_UINT_DECODE(state, result) \
+do { \
+	uint8_t value; \
+	if (zcbor_fast_uint_decode(state, &value)) { \
+		*result = value; \
+		return true; \
+	} \
+} while(0)
+
+#define ZCBOR_FAST_INT_DECODE(state, result) \
+do { \
+	int8_t value; \
+	if (zcbor_fast_int_decode(state, &value)) { \
+		*result = value; \
+		return true; \
+	} \
+} while(0)
+
+#define ZCBOR_FAST_EXPECT(expr) \
+do { \
+	if (expr) { \
+		return true; \
+	} \
+} while(0)
+
+#else
+#define ZCBOR_FAST_UINT_DECODE(state, result)
+#define ZCBOR_FAST_INT_DECODE(state, result)
+#define ZCBOR_FAST_EXPECT(expr)
+#endif /* ZCBOR_INLINE_FAST_PATH */
+
+
+ZCBOR_INLINE_API bool zcbor_int8_decode(zcbor_state_t *state, int8_t *result)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	ZCBOR_FAST_INT_DECODE(state, result);
+	return zcbor_int_decode(state, result, sizeof(*result));
+}
+
+
+ZCBOR_INLINE_API bool zcbor_int16_decode(zcbor_state_t *state, int16_t *result)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	ZCBOR_FAST_INT_DECODE(state, result);
+	return zcbor_int_decode(state, result, sizeof(*result));
+}
+
+
+ZCBOR_INLINE_API bool zcbor_int32_decode(zcbor_state_t *state, int32_t *result)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	ZCBOR_FAST_INT_DECODE(state, result);
+	return zcbor_int_decode(state, result, sizeof(*result));
+}
+
+
+ZCBOR_INLINE_API bool zcbor_int64_decode(zcbor_state_t *state, int64_t *result)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	ZCBOR_FAST_INT_DECODE(state, result);
+	return zcbor_int_decode(state, result, sizeof(*result));
+}
+
+
+ZCBOR_INLINE_API bool zcbor_uint8_decode(zcbor_state_t *state, uint8_t *result)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	ZCBOR_FAST_UINT_DECODE(state, result);
+	return zcbor_uint_decode(state, result, sizeof(*result));
+}
+
+
+ZCBOR_INLINE_API bool zcbor_uint16_decode(zcbor_state_t *state, uint16_t *result)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	ZCBOR_FAST_UINT_DECODE(state, result);
+	return zcbor_uint_decode(state, result, sizeof(*result));
+}
+
+
+ZCBOR_INLINE_API bool zcbor_uint32_decode(zcbor_state_t *state, uint32_t *result)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	ZCBOR_FAST_UINT_DECODE(state, result);
+	return zcbor_uint_decode(state, result, sizeof(*result));
+}
+
+
+ZCBOR_INLINE_API bool zcbor_uint64_decode(zcbor_state_t *state, uint64_t *result)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	ZCBOR_FAST_UINT_DECODE(state, result);
+	return zcbor_uint_decode(state, result, sizeof(*result));
+}
+
+
+#ifdef ZCBOR_SUPPORTS_SIZE_T
+ZCBOR_INLINE_API bool zcbor_size_decode(zcbor_state_t *state, size_t *result)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	ZCBOR_FAST_UINT_DECODE(state, result);
+	return zcbor_uint_decode(state, result, sizeof(*result));
+}
+#endif
+
+
+ZCBOR_INLINE_API bool zcbor_int8_expect(zcbor_state_t *state, int8_t expected)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	ZCBOR_FAST_EXPECT(zcbor_fast_int_expect(state, expected));
+	return zcbor_int64_expect(state, expected);
+}
+
+
+ZCBOR_INLINE_API bool zcbor_int8_pexpect(zcbor_state_t *state, int8_t *expected)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	return zcbor_int8_expect(state, *expected);
+}
+
+
+ZCBOR_INLINE_API bool zcbor_int16_expect(zcbor_state_t *state, int16_t expected)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	ZCBOR_FAST_EXPECT(zcbor_fast_int_expect(state, expected));
+	return zcbor_int64_expect(state, expected);
+}
+
+
+ZCBOR_INLINE_API bool zcbor_int16_pexpect(zcbor_state_t *state, int16_t *expected)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	return zcbor_int16_expect(state, *expected);
+}
+
+
+ZCBOR_INLINE_API bool zcbor_int32_expect(zcbor_state_t *state, int32_t expected)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	ZCBOR_FAST_EXPECT(zcbor_fast_int_expect(state, expected));
+	return zcbor_int64_expect(state, expected);
+}
+
+
+ZCBOR_INLINE_API bool zcbor_int32_pexpect(zcbor_state_t *state, int32_t *expected)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	return zcbor_int32_expect(state, *expected);
+}
+
+
+ZCBOR_INLINE_API bool zcbor_int64_pexpect(zcbor_state_t *state, int64_t *expected)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	ZCBOR_FAST_EXPECT(zcbor_fast_int_expect(state, *expected));
+	return zcbor_int64_expect(state, *expected);
+}
+
+
+ZCBOR_INLINE_API bool zcbor_uint8_expect(zcbor_state_t *state, uint8_t expected)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	ZCBOR_FAST_EXPECT((expected <= ZCBOR_VALUE_IN_HEADER)
+		&& zcbor_fast_header_expect(state, (uint8_t)expected));
+	return zcbor_uint64_expect(state, expected);
+}
+
+
+ZCBOR_INLINE_API bool zcbor_uint8_pexpect(zcbor_state_t *state, uint8_t *expected)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	return zcbor_uint8_expect(state, *expected);
+}
+
+
+ZCBOR_INLINE_API bool zcbor_uint16_expect(zcbor_state_t *state, uint16_t expected)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	ZCBOR_FAST_EXPECT((expected <= ZCBOR_VALUE_IN_HEADER)
+		&& zcbor_fast_header_expect(state, (uint8_t)expected));
+	return zcbor_uint64_expect(state, expected);
+}
+
+
+ZCBOR_INLINE_API bool zcbor_uint16_pexpect(zcbor_state_t *state, uint16_t *expected)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	return zcbor_uint16_expect(state, *expected);
+}
+
+
+ZCBOR_INLINE_API bool zcbor_uint32_expect(zcbor_state_t *state, uint32_t expected)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	ZCBOR_FAST_EXPECT((expected <= ZCBOR_VALUE_IN_HEADER)
+		&& zcbor_fast_header_expect(state, (uint8_t)expected));
+	return zcbor_uint64_expect(state, expected);
+}
+
+
+ZCBOR_INLINE_API bool zcbor_uint32_pexpect(zcbor_state_t *state, uint32_t *expected)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	return zcbor_uint32_expect(state, *expected);
+}
+
+
+ZCBOR_INLINE_API bool zcbor_uint64_pexpect(zcbor_state_t *state, uint64_t *expected)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	ZCBOR_FAST_EXPECT((*expected <= ZCBOR_VALUE_IN_HEADER)
+		&& zcbor_fast_header_expect(state, (uint8_t)*expected));
+	return zcbor_uint64_expect(state, *expected);
+}
+
+
+#ifdef ZCBOR_SUPPORTS_SIZE_T
+ZCBOR_INLINE_API bool zcbor_size_expect(zcbor_state_t *state, size_t expected)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	ZCBOR_FAST_EXPECT((expected <= ZCBOR_VALUE_IN_HEADER)
+		&& zcbor_fast_header_expect(state, (uint8_t)expected));
+	return zcbor_uint64_expect(state, expected);
+}
+
+
+ZCBOR_INLINE_API bool zcbor_size_pexpect(zcbor_state_t *state, size_t *expected)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	return zcbor_size_expect(state, *expected);
+}
+#endif
+
+
+ZCBOR_INLINE_API bool zcbor_bstr_expect_ptr(zcbor_state_t *state, char const *ptr, size_t len)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	struct zcbor_string zs = {(const uint8_t *)ptr, len};
+
+	return zcbor_bstr_expect(state, &zs);
+}
+
+
+ZCBOR_INLINE_API bool zcbor_tstr_expect_ptr(zcbor_state_t *state, char const *ptr, size_t len)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	struct zcbor_string zs = {(const uint8_t *)ptr, len};
+
+	return zcbor_tstr_expect(state, &zs);
+}
+
+
+ZCBOR_INLINE_API bool zcbor_tag_pexpect(zcbor_state_t *state, uint32_t *expected)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	return zcbor_tag_expect(state, *expected);
+}
+
+
+ZCBOR_INLINE_API bool zcbor_float16_bytes_pexpect(zcbor_state_t *state, uint16_t *expected)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	return zcbor_float16_bytes_expect(state, *expected);
+}
+
+
+ZCBOR_INLINE_API bool zcbor_float16_pexpect(zcbor_state_t *state, float *expected)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	return zcbor_float16_expect(state, *expected);
+}
+
+
+ZCBOR_INLINE_API bool zcbor_float32_pexpect(zcbor_state_t *state, float *expected)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	return zcbor_float32_expect(state, *expected);
+}
+
+
+ZCBOR_INLINE_API bool zcbor_float16_32_pexpect(zcbor_state_t *state, float *expected)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	return zcbor_float16_32_expect(state, *expected);
+}
+
+
+ZCBOR_INLINE_API bool zcbor_float64_pexpect(zcbor_state_t *state, double *expected)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	return zcbor_float64_expect(state, *expected);
+}
+
+
+ZCBOR_INLINE_API bool zcbor_float32_64_pexpect(zcbor_state_t *state, double *expected)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	return zcbor_float32_64_expect(state, *expected);
+}
+
+
+ZCBOR_INLINE_API bool zcbor_float_pexpect(zcbor_state_t *state, double *expected)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	return zcbor_float_expect(state, *expected);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZCBOR_DECODE_INLINE_H__ */
@@ -59,44 +59,55 @@ do { \
  * @retval false  If the payload is exhausted. Or an unexpected error happened.
  *                Use zcbor_peek_error() to see the error code.
  */
-bool zcbor_int8_put(zcbor_state_t *state, int8_t input);
-bool zcbor_int16_put(zcbor_state_t *state, int16_t input);
-bool zcbor_int32_put(zcbor_state_t *state, int32_t input); /* pint/nint */
-bool zcbor_int64_put(zcbor_state_t *state, int64_t input); /* pint/nint */
-bool zcbor_uint8_put(zcbor_state_t *state, uint8_t input);
-bool zcbor_uint16_put(zcbor_state_t *state, uint16_t input);
-bool zcbor_uint32_put(zcbor_state_t *state, uint32_t input); /* pint */
-bool zcbor_uint64_put(zcbor_state_t *state, uint64_t input); /* pint */
-bool zcbor_size_put(zcbor_state_t *state, size_t input); /* pint */
+ZCBOR_INLINE_API bool zcbor_int8_put(zcbor_state_t *state, int8_t input);
+ZCBOR_INLINE_API bool zcbor_int16_put(zcbor_state_t *state, int16_t input);
+ZCBOR_INLINE_API bool zcbor_int32_put(zcbor_state_t *state, int32_t input); /* pint/nint */
+ZCBOR_INLINE_API bool zcbor_int64_put(zcbor_state_t *state, int64_t input); /* pint/nint */
+ZCBOR_INLINE_API bool zcbor_uint8_put(zcbor_state_t *state, uint8_t input);
+ZCBOR_INLINE_API bool zcbor_uint16_put(zcbor_state_t *state, uint16_t input);
+ZCBOR_INLINE_API bool zcbor_uint32_put(zcbor_state_t *state, uint32_t input); /* pint */
+ZCBOR_INLINE_API bool zcbor_uint64_put(zcbor_state_t *state, uint64_t input); /* pint */
+ZCBOR_INLINE_API bool zcbor_size_put(zcbor_state_t *state, size_t input); /* pint */
 bool zcbor_tag_put(zcbor_state_t *state, uint32_t tag); /* CBOR tag */
 bool zcbor_bool_put(zcbor_state_t *state, bool input); /* boolean CBOR simple value */
 bool zcbor_nil_put(zcbor_state_t *state, const void *unused); /* 'nil' CBOR simple value */
 bool zcbor_undefined_put(zcbor_state_t *state, const void *unused); /* 'undefined' CBOR simple value */
-bool zcbor_float16_put(zcbor_state_t *state, float input); /* IEEE754 float16 */
-bool zcbor_float16_bytes_put(zcbor_state_t *state, uint16_t input); /* IEEE754 float16 raw bytes */
-bool zcbor_float32_put(zcbor_state_t *state, float input); /* IEEE754 float32 */
-bool zcbor_float64_put(zcbor_state_t *state, double input); /* IEEE754 float64 */
-
-bool zcbor_int8_encode(zcbor_state_t *state, const int8_t *input);
-bool zcbor_int16_encode(zcbor_state_t *state, const int16_t *input);
-bool zcbor_int32_encode(zcbor_state_t *state, const int32_t *input); /* pint/nint */
-bool zcbor_int64_encode(zcbor_state_t *state, const int64_t *input); /* pint/nint */
-bool zcbor_uint8_encode(zcbor_state_t *state, const uint8_t *input);
-bool zcbor_uint16_encode(zcbor_state_t *state, const uint16_t *input);
-bool zcbor_uint32_encode(zcbor_state_t *state, const uint32_t *input); /* pint */
-bool zcbor_uint64_encode(zcbor_state_t *state, const uint64_t *input); /* pint */
-bool zcbor_size_encode(zcbor_state_t *state, const size_t *input); /* pint */
+ZCBOR_INLINE_API bool zcbor_float16_put(zcbor_state_t *state, float input); /* IEEE754 float16 */
+ZCBOR_INLINE_API bool zcbor_float16_bytes_put(zcbor_state_t *state, uint16_t input); /* IEEE754 float16 raw bytes */
+ZCBOR_INLINE_API bool zcbor_float32_put(zcbor_state_t *state, float input); /* IEEE754 float32 */
+ZCBOR_INLINE_API bool zcbor_float64_put(zcbor_state_t *state, double input); /* IEEE754 float64 */
+
+ZCBOR_INLINE_API bool zcbor_int8_encode(zcbor_state_t *state, const int8_t *input);
+ZCBOR_INLINE_API bool zcbor_int16_encode(zcbor_state_t *state, const int16_t *input);
+ZCBOR_INLINE_API bool zcbor_int32_encode(zcbor_state_t *state, const int32_t *input); /* pint/nint */
+ZCBOR_INLINE_API bool zcbor_int64_encode(zcbor_state_t *state, const int64_t *input); /* pint/nint */
+ZCBOR_INLINE_API bool zcbor_uint8_encode(zcbor_state_t *state, const uint8_t *input);
+ZCBOR_INLINE_API bool zcbor_uint16_encode(zcbor_state_t *state, const uint16_t *input);
+ZCBOR_INLINE_API bool zcbor_uint32_encode(zcbor_state_t *state, const uint32_t *input); /* pint */
+ZCBOR_INLINE_API bool zcbor_uint64_encode(zcbor_state_t *state, const uint64_t *input); /* pint */
+ZCBOR_INLINE_API bool zcbor_size_encode(zcbor_state_t *state, const size_t *input); /* pint */
 bool zcbor_int_encode(zcbor_state_t *state, const void *input_int, size_t int_size);
 bool zcbor_uint_encode(zcbor_state_t *state, const void *input_uint, size_t uint_size);
 bool zcbor_bstr_encode(zcbor_state_t *state, const struct zcbor_string *input); /* bstr */
 bool zcbor_tstr_encode(zcbor_state_t *state, const struct zcbor_string *input); /* tstr */
-bool zcbor_tag_encode(zcbor_state_t *state, uint32_t *tag); /* CBOR tag. Note that zcbor_tag_encode()'s argument was changed to be a pointer. See also zcbor_tag_put(). */
+ZCBOR_INLINE_API bool zcbor_tag_encode(zcbor_state_t *state, uint32_t *tag); /* CBOR tag. Note that zcbor_tag_encode()'s argument was changed to be a pointer. See also zcbor_tag_put(). */
 bool zcbor_bool_encode(zcbor_state_t *state, const bool *input); /* boolean CBOR simple value */
-bool zcbor_float16_encode(zcbor_state_t *state, const float *input); /* IEEE754 float16 */
+ZCBOR_INLINE_API bool zcbor_float16_encode(zcbor_state_t *state, const float *input); /* IEEE754 float16 */
 bool zcbor_float16_bytes_encode(zcbor_state_t *state, const uint16_t *input); /* IEEE754 float16 raw bytes */
 bool zcbor_float32_encode(zcbor_state_t *state, const float *input); /* IEEE754 float32 */
 bool zcbor_float64_encode(zcbor_state_t *state, const double *input); /* IEEE754 float64 */
 
+#ifdef ZCBOR_STRING_OFFSETS
+/** Encode a bstr or tstr like @ref zcbor_bstr_encode or @ref zcbor_tstr_encode, from a
+ *  struct zcbor_string_off relative to `state->string_base`.
+ *
+ * `state->string_base` defaults to the payload being encoded into, so set it before
+ * encoding, e.g. with @ref zcbor_string_base_entry_function.
+ */
+bool zcbor_bstr_off_encode(zcbor_state_t *state, const struct zcbor_string_off *input); /* bstr */
+bool zcbor_tstr_off_encode(zcbor_state_t *state, const struct zcbor_string_off *input); /* tstr */
+#endif
+
 /** Encode a list/map header.
  *
  * The contents of the list/map can be encoded via subsequent function calls.
@@ -139,6 +150,39 @@ bool zcbor_list_end_encode(zcbor_state_t *state, size_t size_hint);
 bool zcbor_map_end_encode(zcbor_state_t *state, size_t size_hint);
 bool zcbor_list_map_end_force_encode(zcbor_state_t *state);
 
+/** Encode a list whose elements have already been encoded into separate buffers.
+ *
+ * Encodes a list header for @p num_elems elements, followed by the contents of
+ * @p chunks, in order. This can be used to stitch together the results of
+ * encoding different slices of a large list, e.g. on different threads, each
+ * with its own state and buffer.
+ * The header always uses the shortest encoding, so the result is canonical if
+ * the elements are.
+ *
+ * @param[inout] state      The current state of the encoding.
+ * @param[in]    num_elems  The total number of elements encoded in @p chunks.
+ * @param[in]    chunks     The encoded elements. Each chunk must contain a
+ *                          whole number of elements.
+ * @param[in]    num_chunks The number of chunks.
+ */
+bool zcbor_list_chunks_encode(zcbor_state_t *state, size_t num_elems,
+		const struct zcbor_string *chunks, size_t num_chunks);
+
+/** Write a single element that is already encoded, verbatim.
+ *
+ * This can be used to pass on an element returned by @ref zcbor_raw_decode
+ * without decoding and reencoding it.
+ * The bytes are copied as they are, and are not checked, so they must contain
+ * exactly one well-formed element (including any tags), or the result is not
+ * valid CBOR. The result is only canonical if the element is.
+ *
+ * @param[inout] state  The current state of the encoding.
+ * @param[in]    raw    The encoded element.
+ * @param[in]    len    The length of the encoded element.
+ */
+bool zcbor_raw_put(zcbor_state_t *state, const void *raw, size_t len);
+ZCBOR_INLINE_API bool zcbor_raw_encode(zcbor_state_t *state, const struct zcbor_string *input);
+
 /** Encode 0 or more elements with the same type and constraints.
  *
  * The encoded values are taken from the @p input array.
@@ -200,6 +244,15 @@ bool zcbor_multi_encode_minmax(size_t min_encode, size_t max_encode,
 		const size_t *num_encode, zcbor_encoder_t encoder,
 		zcbor_state_t *state, const void *input, size_t input_len);
 
+/** Like @ref zcbor_multi_encode_minmax, but for input in a struct-of-arrays layout.
+ *
+ * @p input is passed unchanged to @p encoder, together with the index of each element.
+ * See @ref zcbor_multi_decode_soa.
+ */
+bool zcbor_multi_encode_soa_minmax(size_t min_encode, size_t max_encode,
+		const size_t *num_encode, zcbor_soa_encoder_t encoder,
+		zcbor_state_t *state, const void *input);
+
 
 /* Supplementary string (bstr/tstr) encoding functions: */
 
@@ -214,8 +267,8 @@ bool zcbor_multi_encode_minmax(size_t min_encode, size_t max_encode,
  * @param[in]    maxlen  (if present) The maximum length of the string pointed to by @p str.
  *                       This value is passed to strnlen.
  */
-bool zcbor_bstr_encode_ptr(zcbor_state_t *state, const char *str, size_t len);
-bool zcbor_tstr_encode_ptr(zcbor_state_t *state, const char *str, size_t len);
+ZCBOR_INLINE_API bool zcbor_bstr_encode_ptr(zcbor_state_t *state, const char *str, size_t len);
+ZCBOR_INLINE_API bool zcbor_tstr_encode_ptr(zcbor_state_t *state, const char *str, size_t len);
 bool zcbor_bstr_put_term(zcbor_state_t *state, char const *str, size_t maxlen);
 bool zcbor_tstr_put_term(zcbor_state_t *state, char const *str, size_t maxlen);
 #define zcbor_bstr_put_lit(state, str) zcbor_bstr_encode_ptr(state, str, sizeof(str) - 1)
@@ -243,6 +296,28 @@ bool zcbor_bstr_start_encode(zcbor_state_t *state);
  */
 bool zcbor_bstr_end_encode(zcbor_state_t *state, struct zcbor_string *result);
 
+/** Start encoding an indefinite length bstr/tstr, i.e. a string split into chunks.
+ *
+ * This allows encoding a string without knowing its length in advance.
+ * Encode each chunk with zcbor_*str_chunk_encode(), then call
+ * @ref zcbor_str_chunks_end_encode. The chunks must be of the same type as the string.
+ * Since each chunk has its own header, the payload can be divided into payload sections
+ * between chunks.
+ *
+ * Note that indefinite length strings are not allowed in canonical CBOR.
+ *
+ * @param[inout] state   The current state of the encoding.
+ */
+bool zcbor_bstr_chunks_start_encode(zcbor_state_t *state);
+bool zcbor_tstr_chunks_start_encode(zcbor_state_t *state);
+
+/** Encode a chunk of an indefinite length string. */
+bool zcbor_bstr_chunk_encode(zcbor_state_t *state, const struct zcbor_string *chunk);
+bool zcbor_tstr_chunk_encode(zcbor_state_t *state, const struct zcbor_string *chunk);
+
+/** Finish encoding an indefinite length string by encoding the break marker. */
+bool zcbor_str_chunks_end_encode(zcbor_state_t *state);
+
 
 #ifdef ZCBOR_FRAGMENTS
 
@@ -295,4 +370,8 @@ bool zcbor_str_fragments_end_encode(zcbor_state_t *state);
 }
 #endif
 
+#ifdef ZCBOR_INLINE
+#include "zcbor_encode_inline.h"
+#endif
+
 #endif /* ZCBOR_ENCODE_H__ */
@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZCBOR_ENCODE_INLINE_H__
+#define ZCBOR_ENCODE_INLINE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "zcbor_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** The small encoding functions that forward to other public functions.
+ *
+ * Included by zcbor_encode.h with ZCBOR_INLINE, and by zcbor_encode.c otherwise.
+ * See zcbor_decode_inline.h. Don't include this file directly.
+ */
+
+
+#ifdef ZCBOR_INLINE_FAST_PATH
+/** Encode @p header as a value that is encoded entirely in the header byte, the
+ *  same way as the out-of-line functions do.
+ *
+ *  Returns false without touching the state if the value doesn't fit in the
+ *  payload, in which case the caller must fall back to the out-of-line function,
+ *  which also reports the error.
+ */
+static inline bool zcbor_fast_header_put(zcbor_state_t *state, uint8_t header)
+{
+	if ((state != NULL) && (state->payload < state->payload_end)
+#ifdef ZCBOR_STOP_ON_ERROR
+			&& zcbor_check_error(state)
+#endif
+#ifdef ZCBOR_FRAGMENTS
+			&& !state->inside_frag_str
+#endif
+			) {
+		*(state->payload_mut++) = header;
+		state->elem_count++;
+		return true;
+	}
+	return false;
+}
+
+
+/** Encode @p input if it can be encoded in the header byte. */
+static inline bool zcbor_fast_int_put(zcbor_state_t *state, int64_t input)
+{
+	if (input >= 0 && input <= ZCBOR_VALUE_IN_HEADER) {
+		return zcbor_fast_header_put(state, (uint8_t)input);
+	} else if (input < 0 && input >= -1 - ZCBOR_VALUE_IN_HEADER) {
+		return zcbor_fast_header_put(state,
+			(uint8_t)((ZCBOR_MAJOR_TYPE_NINT << 5) | (uint8_t)(-1 - input)));
+	}
+	return false;
+}
+
+
+#define ZCBOR_FAST_UINT_PUT(state, input) \
+do { \
+	if (((input) <= ZCBOR_VALUE_IN_HEADER) && zcbor_fast_header_put(state, (uint8_t)(input))) { \
+		return true; \
+	} \
+} while(0)
+
+#define ZCBOR_FAST_INT_PUT(state, input) \
+do { \
+	if (zcbor_fast_int_put(state, input)) { \
+		return true; \
+	} \
+} while(0)
+
+#else
+#define ZCBOR_FAST_UINT_PUT(state, input)
+#define ZCBOR_FAST_INT_PUT(state, input)
+#endif /* ZCBOR_INLINE_FAST_PATH */
+
+
+ZCBOR_INLINE_API bool zcbor_int8_put(zcbor_state_t *state, int8_t input)
+{
+	ZCBOR_FAST_INT_PUT(state, input);
+	return zcbor_int_encode(state, &input, sizeof(input));
+}
+
+
+ZCBOR_INLINE_API bool zcbor_int16_put(zcbor_state_t *state, int16_t input)
+{
+	ZCBOR_FAST_INT_PUT(state, input);
+	return zcbor_int_encode(state, &input, sizeof(input));
+}
+
+
+ZCBOR_INLINE_API bool zcbor_int32_put(zcbor_state_t *state, int32_t input)
+{
+	ZCBOR_FAST_INT_PUT(state, input);
+	return zcbor_int_encode(state, &input, sizeof(input));
+}
+
+
+ZCBOR_INLINE_API bool zcbor_int64_put(zcbor_state_t *state, int64_t input)
+{
+	ZCBOR_FAST_INT_PUT(state, input);
+	return zcbor_int_encode(state, &input, sizeof(input));
+}
+
+
+ZCBOR_INLINE_API bool zcbor_uint8_put(zcbor_state_t *state, uint8_t input)
+{
+	ZCBOR_FAST_UINT_PUT(state, input);
+	return zcbor_uint_encode(state, &input, sizeof(input));
+}
+
+
+ZCBOR_INLINE_API bool zcbor_uint16_put(zcbor_state_t *state, uint16_t input)
+{
+	ZCBOR_FAST_UINT_PUT(state, input);
+	return zcbor_uint_encode(state, &input, sizeof(input));
+}
+
+
+ZCBOR_INLINE_API bool zcbor_uint32_put(zcbor_state_t *state, uint32_t input)
+{
+	ZCBOR_FAST_UINT_PUT(state, input);
+	return zcbor_uint_encode(state, &input, sizeof(input));
+}
+
+
+ZCBOR_INLINE_API bool zcbor_uint64_put(zcbor_state_t *state, uint64_t input)
+{
+	ZCBOR_FAST_UINT_PUT(state, input);
+	return zcbor_uint_encode(state, &input, sizeof(input));
+}
+
+
+ZCBOR_INLINE_API bool zcbor_int8_encode(zcbor_state_t *state, const int8_t *input)
+{
+	ZCBOR_FAST_INT_PUT(state, *input);
+	return zcbor_int_encode(state, input, sizeof(*input));
+}
+
+
+ZCBOR_INLINE_API bool zcbor_int16_encode(zcbor_state_t *state, const int16_t *input)
+{
+	ZCBOR_FAST_INT_PUT(state, *input);
+	return zcbor_int_encode(state, input, sizeof(*input));
+}
+
+
+ZCBOR_INLINE_API bool zcbor_int32_encode(zcbor_state_t *state, const int32_t *input)
+{
+	ZCBOR_FAST_INT_PUT(state, *input);
+	return zcbor_int_encode(state, input, sizeof(*input));
+}
+
+
+ZCBOR_INLINE_API bool zcbor_int64_encode(zcbor_state_t *state, const int64_t *input)
+{
+	ZCBOR_FAST_INT_PUT(state, *input);
+	return zcbor_int_encode(state, input, sizeof(*input));
+}
+
+
+ZCBOR_INLINE_API bool zcbor_uint8_encode(zcbor_state_t *state, const uint8_t *input)
+{
+	ZCBOR_FAST_UINT_PUT(state, *input);
+	return zcbor_uint_encode(state, input, sizeof(*input));
+}
+
+
+ZCBOR_INLINE_API bool zcbor_uint16_encode(zcbor_state_t *state, const uint16_t *input)
+{
+	ZCBOR_FAST_UINT_PUT(state, *input);
+	return zcbor_uint_encode(state, input, sizeof(*input));
+}
+
+
+ZCBOR_INLINE_API bool zcbor_uint32_encode(zcbor_state_t *state, const uint32_t *input)
+{
+	ZCBOR_FAST_UINT_PUT(state, *input);
+	return zcbor_uint_encode(state, input, sizeof(*input));
+}
+
+
+ZCBOR_INLINE_API bool zcbor_uint64_encode(zcbor_state_t *state, const uint64_t *input)
+{
+	ZCBOR_FAST_UINT_PUT(state, *input);
+	return zcbor_uint_encode(state, input, sizeof(*input));
+}
+
+
+#ifdef ZCBOR_SUPPORTS_SIZE_T
+ZCBOR_INLINE_API bool zcbor_size_put(zcbor_state_t *state, size_t input)
+{
+	ZCBOR_FAST_UINT_PUT(state, input);
+	return zcbor_uint_encode(state, &input, sizeof(input));
+}
+
+
+ZCBOR_INLINE_API bool zcbor_size_encode(zcbor_state_t *state, const size_t *input)
+{
+	ZCBOR_FAST_UINT_PUT(state, *input);
+	return zcbor_uint_encode(state, input, sizeof(*input));
+}
+#endif
+
+
+ZCBOR_INLINE_API bool zcbor_bstr_encode_ptr(zcbor_state_t *state, const char *str, size_t len)
+{
+	const struct zcbor_string zs = {(const uint8_t *)str, len};
+
+	return zcbor_bstr_encode(state, &zs);
+}
+
+
+ZCBOR_INLINE_API bool zcbor_tstr_encode_ptr(zcbor_state_t *state, const char *str, size_t len)
+{
+	const struct zcbor_string zs = {(const uint8_t *)str, len};
+
+	return zcbor_tstr_encode(state, &zs);
+}
+
+
+ZCBOR_INLINE_API bool zcbor_raw_encode(zcbor_state_t *state, const struct zcbor_string *input)
+{
+	return zcbor_raw_put(state, input->value, input->len);
+}
+
+
+ZCBOR_INLINE_API bool zcbor_float64_put(zcbor_state_t *state, double input)
+{
+	return zcbor_float64_encode(state, &input);
+}
+
+
+ZCBOR_INLINE_API bool zcbor_float32_put(zcbor_state_t *state, float input)
+{
+	return zcbor_float32_encode(state, &input);
+}
+
+
+ZCBOR_INLINE_API bool zcbor_float16_bytes_put(zcbor_state_t *state, uint16_t input)
+{
+	return zcbor_float16_bytes_encode(state, &input);
+}
+
+
+ZCBOR_INLINE_API bool zcbor_float16_put(zcbor_state_t *state, float input)
+{
+	return zcbor_float16_bytes_put(state, zcbor_float32_to_16(input));
+}
+
+
+ZCBOR_INLINE_API bool zcbor_float16_encode(zcbor_state_t *state, const float *input)
+{
+	return zcbor_float16_put(state, *input);
+}
+
+
+ZCBOR_INLINE_API bool zcbor_tag_encode(zcbor_state_t *state, uint32_t *tag)
+{
+	return zcbor_tag_put(state, *tag);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZCBOR_ENCODE_INLINE_H__ */
@@ -75,6 +75,18 @@ do { \
 #define zcbor_assert_state(expr, ...)
 #endif
 
+#ifdef ZCBOR_TRACE_BUFFER
+/** Record the call of the generated function with id @p func_id in the trace buffer. */
+#define zcbor_trace_enter(state, func_id) \
+	zcbor_trace_record(state, ZCBOR_TRACE_ENTER, func_id)
+/** Record the return of the generated function with id @p func_id in the trace buffer. */
+#define zcbor_trace_exit(state, func_id, result) \
+	zcbor_trace_record(state, (result) ? ZCBOR_TRACE_SUCCESS : ZCBOR_TRACE_FAIL, func_id)
+#else
+#define zcbor_trace_enter(state, func_id)
+#define zcbor_trace_exit(state, func_id, result)
+#endif
+
 
 /** Print the function name.
  */
@@ -97,6 +109,15 @@ void zcbor_print_error(int error);
 
 void zcbor_dump_hex(const uint8_t *str, size_t str_len);
 
+struct zcbor_profile_entry;
+
+/** Print a flat profile from a profile table, one line per CDDL rule that was
+ *  called, sorted by the time spent in the rule itself.
+ *
+ *  Code generated with `--profile` has a function that calls this with its table.
+ */
+void zcbor_profile_print(const struct zcbor_profile_entry *entries, size_t num_entries);
+
 #ifdef __cplusplus
 }
 #endif
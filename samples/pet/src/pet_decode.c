@@ -36,6 +36,7 @@ static bool decode_Pet(
 		zcbor_state_t *state, struct Pet *result)
 {
 	zcbor_log("%s\r\n", __func__);
+	zcbor_trace_enter(state, 1);
 
 	bool res = (((zcbor_list_start_decode(state) && ((((zcbor_list_start_decode(state) && ((zcbor_multi_decode(1, ZCBOR_PET_DEFAULT_MAX_QTY, &(*result).names_count, ZCBOR_CUSTOM_CAST_FP(zcbor_tstr_decode), state, (*&(*result).names), sizeof(struct zcbor_string))) || (zcbor_list_map_end_force_decode(state), false)) && zcbor_list_end_decode(state)))
 	&& ((zcbor_bstr_decode(state, (&(*result).birthday)))
@@ -52,6 +53,7 @@ static bool decode_Pet(
 	}
 
 	log_result(state, res, __func__);
+	zcbor_trace_exit(state, 1, res);
 	return res;
 }
 
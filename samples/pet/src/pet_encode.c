@@ -36,6 +36,7 @@ static bool encode_Pet(
 		zcbor_state_t *state, const struct Pet *input)
 {
 	zcbor_log("%s\r\n", __func__);
+	zcbor_trace_enter(state, 1);
 
 	bool res = (((zcbor_list_start_encode(state, 3) && ((((zcbor_list_start_encode(state, 0) && ((zcbor_multi_encode_minmax(1, ZCBOR_PET_DEFAULT_MAX_QTY, &(*input).names_count, ZCBOR_CUSTOM_CAST_FP(zcbor_tstr_encode), state, (*&(*input).names), sizeof(struct zcbor_string))) || (zcbor_list_map_end_force_encode(state), false)) && zcbor_list_end_encode(state, 0)))
 	&& (((((((*input).birthday.len == 8)) || (zcbor_error(state, ZCBOR_ERR_WRONG_RANGE), false))) || (zcbor_error(state, ZCBOR_ERR_WRONG_RANGE), false))
@@ -53,6 +54,7 @@ static bool encode_Pet(
 	}
 
 	log_result(state, res, __func__);
+	zcbor_trace_exit(state, 1, res);
 	return res;
 }
 
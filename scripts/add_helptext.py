@@ -26,6 +26,7 @@ if __name__ == "__main__":
         ["zcbor", "code", "--help"],
         ["zcbor", "validate", "--help"],
         ["zcbor", "convert", "--help"],
+        ["zcbor", "trace", "--help"],
     ]
 
     output = pattern
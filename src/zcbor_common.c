@@ -18,6 +18,75 @@ _Static_assert((sizeof(zcbor_state_t) >= sizeof(struct zcbor_state_constant)),
 	"This code needs zcbor_state_t to be at least as large as zcbor_backups_t.");
 
 
+#ifdef ZCBOR_STATS
+struct zcbor_stats zcbor_stats_global;
+
+
+void zcbor_stats_read(struct zcbor_stats *stats)
+{
+	memcpy(stats, &zcbor_stats_global, sizeof(*stats));
+}
+
+
+void zcbor_stats_reset(void)
+{
+	memset(&zcbor_stats_global, 0, sizeof(zcbor_stats_global));
+}
+#endif
+
+
+#ifdef ZCBOR_TRACE_BUFFER
+static struct zcbor_trace_buffer *trace_buffer;
+
+
+void zcbor_trace_start(struct zcbor_trace_buffer *buffer,
+		struct zcbor_trace_event *events, size_t num_events)
+{
+	memset(events, 0, num_events * sizeof(*events));
+	buffer->events = events;
+	buffer->num_events = num_events;
+	buffer->next = 0;
+	trace_buffer = buffer;
+}
+
+
+void zcbor_trace_stop(void)
+{
+	trace_buffer = NULL;
+}
+
+
+void zcbor_trace_record(const zcbor_state_t *state, uint8_t type, uint16_t func_id)
+{
+	if (!trace_buffer || (trace_buffer->num_events == 0)) {
+		return;
+	}
+
+	struct zcbor_trace_event *event =
+		&trace_buffer->events[trace_buffer->next % trace_buffer->num_events];
+	const struct zcbor_state_constant *cs = state->constant_state;
+
+	event->payload_offset = (cs && cs->curr_payload_section)
+		? (uint32_t)(state->payload - cs->curr_payload_section) : 0;
+	event->elem_count = (uint32_t)MIN(state->elem_count, UINT32_MAX);
+	event->func_id = func_id;
+	event->type = type;
+	event->error = (int8_t)(cs ? cs->error : ZCBOR_SUCCESS);
+	trace_buffer->next++;
+}
+#endif
+
+
+void zcbor_profile_reset(struct zcbor_profile_entry *entries, size_t num_entries)
+{
+	for (size_t i = 0; i < num_entries; i++) {
+		entries[i].calls = 0;
+		entries[i].ticks = 0;
+		entries[i].self_ticks = 0;
+	}
+}
+
+
 #ifdef ZCBOR_MAP_SMART_SEARCH
 /** Take a backup of the elem_state by copying it to immediately after itself.
  *
@@ -30,27 +99,32 @@ _Static_assert((sizeof(zcbor_state_t) >= sizeof(struct zcbor_state_constant)),
 static bool do_elem_state_backup(zcbor_state_t *state, bool dry_run)
 {
 	uint8_t *flags = state->decode_state.map_search_elem_state;
+	size_t flags_len = zcbor_flags_to_words(state->decode_state.map_elem_count);
 
-	if (!flags) {
-		ZCBOR_ERR(ZCBOR_ERR_MAP_FLAGS_NOT_AVAILABLE);
+	if (flags_len == 0) {
+		/* Not inside an unordered map, so there is nothing to back up.
+		 * This also works when no flags were provided at all. */
+		return true;
 	}
 
-	size_t flags_len = zcbor_flags_to_bytes(state->decode_state.map_elem_count);
-
-	/* Check for integer overflow
-	 * The expression is gained from rearranging: (flags + flags_len * 2) > SIZE_MAX
-	 * which matches how the variables are used in the subsequent check. */
-	if (flags_len > ((SIZE_MAX - (size_t)flags) / 2)) {
+	if (!flags) {
 		ZCBOR_ERR(ZCBOR_ERR_MAP_FLAGS_NOT_AVAILABLE);
 	}
 
-	if ((flags + flags_len * 2) > (state->constant_state->map_search_elem_state_end)) {
+	size_t words_left = (size_t)(state->constant_state->map_search_elem_state_end
+				- state->decode_state.map_search_elem_state) / sizeof(zcbor_flag_word_t);
+
+	/* Written this way (instead of (flags + flags_len * 2) > end) to avoid integer overflow. */
+	if (flags_len > (words_left / 2)) {
 		ZCBOR_ERR(ZCBOR_ERR_MAP_FLAGS_NOT_AVAILABLE);
 	}
 
 	if (!dry_run) {
-		memcpy(flags + flags_len, flags, flags_len);
-		state->decode_state.map_search_elem_state += flags_len;
+		size_t flags_bytes = flags_len * sizeof(zcbor_flag_word_t);
+
+		memcpy(&flags[flags_bytes], flags, flags_bytes);
+		state->decode_state.map_search_elem_state = &flags[flags_bytes];
+		ZCBOR_STATS_ADD(backup_bytes, flags_bytes);
 	}
 
 	return true;
@@ -59,15 +133,15 @@ static bool do_elem_state_backup(zcbor_state_t *state, bool dry_run)
 /** Discard the elem_state backup by copying the active elem_state to overwrite the backup. */
 static void discard_elem_state_backup(zcbor_state_t *state, zcbor_state_t *backup)
 {
-	uint8_t *flags = state->decode_state.map_search_elem_state;
 	uint8_t *backup_flags = backup->decode_state.map_search_elem_state;
-	size_t flags_len = zcbor_flags_to_bytes(state->decode_state.map_elem_count);
+	size_t flags_bytes = zcbor_flags_to_bytes(state->decode_state.map_elem_count);
 
 	/* Overwrite the backup with the current elem_state.
-	 * Use memmove because the active elem_state may have expanded since the
-	 * backup was made, in which case the source and destination areas overlap. */
-	memmove(backup_flags, flags, flags_len);
+	 * The active elem_state may have expanded since the backup was made, in which case
+	 * the source and destination areas overlap. */
+	memmove(backup_flags, state->decode_state.map_search_elem_state, flags_bytes);
 	state->decode_state.map_search_elem_state = backup_flags;
+	ZCBOR_STATS_ADD(backup_bytes, flags_bytes);
 }
 #endif
 
@@ -101,6 +175,8 @@ bool zcbor_new_backup_w_elem_state(zcbor_state_t *state, size_t new_elem_count,
 	size_t i = (state->constant_state->current_backup) - 1;
 
 	state->constant_state->backup_list[i] = *state;
+	ZCBOR_STATS_ADD(backups_created, 1);
+	ZCBOR_STATS_ADD(backup_bytes, sizeof(zcbor_state_t));
 
 	state->elem_count = new_elem_count;
 
@@ -155,6 +231,11 @@ bool zcbor_process_backup_num(zcbor_state_t *state, uint32_t flags,
 			}
 		}
 		*state = *backup;
+		ZCBOR_STATS_ADD(backups_restored, 1);
+#ifdef ZCBOR_WORK_BUDGET
+		/* The work done since the backup was taken stays spent. */
+		state->decode_state.work_budget = local_copy.decode_state.work_budget;
+#endif
 
 #ifdef ZCBOR_MAP_SMART_SEARCH
 		if (!(flags & ZCBOR_FLAG_CONSUME) && state->decode_state.elem_state_backed_up) {
@@ -191,6 +272,12 @@ bool zcbor_process_backup_num(zcbor_state_t *state, uint32_t flags,
 		state->decode_state = local_copy.decode_state;
 	}
 
+#ifdef ZCBOR_WORK_BUDGET
+	if (flags & ZCBOR_FLAG_RESTORE) {
+		ZCBOR_FAIL_IF(!zcbor_work_spend(state, 1));
+	}
+#endif
+
 	return true;
 }
 
@@ -218,6 +305,7 @@ bool zcbor_union_start_code(zcbor_state_t *state)
 	if (!zcbor_new_backup_w_elem_state(state, state->elem_count, true)) {
 		ZCBOR_FAIL();
 	}
+	ZCBOR_STATS_ADD(union_alternatives, 1);
 	return true;
 }
 
@@ -230,6 +318,7 @@ bool zcbor_union_elem_code(zcbor_state_t *state)
 	if (!zcbor_process_backup(state, ZCBOR_FLAG_RESTORE, ZCBOR_MAX_ELEM_COUNT)) {
 		ZCBOR_FAIL();
 	}
+	ZCBOR_STATS_ADD(union_alternatives, 1);
 	return true;
 }
 
@@ -246,6 +335,20 @@ bool zcbor_union_end_code(zcbor_state_t *state)
 }
 
 
+#ifdef ZCBOR_WORK_BUDGET
+/** Add the work budget for a payload (section) of @p payload_len bytes to @p budget,
+ *  saturating at SIZE_MAX. */
+static size_t add_work_budget(size_t budget, size_t payload_len)
+{
+	if ((ZCBOR_WORK_BUDGET_PER_BYTE != 0)
+		&& (payload_len > (SIZE_MAX - budget) / ZCBOR_WORK_BUDGET_PER_BYTE)) {
+		return SIZE_MAX;
+	}
+	return budget + (payload_len * ZCBOR_WORK_BUDGET_PER_BYTE);
+}
+#endif
+
+
 void zcbor_new_state(zcbor_state_t *state_array, size_t n_states,
 		const uint8_t *payload, size_t payload_len, size_t elem_count,
 		uint8_t *flags, size_t flags_bytes)
@@ -260,10 +363,18 @@ void zcbor_new_state(zcbor_state_t *state_array, size_t n_states,
 	state_array[0].payload_moved = false;
 	state_array[0].decode_state.indefinite_length_array = false;
 #ifdef ZCBOR_MAP_SMART_SEARCH
-	state_array[0].decode_state.map_search_elem_state = flags;
 	if (flags == NULL) {
 		flags_bytes = 0;
+	} else {
+		/* The flags are accessed as words, so align them for faster access. */
+		size_t misalignment = (size_t)flags % sizeof(zcbor_flag_word_t);
+		size_t adjustment = misalignment ? (sizeof(zcbor_flag_word_t) - misalignment) : 0;
+
+		adjustment = MIN(adjustment, flags_bytes);
+		flags += adjustment;
+		flags_bytes -= adjustment;
 	}
+	state_array[0].decode_state.map_search_elem_state = flags;
 	state_array[0].decode_state.map_elem_count = 0;
 #else
 	state_array[0].decode_state.map_elems_processed = 0;
@@ -277,6 +388,21 @@ void zcbor_new_state(zcbor_state_t *state_array, size_t n_states,
 	state_array[0].str_total_len = payload_len;
 	state_array[0].frag_offset_cbor = 0;
 	state_array[0].str_total_len_cbor = payload_len;
+#ifdef ZCBOR_VALIDATE_UTF8
+	state_array[0].frag_str_utf8 = false;
+#endif
+#endif
+#ifdef ZCBOR_WORK_BUDGET
+	state_array[0].decode_state.work_budget = add_work_budget(ZCBOR_WORK_BUDGET_BASE, payload_len);
+#endif
+#ifdef ZCBOR_ARENA
+	state_array[0].decode_state.arena = NULL;
+#endif
+#ifdef ZCBOR_BSTR_STREAM
+	state_array[0].decode_state.chunk_handler = NULL;
+#endif
+#ifdef ZCBOR_STRING_OFFSETS
+	state_array[0].string_base = payload;
 #endif
 	state_array[0].constant_state = NULL;
 
@@ -295,11 +421,15 @@ void zcbor_new_state(zcbor_state_t *state_array, size_t n_states,
 #endif
 	state_array[0].constant_state->enforce_canonical = ZCBOR_ENFORCE_CANONICAL_DEFAULT;
 	state_array[0].constant_state->manually_process_elem = ZCBOR_MANUALLY_PROCESS_ELEM_DEFAULT;
+#ifdef ZCBOR_TRUSTED_INPUT
+	state_array[0].constant_state->trust_input = false;
+#endif
 #ifdef ZCBOR_MAP_SMART_SEARCH
 	state_array[0].constant_state->map_search_elem_state_end = flags + flags_bytes;
 #endif
-#ifdef ZCBOR_FRAGMENTS
 	state_array[0].constant_state->curr_payload_section = payload;
+#ifdef ZCBOR_HASH_REGION
+	state_array[0].constant_state->consume_cb = NULL;
 #endif
 	if (n_states > 2) {
 		state_array[0].constant_state->backup_list = &state_array[1];
@@ -344,6 +474,46 @@ static void update_backups(zcbor_state_t *state, const uint8_t *old_payload, siz
 }
 
 
+#ifdef ZCBOR_HASH_REGION
+void zcbor_hash_region_flush(zcbor_state_t *state)
+{
+	struct zcbor_state_constant *cs = state->constant_state;
+
+	if (cs && cs->consume_cb && (state->payload > cs->consume_start)) {
+		cs->consume_cb(cs->consume_ctx, cs->consume_start,
+			(size_t)(state->payload - cs->consume_start));
+		cs->consume_start = state->payload;
+	}
+}
+
+
+bool zcbor_hash_region_start(zcbor_state_t *state, zcbor_consume_cb_t cb, void *ctx)
+{
+	ZCBOR_CHECK_NULL(state);
+	ZCBOR_ERR_IF(state->constant_state == NULL, ZCBOR_ERR_CONSTANT_STATE_MISSING);
+	ZCBOR_ERR_IF(cb == NULL, ZCBOR_ERR_BAD_ARG);
+	ZCBOR_ERR_IF(state->constant_state->consume_cb != NULL, ZCBOR_ERR_BAD_STATE);
+
+	state->constant_state->consume_cb = cb;
+	state->constant_state->consume_ctx = ctx;
+	state->constant_state->consume_start = state->payload;
+	return true;
+}
+
+
+bool zcbor_hash_region_end(zcbor_state_t *state)
+{
+	ZCBOR_CHECK_NULL(state);
+	ZCBOR_ERR_IF(state->constant_state == NULL, ZCBOR_ERR_CONSTANT_STATE_MISSING);
+	ZCBOR_ERR_IF(state->constant_state->consume_cb == NULL, ZCBOR_ERR_BAD_STATE);
+
+	zcbor_hash_region_flush(state);
+	state->constant_state->consume_cb = NULL;
+	return true;
+}
+#endif /* ZCBOR_HASH_REGION */
+
+
 void zcbor_update_state(zcbor_state_t *state, const uint8_t *payload, size_t payload_len)
 {
 	if (state == NULL) {
@@ -351,8 +521,18 @@ void zcbor_update_state(zcbor_state_t *state, const uint8_t *payload, size_t pay
 	}
 
 	const uint8_t *old_payload = state->payload;
+
+#ifdef ZCBOR_HASH_REGION
+	if (state->constant_state && state->constant_state->consume_cb) {
+		zcbor_hash_region_flush(state);
+		state->constant_state->consume_start = payload;
+	}
+#endif
 	update_state(state, payload, payload_len);
 	update_backups(state, old_payload, payload_len);
+#ifdef ZCBOR_WORK_BUDGET
+	state->decode_state.work_budget = add_work_budget(state->decode_state.work_budget, payload_len);
+#endif
 	state->constant_state->curr_payload_section = payload;
 }
 
@@ -503,6 +683,106 @@ bool zcbor_compare_strings(const struct zcbor_string *str1,
 }
 
 
+/** Check the continuation bytes expected by @p utf8, up to @p end. */
+static bool utf8_continue(struct zcbor_utf8_state *utf8, const uint8_t **str, const uint8_t *end)
+{
+	while ((utf8->num_cont > 0) && (*str < end)) {
+		if ((**str < utf8->min) || (**str > utf8->max)) {
+			return false;
+		}
+		(*str)++;
+		utf8->num_cont--;
+		utf8->min = 0x80;
+		utf8->max = 0xBF;
+	}
+	return true;
+}
+
+
+bool zcbor_validate_utf8_partial(struct zcbor_utf8_state *utf8, const uint8_t *str, size_t len)
+{
+	const size_t high_bits = ((size_t)-1 / 0xFF) * 0x80; /* 0x80 in every byte. */
+	const uint8_t *const end = str + len;
+
+	/* Finish a character that was started in a previous part. */
+	if (!utf8_continue(utf8, &str, end)) {
+		return false;
+	}
+
+	while (str < end) {
+		/* Skip ASCII a word at a time. memcpy() avoids unaligned accesses. */
+		while (((size_t)(end - str) >= sizeof(size_t))) {
+			size_t word;
+
+			memcpy(&word, str, sizeof(word));
+			if (word & high_bits) {
+				break;
+			}
+			str += sizeof(word);
+		}
+		if (str == end) {
+			break;
+		}
+
+		uint8_t lead = *str++;
+		size_t num_cont;
+		uint8_t min = 0x80; /* Allowed range of the first continuation byte. */
+		uint8_t max = 0xBF;
+
+		if (lead < 0x80) {
+			continue;
+		} else if (lead < 0xC2) {
+			return false; /* Continuation byte or overlong 2-byte sequence. */
+		} else if (lead < 0xE0) {
+			num_cont = 1;
+		} else if (lead < 0xF0) {
+			num_cont = 2;
+			if (lead == 0xE0) {
+				min = 0xA0; /* Overlong */
+			} else if (lead == 0xED) {
+				max = 0x9F; /* Surrogates */
+			}
+		} else if (lead < 0xF5) {
+			num_cont = 3;
+			if (lead == 0xF0) {
+				min = 0x90; /* Overlong */
+			} else if (lead == 0xF4) {
+				max = 0x8F; /* Above U+10FFFF */
+			}
+		} else {
+			return false;
+		}
+
+		if ((size_t)(end - str) < num_cont) {
+			/* The character continues in the next part. */
+			utf8->num_cont = (uint8_t)num_cont;
+			utf8->min = min;
+			utf8->max = max;
+			return utf8_continue(utf8, &str, end);
+		}
+		if ((str[0] < min) || (str[0] > max)) {
+			return false;
+		}
+		for (size_t i = 1; i < num_cont; i++) {
+			if ((str[i] & 0xC0) != 0x80) {
+				return false;
+			}
+		}
+		str += num_cont;
+	}
+
+	return true;
+}
+
+
+bool zcbor_validate_utf8(const uint8_t *str, size_t len)
+{
+	struct zcbor_utf8_state utf8 = {0};
+
+	return zcbor_validate_utf8_partial(&utf8, str, len) && (utf8.num_cont == 0);
+}
+
+
 size_t zcbor_header_len(uint64_t value)
 {
 	if (value <= ZCBOR_VALUE_IN_HEADER) {
@@ -550,11 +830,21 @@ size_t zcbor_remaining_str_len(zcbor_state_t *state)
 }
 
 
-int zcbor_entry_function_with_elem_states(const uint8_t *payload, size_t payload_len,
-	void *result, size_t *payload_len_out, zcbor_state_t *states, zcbor_decoder_t func,
-	size_t n_states, size_t elem_count, size_t n_elem_states)
+/** Initialize @p states for use in an entry function.
+ *
+ *  @return ZCBOR_SUCCESS, or an error code if the states cannot be initialized.
+ */
+static int entry_state_init(const uint8_t *payload, size_t payload_len, zcbor_state_t *states,
+	size_t n_states, size_t elem_count, size_t n_elem_states, bool trust_input)
 {
-	ZCBOR_CHECK_NULL(states);
+	if (trust_input) {
+		/* Only reject payloads that can't be decoded at all. This doesn't bound the reads of
+		 * headers and strings, which are not checked in trusted mode. */
+		if ((payload == NULL) || (payload_len == 0)
+				|| ((uintptr_t)payload + payload_len < (uintptr_t)payload)) {
+			return ZCBOR_ERR_NO_PAYLOAD;
+		}
+	}
 
 	uint8_t *flags = NULL;
 	size_t n_elem_state_bytes = 0;
@@ -579,24 +869,259 @@ int zcbor_entry_function_with_elem_states(const uint8_t *payload, size_t payload
 			n_elem_state_bytes);
 
 	states[0].constant_state->manually_process_elem = true;
+#ifdef ZCBOR_TRUSTED_INPUT
+	states[0].constant_state->trust_input = trust_input;
+#endif
+	return ZCBOR_SUCCESS;
+}
 
-	bool ret = func(&states[0], result);
 
-	if (!ret) {
-		int err = zcbor_pop_error(&states[0]);
+static int entry_function_error(zcbor_state_t *state)
+{
+	int err = zcbor_pop_error(state);
 
-		err = (err == ZCBOR_SUCCESS) ? ZCBOR_ERR_UNKNOWN : err;
-		return err;
+	return (err == ZCBOR_SUCCESS) ? ZCBOR_ERR_UNKNOWN : err;
+}
+
+
+/** Call @p func on the initialized @p states, and populate @p payload_len_out. */
+static int entry_function_call(void *result, size_t *payload_len_out, zcbor_state_t *states,
+	zcbor_decoder_t func)
+{
+	if (!func(&states[0], result)) {
+		return entry_function_error(&states[0]);
 	}
 
 	if (payload_len_out != NULL) {
-		*payload_len_out = MIN(payload_len,
-				(size_t)states[0].payload - (size_t)payload);
+		/* A chunk callback might have moved the decoding to a new payload section. */
+		const uint8_t *section = states[0].constant_state->curr_payload_section;
+
+		*payload_len_out = MIN((size_t)states[0].payload_end - (size_t)section,
+				(size_t)states[0].payload - (size_t)section);
 	}
 	return ZCBOR_SUCCESS;
 }
 
 
+static int entry_function(const uint8_t *payload, size_t payload_len,
+	void *result, size_t *payload_len_out, zcbor_state_t *states, zcbor_decoder_t func,
+	size_t n_states, size_t elem_count, size_t n_elem_states, bool trust_input)
+{
+	ZCBOR_CHECK_NULL(states);
+
+	int err = entry_state_init(payload, payload_len, states, n_states, elem_count,
+				n_elem_states, trust_input);
+
+	if (err != ZCBOR_SUCCESS) {
+		return err;
+	}
+
+	return entry_function_call(result, payload_len_out, states, func);
+}
+
+
+int zcbor_entry_function_with_elem_states(const uint8_t *payload, size_t payload_len,
+	void *result, size_t *payload_len_out, zcbor_state_t *states, zcbor_decoder_t func,
+	size_t n_states, size_t elem_count, size_t n_elem_states)
+{
+	return entry_function(payload, payload_len, result, payload_len_out, states, func,
+			n_states, elem_count, n_elem_states, false);
+}
+
+
+#ifdef ZCBOR_TRUSTED_INPUT
+int zcbor_trusted_entry_function_with_elem_states(const uint8_t *payload, size_t payload_len,
+	void *result, size_t *payload_len_out, zcbor_state_t *states, zcbor_decoder_t func,
+	size_t n_states, size_t elem_count, size_t n_elem_states)
+{
+	return entry_function(payload, payload_len, result, payload_len_out, states, func,
+			n_states, elem_count, n_elem_states, true);
+}
+#endif
+
+
+#ifdef ZCBOR_BSTR_STREAM
+int zcbor_stream_entry_function_with_elem_states(const uint8_t *payload, size_t payload_len,
+	void *result, size_t *payload_len_out, zcbor_chunk_cb_t chunk_cb, void *chunk_ctx,
+	zcbor_state_t *states, zcbor_decoder_t func,
+	size_t n_states, size_t elem_count, size_t n_elem_states)
+{
+	ZCBOR_CHECK_NULL(states);
+
+	struct zcbor_chunk_handler chunk_handler = {.cb = chunk_cb, .ctx = chunk_ctx};
+	int err = entry_state_init(payload, payload_len, states, n_states, elem_count,
+				n_elem_states, false);
+
+	if (err != ZCBOR_SUCCESS) {
+		return err;
+	}
+
+	if (chunk_cb != NULL) {
+		states[0].decode_state.chunk_handler = &chunk_handler;
+	}
+
+	return entry_function_call(result, payload_len_out, states, func);
+}
+#endif
+
+
+int zcbor_view_entry_function_with_elem_states(const uint8_t *payload, size_t payload_len,
+	const struct zcbor_view_pos *pos, void *result, zcbor_state_t *states,
+	zcbor_decoder_t func, size_t n_states, size_t n_elem_states)
+{
+	if ((pos == NULL) || (payload == NULL) || (pos->offset > payload_len)) {
+		return ZCBOR_ERR_NO_PAYLOAD;
+	}
+
+	return entry_function(payload + pos->offset, payload_len - pos->offset, result, NULL,
+			states, func, n_states, pos->elem_count, n_elem_states, false);
+}
+
+
+#ifdef ZCBOR_ARENA
+int zcbor_arena_entry_function_with_elem_states(const uint8_t *payload, size_t payload_len,
+	void *result, size_t *payload_len_out, struct zcbor_arena *arena,
+	zcbor_state_t *states, zcbor_decoder_t func,
+	size_t n_states, size_t elem_count, size_t n_elem_states)
+{
+	ZCBOR_CHECK_NULL(states);
+
+	int err = entry_state_init(payload, payload_len, states, n_states, elem_count,
+				n_elem_states, false);
+
+	if (err != ZCBOR_SUCCESS) {
+		return err;
+	}
+
+	states[0].decode_state.arena = arena;
+
+	return entry_function_call(result, payload_len_out, states, func);
+}
+
+
+static void arena_init(struct zcbor_arena *arena, void *buf, size_t size, bool count_only)
+{
+	size_t misalignment = (size_t)buf % ZCBOR_ARENA_ALIGN;
+	size_t adjustment = misalignment ? (ZCBOR_ARENA_ALIGN - misalignment) : 0;
+
+	adjustment = MIN(adjustment, size);
+	arena->buf = (uint8_t *)buf + adjustment;
+	/* Keep the end aligned too, since elements are placed downwards from there. */
+	arena->size = (size - adjustment) & ~(size_t)(ZCBOR_ARENA_ALIGN - 1);
+	arena->used = 0;
+	arena->scratch = 0;
+	arena->peak = 0;
+	arena->count_only = count_only;
+}
+
+
+void zcbor_arena_init(struct zcbor_arena *arena, void *buf, size_t size)
+{
+	arena_init(arena, buf, size, false);
+}
+
+
+void zcbor_arena_count_init(struct zcbor_arena *arena, void *buf, size_t size)
+{
+	arena_init(arena, buf, size, true);
+}
+#endif
+
+
+bool zcbor_string_off_set(struct zcbor_string_off *result, const uint8_t *base,
+		const struct zcbor_string *str)
+{
+	if ((str->value < base) || ((size_t)(str->value - base) > UINT32_MAX)
+			|| (str->len > UINT32_MAX)) {
+		return false;
+	}
+
+	result->offset = (uint32_t)(str->value - base);
+	result->len = (uint32_t)str->len;
+	return true;
+}
+
+
+#ifdef ZCBOR_STRING_OFFSETS
+int zcbor_string_base_entry_function_with_elem_states(const uint8_t *payload,
+	size_t payload_len, void *result, size_t *payload_len_out, const uint8_t *string_base,
+	zcbor_state_t *states, zcbor_decoder_t func,
+	size_t n_states, size_t elem_count, size_t n_elem_states)
+{
+	ZCBOR_CHECK_NULL(states);
+
+	int err = entry_state_init(payload, payload_len, states, n_states, elem_count,
+				n_elem_states, false);
+
+	if (err != ZCBOR_SUCCESS) {
+		return err;
+	}
+
+	states[0].string_base = string_base;
+
+	return entry_function_call(result, payload_len_out, states, func);
+}
+#endif
+
+
+static int entry_function_seq(const uint8_t *payload, size_t payload_len,
+	void *results, size_t result_size, size_t max_results, size_t *num_results,
+	size_t *payload_len_out, zcbor_state_t *states, zcbor_decoder_t func,
+	size_t n_states, size_t n_elem_states, bool encode)
+{
+	ZCBOR_CHECK_NULL(states);
+
+	size_t i = 0;
+	size_t consumed = 0;
+	int err = entry_state_init(payload, payload_len, states, n_states, ZCBOR_LARGE_ELEM_COUNT,
+				n_elem_states, false);
+
+	if (err == ZCBOR_SUCCESS) {
+		/* After each successful item, all backups have been consumed, so the state is
+		 * ready for the next item once elem_count has been reset.
+		 * When encoding, all results are encoded, so running out of payload is an error,
+		 * while decoding stops at the end of the payload. */
+		for (; (i < max_results) && (encode || !zcbor_payload_at_end(&states[0])); i++) {
+			states[0].elem_count = ZCBOR_LARGE_ELEM_COUNT;
+
+			if (!func(&states[0], (uint8_t *)results + (i * result_size))) {
+				err = entry_function_error(&states[0]);
+				break;
+			}
+			consumed = (size_t)states[0].payload - (size_t)payload;
+		}
+	}
+
+	if (num_results != NULL) {
+		*num_results = i;
+	}
+	if (payload_len_out != NULL) {
+		*payload_len_out = MIN(payload_len, consumed);
+	}
+	return err;
+}
+
+
+int zcbor_entry_function_seq_with_elem_states(const uint8_t *payload, size_t payload_len,
+	void *results, size_t result_size, size_t max_results, size_t *num_results,
+	size_t *payload_len_out, zcbor_state_t *states, zcbor_decoder_t func,
+	size_t n_states, size_t n_elem_states)
+{
+	return entry_function_seq(payload, payload_len, results, result_size, max_results,
+			num_results, payload_len_out, states, func, n_states, n_elem_states, false);
+}
+
+
+int zcbor_entry_function_seq_encode_with_elem_states(uint8_t *payload, size_t payload_len,
+	const void *results, size_t result_size, size_t num_inputs, size_t *num_results,
+	size_t *payload_len_out, zcbor_state_t *states, zcbor_decoder_t func,
+	size_t n_states, size_t n_elem_states)
+{
+	return entry_function_seq(payload, payload_len, (void *)results, result_size, num_inputs,
+			num_results, payload_len_out, states, func, n_states, n_elem_states, true);
+}
+
+
 /* Float16: */
 #define F16_SIGN_OFFS 15 /* Bit offset of the sign bit. */
 #define F16_EXPO_OFFS 10 /* Bit offset of the exponent. */
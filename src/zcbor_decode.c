@@ -13,6 +13,10 @@
 #include "zcbor_common.h"
 #include "zcbor_print.h"
 
+#ifndef ZCBOR_INLINE
+#include "zcbor_decode_inline.h"
+#endif
+
 
 /** Return value length from additional value.
  */
@@ -112,6 +116,14 @@ do { \
 	ZCBOR_FAIL(); \
 } while(0)
 
+#ifdef ZCBOR_HASH_REGION
+/* Pass the bytes consumed so far to the active hash region, if any.
+ * Called after each string and skipped value, and at the start and end of each list/map. */
+#define HASH_REGION_FLUSH() zcbor_hash_region_flush(state)
+#else
+#define HASH_REGION_FLUSH()
+#endif
+
 
 static void endian_copy(uint8_t *dst, const uint8_t *src, size_t src_len)
 {
@@ -133,10 +145,11 @@ static void endian_copy(uint8_t *dst, const uint8_t *src, size_t src_len)
  *          have arbitrary length within 1-8 bytes.
  *
  *          The function will also validate
- *           - That @p state->payload doesn't overrun past @p state->payload_end.
+ *           - That @p state->payload doesn't overrun past @p state->payload_end
+ *             (unless trust_input is enabled).
  *           - That @p state->elem_count has not been exhausted.
  *           - That the value is encoded in a canonical way (if enforce_canonical
- *             is enabled).
+ *             is enabled and trust_input is not).
  *
  *          @p state->payload and @p state->elem_count are updated if the function
  *          succeeds. If not, they are left unchanged. @p state->payload is updated
@@ -164,6 +177,9 @@ static bool value_extract(zcbor_state_t *state,
 	zcbor_trace(state, "value_extract");
 
 	INITIAL_CHECKS();
+#ifdef ZCBOR_WORK_BUDGET
+	ZCBOR_FAIL_IF(!zcbor_work_spend(state, 1));
+#endif
 	ZCBOR_ERR_IF((state->elem_count == 0), ZCBOR_ERR_LOW_ELEM_COUNT);
 
 	zcbor_assert_state(result_len != 0, "0-length result not supported.\r\n");
@@ -176,7 +192,7 @@ static bool value_extract(zcbor_state_t *state,
 
 	if ((additional == ZCBOR_VALUE_IS_INDEFINITE_LENGTH) && (indefinite_length_array != NULL)) {
 		/* Indefinite length is not allowed in canonical CBOR */
-		ZCBOR_ERR_IF(ZCBOR_ENFORCE_CANONICAL(state),
+		ZCBOR_ERR_IF(ZCBOR_ENFORCE_CANONICAL(state) && !ZCBOR_TRUST_INPUT(state),
 			ZCBOR_ERR_INVALID_VALUE_ENCODING);
 
 		*indefinite_length_array = true;
@@ -186,7 +202,7 @@ static bool value_extract(zcbor_state_t *state,
 
 		ZCBOR_ERR_IF(additional > ZCBOR_VALUE_IS_8_BYTES, ZCBOR_ERR_ADDITIONAL_INVAL);
 		ZCBOR_ERR_IF(len > result_len, ZCBOR_ERR_INT_SIZE);
-		ZCBOR_ERR_IF((state->payload + len + 1) > state->payload_end,
+		ZCBOR_ERR_IF(((state->payload + len + 1) > state->payload_end),
 			ZCBOR_ERR_NO_PAYLOAD);
 
 		memset(result, 0, result_len);
@@ -197,8 +213,10 @@ static bool value_extract(zcbor_state_t *state,
 			endian_copy(result_offs, state->payload + 1, len);
 
 			/* Check whether value could have been encoded shorter.
-			   Only check when enforcing canonical CBOR, and never check floats. */
-			if (ZCBOR_ENFORCE_CANONICAL(state) && !ZCBOR_IS_FLOAT(header_byte)) {
+			   Only check when enforcing canonical CBOR on untrusted input,
+			   and never check floats. */
+			if (ZCBOR_ENFORCE_CANONICAL(state) && !ZCBOR_TRUST_INPUT(state)
+					&& !ZCBOR_IS_FLOAT(header_byte)) {
 				ZCBOR_ERR_IF((zcbor_header_len_ptr(result, result_len) != (len + 1)),
 					ZCBOR_ERR_INVALID_VALUE_ENCODING);
 			}
@@ -261,34 +279,6 @@ bool zcbor_int_decode(zcbor_state_t *state, void *result, size_t result_size)
 }
 
 
-bool zcbor_int8_decode(zcbor_state_t *state, int8_t *result)
-{
-	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_int_decode(state, result, sizeof(*result));
-}
-
-
-bool zcbor_int16_decode(zcbor_state_t *state, int16_t *result)
-{
-	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_int_decode(state, result, sizeof(*result));
-}
-
-
-bool zcbor_int32_decode(zcbor_state_t *state, int32_t *result)
-{
-	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_int_decode(state, result, sizeof(*result));
-}
-
-
-bool zcbor_int64_decode(zcbor_state_t *state, int64_t *result)
-{
-	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_int_decode(state, result, sizeof(*result));
-}
-
-
 bool zcbor_uint_decode(zcbor_state_t *state, void *result, size_t result_size)
 {
 	ZCBOR_PRINT_FUNC_NAME();
@@ -302,34 +292,6 @@ bool zcbor_uint_decode(zcbor_state_t *state, void *result, size_t result_size)
 }
 
 
-bool zcbor_uint8_decode(zcbor_state_t *state, uint8_t *result)
-{
-	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_uint_decode(state, result, sizeof(*result));
-}
-
-
-bool zcbor_uint16_decode(zcbor_state_t *state, uint16_t *result)
-{
-	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_uint_decode(state, result, sizeof(*result));
-}
-
-
-bool zcbor_uint32_decode(zcbor_state_t *state, uint32_t *result)
-{
-	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_uint_decode(state, result, sizeof(*result));
-}
-
-
-bool zcbor_uint64_decode(zcbor_state_t *state, uint64_t *result)
-{
-	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_uint_decode(state, result, sizeof(*result));
-}
-
-
 bool zcbor_int8_expect_union(zcbor_state_t *state, int8_t result)
 {
 	ZCBOR_PRINT_FUNC_NAME();
@@ -410,48 +372,6 @@ bool zcbor_uint64_expect_union(zcbor_state_t *state, uint64_t result)
 }
 
 
-bool zcbor_int8_expect(zcbor_state_t *state, int8_t expected)
-{
-	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_int64_expect(state, expected);
-}
-
-
-bool zcbor_int8_pexpect(zcbor_state_t *state, int8_t *expected)
-{
-	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_int64_expect(state, *expected);
-}
-
-
-bool zcbor_int16_expect(zcbor_state_t *state, int16_t expected)
-{
-	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_int64_expect(state, expected);
-}
-
-
-bool zcbor_int16_pexpect(zcbor_state_t *state, int16_t *expected)
-{
-	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_int64_expect(state, *expected);
-}
-
-
-bool zcbor_int32_expect(zcbor_state_t *state, int32_t expected)
-{
-	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_int64_expect(state, expected);
-}
-
-
-bool zcbor_int32_pexpect(zcbor_state_t *state, int32_t *expected)
-{
-	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_int32_expect(state, *expected);
-}
-
-
 bool zcbor_int64_expect(zcbor_state_t *state, int64_t expected)
 {
 	ZCBOR_PRINT_FUNC_NAME_ARGS("(%" PRIi64 ")", expected);
@@ -469,61 +389,6 @@ bool zcbor_int64_expect(zcbor_state_t *state, int64_t expected)
 }
 
 
-bool zcbor_int64_pexpect(zcbor_state_t *state, int64_t *expected)
-{
-	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_int64_expect(state, *expected);
-}
-
-
-#ifdef ZCBOR_SUPPORTS_SIZE_T
-bool zcbor_size_decode(zcbor_state_t *state, size_t *result)
-{
-	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_uint_decode(state, result, sizeof(*result));
-}
-#endif
-
-
-bool zcbor_uint8_expect(zcbor_state_t *state, uint8_t expected)
-{
-	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_uint64_expect(state, expected);
-}
-
-bool zcbor_uint8_pexpect(zcbor_state_t *state, uint8_t *expected)
-{
-	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_uint64_expect(state, *expected);
-}
-
-bool zcbor_uint16_expect(zcbor_state_t *state, uint16_t expected)
-{
-	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_uint64_expect(state, expected);
-}
-
-bool zcbor_uint16_pexpect(zcbor_state_t *state, uint16_t *expected)
-{
-	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_uint64_expect(state, *expected);
-}
-
-
-bool zcbor_uint32_expect(zcbor_state_t *state, uint32_t expected)
-{
-	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_uint64_expect(state, expected);
-}
-
-
-bool zcbor_uint32_pexpect(zcbor_state_t *state, uint32_t *expected)
-{
-	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_uint32_expect(state, *expected);
-}
-
-
 bool zcbor_uint64_expect(zcbor_state_t *state, uint64_t expected)
 {
 	ZCBOR_PRINT_FUNC_NAME_ARGS("(%" PRIu64 ")", expected);
@@ -540,29 +405,6 @@ bool zcbor_uint64_expect(zcbor_state_t *state, uint64_t expected)
 }
 
 
-bool zcbor_uint64_pexpect(zcbor_state_t *state, uint64_t *expected)
-{
-	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_uint64_expect(state, *expected);
-}
-
-
-#ifdef ZCBOR_SUPPORTS_SIZE_T
-bool zcbor_size_expect(zcbor_state_t *state, size_t expected)
-{
-	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_uint64_expect(state, expected);
-}
-
-
-bool zcbor_size_pexpect(zcbor_state_t *state, size_t *expected)
-{
-	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_size_expect(state, *expected);
-}
-#endif
-
-
 static bool str_start_decode(zcbor_state_t *state,
 		struct zcbor_string *result, zcbor_major_type_t exp_major_type)
 {
@@ -711,6 +553,10 @@ static bool start_decode_fragments(zcbor_state_t *state,
 		state->frag_offset = new_offset;
 		state->str_total_len = string_hdr.len;
 		state->inside_frag_str = true;
+#ifdef ZCBOR_VALIDATE_UTF8
+		state->frag_str_utf8 = (exp_major_type == ZCBOR_MAJOR_TYPE_TSTR);
+		state->frag_utf8 = (struct zcbor_utf8_state){0};
+#endif
 	}
 
 	return true;
@@ -750,7 +596,18 @@ bool zcbor_str_fragment_decode(zcbor_state_t *state, struct zcbor_string_fragmen
 
 	if (state->inside_frag_str) {
 		len = MIN((size_t)state->payload_end - (size_t)state->payload, remainder);
+#ifdef ZCBOR_VALIDATE_UTF8
+		if (state->frag_str_utf8) {
+			/* Validate a copy, so a failed fragment can be retried. */
+			struct zcbor_utf8_state utf8 = state->frag_utf8;
+
+			ZCBOR_ERR_IF(!zcbor_validate_utf8_partial(&utf8, state->payload, len),
+				ZCBOR_ERR_INVALID_UTF8);
+			state->frag_utf8 = utf8;
+		}
+#endif
 		state->payload += len;
+		HASH_REGION_FLUSH();
 		fragment->total_len = state->str_total_len;
 		fragment->offset = offset;
 
@@ -779,6 +636,11 @@ bool zcbor_str_fragments_end_decode(zcbor_state_t *state)
 	ZCBOR_ERR_IF(remainder != 0, ZCBOR_ERR_NOT_AT_END);
 
 	if (state->inside_frag_str) {
+#ifdef ZCBOR_VALIDATE_UTF8
+		/* The string must not end in the middle of a character. */
+		ZCBOR_ERR_IF(state->frag_str_utf8 && (state->frag_utf8.num_cont != 0),
+			ZCBOR_ERR_INVALID_UTF8);
+#endif
 		state->inside_frag_str = false;
 	} else {
 		if (!zcbor_bstr_end_decode(state)) {
@@ -793,18 +655,42 @@ bool zcbor_str_fragments_end_decode(zcbor_state_t *state)
 #endif /* ZCBOR_FRAGMENTS */
 
 
-static bool str_decode(zcbor_state_t *state, struct zcbor_string *result,
+static bool indefinite_str_decode(zcbor_state_t *state, struct zcbor_string *result,
+		zcbor_major_type_t exp_major_type);
+
+/** Decode a definite length string. */
+static bool definite_str_decode(zcbor_state_t *state, struct zcbor_string *result,
 		zcbor_major_type_t exp_major_type)
 {
 	if (!str_start_decode_with_overflow_check(state, result, exp_major_type)) {
 		ZCBOR_FAIL();
 	}
 
+#ifdef ZCBOR_VALIDATE_UTF8
+	if ((exp_major_type == ZCBOR_MAJOR_TYPE_TSTR)
+			&& !zcbor_validate_utf8(result->value, result->len)) {
+		ERR_RESTORE(ZCBOR_ERR_INVALID_UTF8);
+	}
+#endif
+
 	state->payload += result->len;
+	HASH_REGION_FLUSH();
 	return true;
 }
 
 
+/** Decode a string, which may have an indefinite length, see @ref indefinite_str_decode. */
+static bool str_decode(zcbor_state_t *state, struct zcbor_string *result,
+		zcbor_major_type_t exp_major_type)
+{
+	if ((state != NULL) && (state->payload < state->payload_end)
+			&& (*state->payload == ((exp_major_type << 5) | ZCBOR_VALUE_IS_INDEFINITE_LENGTH))) {
+		return indefinite_str_decode(state, result, exp_major_type);
+	}
+	return definite_str_decode(state, result, exp_major_type);
+}
+
+
 static bool str_expect(zcbor_state_t *state, struct zcbor_string *result,
 		zcbor_major_type_t exp_major_type)
 {
@@ -827,6 +713,49 @@ bool zcbor_bstr_decode(zcbor_state_t *state, struct zcbor_string *result)
 }
 
 
+#ifdef ZCBOR_BSTR_STREAM
+bool zcbor_bstr_stream_decode(zcbor_state_t *state, struct zcbor_string *result)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	ZCBOR_CHECK_NULL(state);
+
+	const struct zcbor_chunk_handler *handler = state->decode_state.chunk_handler;
+
+	if ((handler == NULL) || (handler->cb == NULL)) {
+		return str_decode(state, result, ZCBOR_MAJOR_TYPE_BSTR);
+	}
+
+	struct zcbor_string_fragment chunk = {.offset = 0};
+
+	if (!str_start_decode(state, &chunk.fragment, ZCBOR_MAJOR_TYPE_BSTR)) {
+		ZCBOR_FAIL();
+	}
+
+	chunk.total_len = chunk.fragment.len;
+
+	do {
+		chunk.fragment.value = state->payload;
+		chunk.fragment.len = MIN((size_t)state->payload_end - (size_t)state->payload,
+					chunk.total_len - chunk.offset);
+		state->payload += chunk.fragment.len;
+		HASH_REGION_FLUSH();
+
+		if (!handler->cb(handler->ctx, state, &chunk)) {
+			ZCBOR_FAIL();
+		}
+
+		chunk.offset += chunk.fragment.len;
+		ZCBOR_ERR_IF((chunk.offset < chunk.total_len)
+			&& (state->payload >= state->payload_end), ZCBOR_ERR_NO_PAYLOAD);
+	} while (chunk.offset < chunk.total_len);
+
+	result->value = NULL;
+	result->len = chunk.total_len;
+	return true;
+}
+#endif
+
+
 bool zcbor_bstr_expect(zcbor_state_t *state, struct zcbor_string *expected)
 {
 	ZCBOR_PRINT_FUNC_NAME();
@@ -841,6 +770,38 @@ bool zcbor_tstr_decode(zcbor_state_t *state, struct zcbor_string *result)
 }
 
 
+#ifdef ZCBOR_STRING_OFFSETS
+static bool str_off_decode(zcbor_state_t *state, struct zcbor_string_off *result,
+		zcbor_major_type_t exp_major_type)
+{
+	struct zcbor_string str;
+
+	if (!str_decode(state, &str, exp_major_type)) {
+		ZCBOR_FAIL();
+	}
+
+	if (!zcbor_string_off_set(result, state->string_base, &str)) {
+		ERR_RESTORE(ZCBOR_ERR_INT_SIZE);
+	}
+	return true;
+}
+
+
+bool zcbor_bstr_off_decode(zcbor_state_t *state, struct zcbor_string_off *result)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	return str_off_decode(state, result, ZCBOR_MAJOR_TYPE_BSTR);
+}
+
+
+bool zcbor_tstr_off_decode(zcbor_state_t *state, struct zcbor_string_off *result)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	return str_off_decode(state, result, ZCBOR_MAJOR_TYPE_TSTR);
+}
+#endif
+
+
 bool zcbor_tstr_expect(zcbor_state_t *state, struct zcbor_string *expected)
 {
 	ZCBOR_PRINT_FUNC_NAME();
@@ -848,35 +809,303 @@ bool zcbor_tstr_expect(zcbor_state_t *state, struct zcbor_string *expected)
 }
 
 
-bool zcbor_bstr_expect_ptr(zcbor_state_t *state, char const *ptr, size_t len)
+bool zcbor_bstr_expect_term(zcbor_state_t *state, char const *string, size_t maxlen)
 {
 	ZCBOR_PRINT_FUNC_NAME();
-	struct zcbor_string zs = { .value = (const uint8_t *)ptr, .len = len };
+	return zcbor_bstr_expect_ptr(state, string, strnlen(string, maxlen));
+}
+
+
+bool zcbor_tstr_expect_term(zcbor_state_t *state, char const *string, size_t maxlen)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	return zcbor_tstr_expect_ptr(state, string, strnlen(string, maxlen));
+}
+
+
+static bool str_expect_encoded(zcbor_state_t *state, struct zcbor_string *encoded,
+		zcbor_major_type_t exp_major_type)
+{
+	INITIAL_CHECKS_WITH_TYPE(exp_major_type);
+	ZCBOR_ERR_IF((state->elem_count == 0), ZCBOR_ERR_LOW_ELEM_COUNT);
+	zcbor_assert_state(encoded->len != 0, "Encoded string must include the header.\r\n");
+
+	const uint8_t header_byte = *state->payload;
+
+	if (header_byte == encoded->value[0]) {
+		/* Same header byte, so any difference in length or contents is a mismatch. */
+		ZCBOR_ERR_IF(((size_t)(state->payload_end - state->payload) < encoded->len)
+			|| (memcmp(state->payload, encoded->value, encoded->len) != 0),
+			ZCBOR_ERR_WRONG_VALUE);
+
+		state->payload_bak = state->payload;
+		state->payload += encoded->len;
+		state->elem_count--;
+		HASH_REGION_FLUSH();
+		return true;
+	}
+
+	const uint8_t additional = ZCBOR_ADDITIONAL(header_byte);
+	const uint8_t exp_additional = ZCBOR_ADDITIONAL(encoded->value[0]);
+
+	/* A different header byte can only be a match if the payload uses a longer
+	 * header than necessary. */
+	ZCBOR_ERR_IF(ZCBOR_ENFORCE_CANONICAL(state) || (additional <= ZCBOR_VALUE_IN_HEADER)
+		|| (additional <= exp_additional), ZCBOR_ERR_WRONG_VALUE);
 
-	return zcbor_bstr_expect(state, &zs);
+	size_t header_len = 1 + additional_len(exp_additional);
+	struct zcbor_string expected = {
+		.value = encoded->value + header_len,
+		.len = encoded->len - header_len,
+	};
+
+	return str_expect(state, &expected, exp_major_type);
 }
 
 
-bool zcbor_tstr_expect_ptr(zcbor_state_t *state, char const *ptr, size_t len)
+bool zcbor_bstr_expect_encoded(zcbor_state_t *state, struct zcbor_string *encoded)
 {
 	ZCBOR_PRINT_FUNC_NAME();
-	struct zcbor_string zs = { .value = (const uint8_t *)ptr, .len = len };
+	return str_expect_encoded(state, encoded, ZCBOR_MAJOR_TYPE_BSTR);
+}
 
-	return zcbor_tstr_expect(state, &zs);
+
+bool zcbor_tstr_expect_encoded(zcbor_state_t *state, struct zcbor_string *encoded)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	return str_expect_encoded(state, encoded, ZCBOR_MAJOR_TYPE_TSTR);
 }
 
 
-bool zcbor_bstr_expect_term(zcbor_state_t *state, char const *string, size_t maxlen)
+static bool str_chunks_start_decode(zcbor_state_t *state,
+		struct zcbor_str_chunk_iter *iter, zcbor_major_type_t exp_major_type)
+{
+	INITIAL_CHECKS_WITH_TYPE(exp_major_type);
+
+	iter->major_type = exp_major_type;
+	iter->indefinite = false;
+	iter->done = false;
+
+	if (ZCBOR_ADDITIONAL(*state->payload) == ZCBOR_VALUE_IS_INDEFINITE_LENGTH) {
+		size_t dummy;
+
+		if (!value_extract(state, &dummy, sizeof(dummy), &iter->indefinite)) {
+			ZCBOR_FAIL();
+		}
+	} else if (!definite_str_decode(state, &iter->definite, exp_major_type)) {
+		ZCBOR_FAIL();
+	}
+	return true;
+}
+
+
+bool zcbor_bstr_chunks_start_decode(zcbor_state_t *state, struct zcbor_str_chunk_iter *iter)
 {
 	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_bstr_expect_ptr(state, string, strnlen(string, maxlen));
+	return str_chunks_start_decode(state, iter, ZCBOR_MAJOR_TYPE_BSTR);
 }
 
 
-bool zcbor_tstr_expect_term(zcbor_state_t *state, char const *string, size_t maxlen)
-{
-	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_tstr_expect_ptr(state, string, strnlen(string, maxlen));
+bool zcbor_tstr_chunks_start_decode(zcbor_state_t *state, struct zcbor_str_chunk_iter *iter)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	return str_chunks_start_decode(state, iter, ZCBOR_MAJOR_TYPE_TSTR);
+}
+
+
+bool zcbor_str_chunks_at_end(const zcbor_state_t *state, const struct zcbor_str_chunk_iter *iter)
+{
+	if (!iter->indefinite) {
+		return iter->done;
+	}
+	return (state->payload < state->payload_end) && (*state->payload == 0xFF);
+}
+
+
+bool zcbor_str_chunk_decode(zcbor_state_t *state, struct zcbor_str_chunk_iter *iter,
+		struct zcbor_string *chunk)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	ZCBOR_CHECK_NULL(state);
+
+	if (!iter->indefinite) {
+		ZCBOR_ERR_IF(iter->done, ZCBOR_ERR_LOW_ELEM_COUNT);
+		*chunk = iter->definite;
+		iter->done = true;
+		return true;
+	}
+
+	/* The chunks are part of a single element, so they are not counted. */
+	state->elem_count++;
+
+	if (!definite_str_decode(state, chunk, iter->major_type)) {
+		state->elem_count--;
+		ZCBOR_FAIL();
+	}
+	return true;
+}
+
+
+bool zcbor_str_chunks_end_decode(zcbor_state_t *state, struct zcbor_str_chunk_iter *iter)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	ZCBOR_CHECK_NULL(state);
+	ZCBOR_ERR_IF(!zcbor_str_chunks_at_end(state, iter), ZCBOR_ERR_NOT_AT_END);
+
+	if (iter->indefinite) {
+		state->payload++; /* Consume the break marker. */
+		iter->indefinite = false;
+		iter->done = true;
+	}
+	return true;
+}
+
+
+static bool str_coalesce_decode(zcbor_state_t *state, uint8_t *buf, size_t buf_len,
+		struct zcbor_string *result, zcbor_major_type_t exp_major_type)
+{
+	struct zcbor_str_chunk_iter iter;
+	struct zcbor_string chunk;
+	zcbor_state_t state_copy;
+	size_t len = 0;
+
+	ZCBOR_CHECK_NULL(state);
+	memcpy(&state_copy, state, sizeof(zcbor_state_t));
+
+	if (!str_chunks_start_decode(&state_copy, &iter, exp_major_type)) {
+		ZCBOR_FAIL();
+	}
+
+	while (!zcbor_str_chunks_at_end(&state_copy, &iter)) {
+		if (!zcbor_str_chunk_decode(&state_copy, &iter, &chunk)) {
+			ZCBOR_FAIL();
+		}
+		ZCBOR_ERR_IF(chunk.len > (buf_len - len), ZCBOR_ERR_TOO_LARGE_FOR_STRING);
+		memcpy(&buf[len], chunk.value, chunk.len);
+		len += chunk.len;
+	}
+
+	if (!zcbor_str_chunks_end_decode(&state_copy, &iter)) {
+		ZCBOR_FAIL();
+	}
+
+	state->payload_bak = state->payload;
+	state->payload = state_copy.payload;
+	state->elem_count = state_copy.elem_count;
+	result->value = buf;
+	result->len = len;
+	return true;
+}
+
+
+bool zcbor_bstr_coalesce_decode(zcbor_state_t *state, uint8_t *buf, size_t buf_len,
+		struct zcbor_string *result)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	return str_coalesce_decode(state, buf, buf_len, result, ZCBOR_MAJOR_TYPE_BSTR);
+}
+
+
+bool zcbor_tstr_coalesce_decode(zcbor_state_t *state, uint8_t *buf, size_t buf_len,
+		struct zcbor_string *result)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	return str_coalesce_decode(state, buf, buf_len, result, ZCBOR_MAJOR_TYPE_TSTR);
+}
+
+
+#ifdef ZCBOR_ARENA
+#define ARENA_ROUND_UP(len) (((len) + (ZCBOR_ARENA_ALIGN - 1)) & ~(size_t)(ZCBOR_ARENA_ALIGN - 1))
+
+/** Check that @p used bytes at the start and @p scratch bytes at the end of the arena fit,
+ *  and record the total in arena->peak. */
+static bool arena_reserve(zcbor_state_t *state, struct zcbor_arena *arena, size_t used,
+		size_t scratch)
+{
+	/* In a counting pass, only the scratch bytes are actually stored. */
+	size_t stored = arena->count_only ? 0 : used;
+
+	if ((scratch > arena->size) || (stored > (arena->size - scratch))) {
+		zcbor_log("Arena too small: %zu + %zu > %zu.\r\n", stored, scratch, arena->size);
+		ZCBOR_ERR(ZCBOR_ERR_NO_ARENA_MEM);
+	}
+	arena->peak = MAX(arena->peak, used + scratch);
+	return true;
+}
+
+
+#endif
+
+/** Decode an indefinite length string as if it had a definite length.
+ *
+ * If the string has at most one non-empty chunk, @p result points to it in the payload.
+ * Otherwise, the chunks are coalesced into the state's arena, or decoding fails with
+ * ZCBOR_ERR_NO_ARENA_MEM if there is no arena.
+ */
+static bool indefinite_str_decode(zcbor_state_t *state, struct zcbor_string *result,
+		zcbor_major_type_t exp_major_type)
+{
+	struct zcbor_str_chunk_iter iter;
+	struct zcbor_string chunk;
+	struct zcbor_string str;
+	zcbor_state_t state_copy;
+	size_t num_chunks = 0; /* The number of non-empty chunks. */
+
+	memcpy(&state_copy, state, sizeof(zcbor_state_t));
+
+	if (!str_chunks_start_decode(&state_copy, &iter, exp_major_type)) {
+		ZCBOR_FAIL();
+	}
+
+	str.value = state_copy.payload;
+	str.len = 0;
+
+	while (!zcbor_str_chunks_at_end(&state_copy, &iter)) {
+		if (!zcbor_str_chunk_decode(&state_copy, &iter, &chunk)) {
+			ZCBOR_FAIL();
+		}
+		if (chunk.len > 0) {
+			str.value = chunk.value;
+			num_chunks++;
+		}
+		str.len += chunk.len;
+	}
+
+	if (!zcbor_str_chunks_end_decode(&state_copy, &iter)) {
+		ZCBOR_FAIL();
+	}
+
+	if (num_chunks > 1) {
+#ifdef ZCBOR_ARENA
+		struct zcbor_arena *arena = state->decode_state.arena;
+
+		ZCBOR_ERR_IF(arena == NULL, ZCBOR_ERR_NO_ARENA_MEM);
+
+		size_t alloc_len = ARENA_ROUND_UP(str.len);
+
+		if (!arena_reserve(state, arena, arena->used + alloc_len, arena->scratch)) {
+			ZCBOR_FAIL();
+		}
+		if (arena->count_only) {
+			str.value = NULL;
+		} else if (!str_coalesce_decode(state, &arena->buf[arena->used], str.len, &str,
+				exp_major_type)) {
+			ZCBOR_FAIL();
+		}
+		arena->used += alloc_len;
+#else
+		ZCBOR_ERR(ZCBOR_ERR_NO_ARENA_MEM);
+#endif
+	}
+
+	state->payload_bak = state->payload;
+	state->payload = state_copy.payload;
+	state->elem_count = state_copy.elem_count;
+#ifdef ZCBOR_WORK_BUDGET
+	state->decode_state.work_budget = state_copy.decode_state.work_budget;
+#endif
+	*result = str;
+	return true;
 }
 
 
@@ -899,6 +1128,7 @@ static bool list_map_start_decode(zcbor_state_t *state,
 	state->decode_state.map_start_backup_num = state->constant_state->current_backup;
 
 	state->decode_state.indefinite_length_array = indefinite_length_array;
+	HASH_REGION_FLUSH();
 
 	ZCBOR_FAIL_IF(!exit_map(state)); // Exit the enclosing map if any
 
@@ -1025,23 +1255,83 @@ static bool manipulate_flags(zcbor_state_t *state, uint32_t mode)
 
 	ZCBOR_ERR_IF((index >= state->decode_state.map_elem_count),
 		ZCBOR_ERR_MAP_FLAGS_NOT_AVAILABLE);
-	uint8_t *flag_byte = &state->decode_state.map_search_elem_state[index >> 3];
-	uint8_t flag_mask = (uint8_t)(1 << (index & 7));
+	ZCBOR_STATS_ADD(map_flag_ops, 1);
+	uint8_t *flags = state->decode_state.map_search_elem_state;
+	size_t word_idx = index / ZCBOR_BITS_PER_FLAG_WORD;
+	zcbor_flag_word_t flag_word = zcbor_flag_word_get(flags, word_idx);
+	zcbor_flag_word_t flag_mask = (zcbor_flag_word_t)1 << (index % ZCBOR_BITS_PER_FLAG_WORD);
 
 	switch(mode) {
 	case FLAG_MODE_GET_CURRENT:
-		return (!!(*flag_byte & flag_mask));
+		return (!!(flag_word & flag_mask));
 	case FLAG_MODE_CLEAR_CURRENT:
-		*flag_byte &= ~flag_mask;
+		zcbor_flag_word_set(flags, word_idx, flag_word & (zcbor_flag_word_t)~flag_mask);
 		return true;
 	case FLAG_MODE_CLEAR_UNUSED:
-		*flag_byte &= (uint8_t)((flag_mask << 1) - 1);
+		zcbor_flag_word_set(flags, word_idx,
+			flag_word & (zcbor_flag_word_t)((flag_mask << 1) - 1));
 		return true;
 	}
 	return false;
 }
 
 
+#ifdef __GNUC__
+_Static_assert((sizeof(zcbor_flag_word_t) == sizeof(unsigned int)),
+	"flag_word_ctz() uses __builtin_ctz(), which takes an unsigned int.");
+#endif
+
+/** Return the index of the lowest set bit in @p word, which must be nonzero. */
+static size_t flag_word_ctz(zcbor_flag_word_t word)
+{
+#ifdef __GNUC__
+	return (size_t)__builtin_ctz(word);
+#else
+	size_t ret = 0;
+
+	while (!(word & 1)) {
+		word >>= 1;
+		ret++;
+	}
+	return ret;
+#endif
+}
+
+
+/** Return the index of the first unprocessed element at or after @p index.
+ *
+ *  Scans whole flag words at a time. Returns map_elem_count if all elements from
+ *  @p index to the end of the map have been processed.
+ */
+static size_t next_unprocessed_index(zcbor_state_t *state, size_t index)
+{
+	const uint8_t *flags = state->decode_state.map_search_elem_state;
+	const size_t map_elem_count = state->decode_state.map_elem_count;
+	const size_t num_words = zcbor_flags_to_words(map_elem_count);
+	size_t word_idx = index / ZCBOR_BITS_PER_FLAG_WORD;
+
+	if (index >= map_elem_count) {
+		return map_elem_count;
+	}
+
+	/* Mask away the flags before index in the first word. */
+	zcbor_flag_word_t word = zcbor_flag_word_get(flags, word_idx)
+		& (zcbor_flag_word_t)~(((zcbor_flag_word_t)1 << (index % ZCBOR_BITS_PER_FLAG_WORD)) - 1);
+
+	ZCBOR_STATS_ADD(map_flag_ops, 1);
+
+	while (word == 0) {
+		if (++word_idx >= num_words) {
+			return map_elem_count;
+		}
+		word = zcbor_flag_word_get(flags, word_idx);
+		ZCBOR_STATS_ADD(map_flag_ops, 1);
+	}
+
+	return MIN(map_elem_count, word_idx * ZCBOR_BITS_PER_FLAG_WORD + flag_word_ctz(word));
+}
+
+
 static bool should_try_key(zcbor_state_t *state)
 {
 	return manipulate_flags(state, FLAG_MODE_GET_CURRENT);
@@ -1060,21 +1350,24 @@ bool zcbor_elem_processed(zcbor_state_t *state)
 
 static bool allocate_map_flags(zcbor_state_t *state, size_t old_flags)
 {
-	size_t new_bytes = zcbor_flags_to_bytes(state->decode_state.map_elem_count);
-	size_t old_bytes = zcbor_flags_to_bytes(old_flags);
-	size_t extra_bytes = new_bytes - old_bytes;
+	size_t new_words = zcbor_flags_to_words(state->decode_state.map_elem_count);
+	size_t old_words = zcbor_flags_to_words(old_flags);
 
 	ZCBOR_ERR_IF(!state->constant_state, ZCBOR_ERR_CONSTANT_STATE_MISSING);
 	const uint8_t *flags_end = state->constant_state->map_search_elem_state_end;
 
-	if (extra_bytes) {
-		if ((state->decode_state.map_search_elem_state + new_bytes) > flags_end) {
-			state->decode_state.map_elem_count
-				= 8 * (size_t)(flags_end - state->decode_state.map_search_elem_state);
+	if (new_words > old_words) {
+		size_t words_avail = (size_t)(flags_end - state->decode_state.map_search_elem_state)
+					/ sizeof(zcbor_flag_word_t);
+		uint8_t *flags = state->decode_state.map_search_elem_state;
+
+		if (new_words > words_avail) {
+			state->decode_state.map_elem_count = ZCBOR_BITS_PER_FLAG_WORD * words_avail;
 			ZCBOR_ERR(ZCBOR_ERR_MAP_FLAGS_NOT_AVAILABLE);
 		}
 
-		memset(&state->decode_state.map_search_elem_state[new_bytes - extra_bytes], 0xFF, extra_bytes);
+		memset(&flags[old_words * sizeof(zcbor_flag_word_t)], 0xFF,
+			(new_words - old_words) * sizeof(zcbor_flag_word_t));
 	}
 	return true;
 }
@@ -1132,6 +1425,55 @@ static bool try_key(zcbor_state_t *state, void *key_result, zcbor_decoder_t key_
 }
 
 
+#ifdef ZCBOR_MAP_SMART_SEARCH
+/** Return the index of the map element that would be current at @p elem_count. */
+static size_t get_current_index_from(zcbor_state_t *state, size_t elem_count)
+{
+	return (zcbor_current_max_elem_count(state) - elem_count) / 2;
+}
+
+
+/** Skip from a processed element to the next unprocessed element.
+ *
+ *  The flags are scanned a word at a time to find the next candidate, so processed elements
+ *  are skipped without testing their flags one by one. If there are no unprocessed elements
+ *  before the end of the map, jump directly back to the start of the map, without skipping
+ *  through the rest of the map.
+ *
+ *  Only valid when the number of elements in the map is known, i.e. when not counting_map_elems.
+ *
+ *  @param[in] start_elem_count  The elem_count when the search started. Fails with
+ *                               ZCBOR_ERR_ELEM_NOT_FOUND instead of skipping past it.
+ */
+static bool skip_processed_elems(zcbor_state_t *state, size_t start_elem_count)
+{
+	size_t index = get_current_index(state, 0);
+	size_t start_index = get_current_index_from(state, start_elem_count);
+	size_t next = next_unprocessed_index(state, index + 1);
+
+	if ((index < start_index) && (next >= start_index)) {
+		/* All elements have been checked since the search started. */
+		ZCBOR_ERR(ZCBOR_ERR_ELEM_NOT_FOUND);
+	}
+
+	if (next >= state->decode_state.map_elem_count) {
+		zcbor_log("No unprocessed elements after index %zu.\n", index);
+		return map_restart(state);
+	}
+
+	zcbor_log("Skipping elements at index %zu-%zu.\n", index, next - 1);
+
+	for (size_t i = index; i < next; i++) {
+		/* Skip over both the key and the value. */
+		if (!zcbor_any_skip(state, NULL) || !zcbor_any_skip(state, NULL)) {
+			ZCBOR_FAIL();
+		}
+	}
+	return true;
+}
+#endif
+
+
 bool zcbor_unordered_map_search(zcbor_decoder_t key_decoder, zcbor_state_t *state, void *key_result)
 {
 	ZCBOR_PRINT_FUNC_NAME();
@@ -1162,6 +1504,8 @@ bool zcbor_unordered_map_search(zcbor_decoder_t key_decoder, zcbor_state_t *stat
 			(void)old_flags;
 		}
 
+		ZCBOR_STATS_ADD(map_search_iterations, 1);
+
 		if (should_try_key(state)) {
 			if (try_key(state, key_result, key_decoder)) {
 				if (!ZCBOR_MANUALLY_PROCESS_ELEM(state)) {
@@ -1170,6 +1514,14 @@ bool zcbor_unordered_map_search(zcbor_decoder_t key_decoder, zcbor_state_t *stat
 				return true;
 			}
 		} else {
+#ifdef ZCBOR_MAP_SMART_SEARCH
+			if (!state->decode_state.counting_map_elems) {
+				if (!skip_processed_elems(state, elem_count)) {
+					goto error;
+				}
+				continue;
+			}
+#endif
 			zcbor_log("Skipping element at index %zu.\n", get_current_index(state, 0));
 		}
 
@@ -1249,6 +1601,7 @@ static bool list_map_end_decode(zcbor_state_t *state)
 		}
 	}
 
+	HASH_REGION_FLUSH();
 	return true;
 }
 
@@ -1282,19 +1635,18 @@ bool zcbor_unordered_map_end_decode(zcbor_state_t *state)
 #ifdef ZCBOR_MAP_SMART_SEARCH
 		manipulate_flags(state, FLAG_MODE_CLEAR_UNUSED);
 
-		for (size_t i = 0; i < zcbor_flags_to_bytes(state->decode_state.map_elem_count); i++) {
-			if (state->decode_state.map_search_elem_state[i] != 0) {
-				zcbor_log("unprocessed element(s) in map: [%zu] = 0x%02x\n",
-						i, state->decode_state.map_search_elem_state[i]);
-				ZCBOR_ERR(ZCBOR_ERR_ELEMS_NOT_PROCESSED);
-			}
+		size_t index = next_unprocessed_index(state, 0);
+
+		if (index < state->decode_state.map_elem_count) {
+			zcbor_log("unprocessed element(s) in map, first at index %zu\n", index);
+			ZCBOR_ERR(ZCBOR_ERR_ELEMS_NOT_PROCESSED);
 		}
 #else
 		ZCBOR_ERR_IF(should_try_key(state), ZCBOR_ERR_ELEMS_NOT_PROCESSED);
 #endif
 	}
 	while (!zcbor_array_at_end(state)) {
-		zcbor_any_skip(state, NULL);
+		ZCBOR_FAIL_IF(!zcbor_any_skip(state, NULL));
 	}
 	return zcbor_map_end_decode(state);
 }
@@ -1446,13 +1798,6 @@ bool zcbor_float16_bytes_expect(zcbor_state_t *state, uint16_t expected)
 }
 
 
-bool zcbor_float16_bytes_pexpect(zcbor_state_t *state, uint16_t *expected)
-{
-	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_float16_bytes_expect(state, *expected);
-}
-
-
 bool zcbor_float16_decode(zcbor_state_t *state, float *result)
 {
 	ZCBOR_PRINT_FUNC_NAME();
@@ -1482,13 +1827,6 @@ bool zcbor_float16_expect(zcbor_state_t *state, float expected)
 }
 
 
-bool zcbor_float16_pexpect(zcbor_state_t *state, float *expected)
-{
-	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_float16_expect(state, *expected);
-}
-
-
 bool zcbor_float32_decode(zcbor_state_t *state, float *result)
 {
 	ZCBOR_PRINT_FUNC_NAME();
@@ -1517,13 +1855,6 @@ bool zcbor_float32_expect(zcbor_state_t *state, float expected)
 }
 
 
-bool zcbor_float32_pexpect(zcbor_state_t *state, float *expected)
-{
-	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_float32_expect(state, *expected);
-}
-
-
 bool zcbor_float16_32_decode(zcbor_state_t *state, float *result)
 {
 	ZCBOR_PRINT_FUNC_NAME();
@@ -1550,13 +1881,6 @@ bool zcbor_float16_32_expect(zcbor_state_t *state, float expected)
 }
 
 
-bool zcbor_float16_32_pexpect(zcbor_state_t *state, float *expected)
-{
-	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_float16_32_expect(state, *expected);
-}
-
-
 bool zcbor_float64_decode(zcbor_state_t *state, double *result)
 {
 	ZCBOR_PRINT_FUNC_NAME();
@@ -1585,13 +1909,6 @@ bool zcbor_float64_expect(zcbor_state_t *state, double expected)
 }
 
 
-bool zcbor_float64_pexpect(zcbor_state_t *state, double *expected)
-{
-	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_float64_expect(state, *expected);
-}
-
-
 bool zcbor_float32_64_decode(zcbor_state_t *state, double *result)
 {
 	ZCBOR_PRINT_FUNC_NAME();
@@ -1620,13 +1937,6 @@ bool zcbor_float32_64_expect(zcbor_state_t *state, double expected)
 }
 
 
-bool zcbor_float32_64_pexpect(zcbor_state_t *state, double *expected)
-{
-	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_float32_64_expect(state, *expected);
-}
-
-
 bool zcbor_float_decode(zcbor_state_t *state, double *result)
 {
 	ZCBOR_PRINT_FUNC_NAME();
@@ -1659,13 +1969,6 @@ bool zcbor_float_expect(zcbor_state_t *state, double expected)
 }
 
 
-bool zcbor_float_pexpect(zcbor_state_t *state, double *expected)
-{
-	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_float_expect(state, *expected);
-}
-
-
 bool zcbor_any_skip(zcbor_state_t *state, void *result)
 {
 	ZCBOR_PRINT_FUNC_NAME();
@@ -1692,7 +1995,9 @@ bool zcbor_any_skip(zcbor_state_t *state, void *result)
 
 	bool indefinite_length_array = false;
 	bool *ila_ptr = ((major_type == ZCBOR_MAJOR_TYPE_MAP)
-			|| (major_type == ZCBOR_MAJOR_TYPE_LIST)) ? &indefinite_length_array : NULL;
+			|| (major_type == ZCBOR_MAJOR_TYPE_LIST)
+			|| (major_type == ZCBOR_MAJOR_TYPE_BSTR)
+			|| (major_type == ZCBOR_MAJOR_TYPE_TSTR)) ? &indefinite_length_array : NULL;
 
 	if (!value_extract(&state_copy, &value, sizeof(value), ila_ptr)) {
 		/* Can happen because of elem_count (or payload_end) */
@@ -1702,9 +2007,24 @@ bool zcbor_any_skip(zcbor_state_t *state, void *result)
 	switch (major_type) {
 		case ZCBOR_MAJOR_TYPE_BSTR:
 		case ZCBOR_MAJOR_TYPE_TSTR:
+			if (indefinite_length_array) {
+				struct zcbor_str_chunk_iter iter = {
+					.major_type = major_type, .indefinite = true};
+				struct zcbor_string chunk;
+
+				while (!zcbor_str_chunks_at_end(&state_copy, &iter)) {
+					if (!zcbor_str_chunk_decode(&state_copy, &iter, &chunk)) {
+						ZCBOR_FAIL();
+					}
+				}
+				ZCBOR_FAIL_IF(!zcbor_str_chunks_end_decode(&state_copy, &iter));
+				ZCBOR_STATS_ADD(skip_bytes, state_copy.payload - state->payload);
+				break;
+			}
 			/* 'value' is the length of the BSTR or TSTR. */
 			ZCBOR_FAIL_IF(!str_overflow_check(state, (size_t)value));
 			(state_copy.payload) += value;
+			ZCBOR_STATS_ADD(skip_bytes, state_copy.payload - state->payload);
 			break;
 		case ZCBOR_MAJOR_TYPE_MAP:
 			ZCBOR_ERR_IF(value > (SIZE_MAX / 2), ZCBOR_ERR_INT_SIZE);
@@ -1716,23 +2036,80 @@ bool zcbor_any_skip(zcbor_state_t *state, void *result)
 			}
 			state_copy.elem_count = (size_t)value;
 			state_copy.decode_state.indefinite_length_array = indefinite_length_array;
+			/* Only count the header here, the elements are counted by the recursive calls. */
+			ZCBOR_STATS_ADD(skip_bytes, state_copy.payload - state->payload);
 			while (!zcbor_array_at_end(&state_copy)) {
 				if (!zcbor_any_skip(&state_copy, NULL)) {
 					ZCBOR_FAIL();
 				}
 			}
-			if (indefinite_length_array && !array_end_expect(&state_copy)) {
-				ZCBOR_FAIL();
+			if (indefinite_length_array) {
+				if (!array_end_expect(&state_copy)) {
+					ZCBOR_FAIL();
+				}
+				ZCBOR_STATS_ADD(skip_bytes, 1);
 			}
 			break;
 		default:
-			/* Do nothing */
+			ZCBOR_STATS_ADD(skip_bytes, state_copy.payload - state->payload);
 			break;
 	}
 
+	ZCBOR_STATS_ADD(skip_calls, 1);
+
 	state->payload = state_copy.payload;
 	state->elem_count--;
+#ifdef ZCBOR_WORK_BUDGET
+	state->decode_state.work_budget = state_copy.decode_state.work_budget;
+#endif
+	HASH_REGION_FLUSH();
+
+	return true;
+}
+
+
+bool zcbor_raw_decode(zcbor_state_t *state, struct zcbor_string *result)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	ZCBOR_CHECK_NULL(state);
+	const uint8_t *start = state->payload;
+
+	if (!zcbor_any_skip(state, NULL)) {
+		ZCBOR_FAIL();
+	}
+	result->value = start;
+	result->len = (size_t)(state->payload - start);
+	return true;
+}
+
+
+bool zcbor_index_items(zcbor_state_t *state, size_t *offsets, size_t max_items,
+		size_t *num_items)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	const uint8_t *start = state->payload;
+	size_t i = 0;
+
+	offsets[0] = 0;
+
+	for (; (i < max_items) && !zcbor_array_at_end(state)
+			&& (state->payload < state->payload_end); i++) {
+		if (!zcbor_any_skip(state, NULL)) {
+			*num_items = i;
+			ZCBOR_FAIL();
+		}
+		offsets[i + 1] = (size_t)(state->payload - start);
+	}
+	*num_items = i;
+	return true;
+}
 
+
+bool zcbor_view_pos_record(zcbor_state_t *state, const uint8_t *start,
+		struct zcbor_view_pos *pos)
+{
+	pos->offset = (size_t)(state->payload - start);
+	pos->elem_count = state->elem_count;
 	return true;
 }
 
@@ -1765,10 +2142,40 @@ bool zcbor_tag_expect(zcbor_state_t *state, uint32_t expected)
 }
 
 
-bool zcbor_tag_pexpect(zcbor_state_t *state, uint32_t *expected)
+/** Call @p decoder once. If it fails, restore the payload and elem_count (or the backup).
+ *
+ *  @param[out] decoded  Whether @p decoder succeeded.
+ *
+ *  @retval false  If the backup could not be created or processed.
+ */
+static bool multi_decode_elem(zcbor_decoder_t decoder, zcbor_state_t *state, void *result,
+		bool backup, bool *decoded)
 {
-	ZCBOR_PRINT_FUNC_NAME();
-	return zcbor_tag_expect(state, *expected);
+	uint8_t const *payload_bak;
+	size_t elem_count_bak;
+
+	if (backup) {
+		if (!zcbor_new_backup_w_elem_state(state, state->elem_count, true)) {
+			ZCBOR_FAIL();
+		}
+	} else {
+		payload_bak = state->payload;
+		elem_count_bak = state->elem_count;
+	}
+
+	*decoded = decoder(state, result);
+
+	if (backup) {
+		if (!zcbor_process_backup(state, *decoded ? ZCBOR_FLAG_CONSUME
+					: (ZCBOR_FLAG_CONSUME | ZCBOR_FLAG_RESTORE),
+				ZCBOR_MAX_ELEM_COUNT)) {
+			ZCBOR_FAIL();
+		}
+	} else if (!*decoded) {
+		state->payload = payload_bak;
+		state->elem_count = elem_count_bak;
+	}
+	return true;
 }
 
 
@@ -1786,42 +2193,19 @@ static bool multi_decode_backup(size_t min_decode,
 	ZCBOR_CHECK_ERROR();
 
 	for (size_t i = 0; i < max_decode; i++) {
-		uint8_t const *payload_bak;
-		size_t elem_count_bak;
+		bool decoded;
 
-		if (backup) {
-			if (!zcbor_new_backup_w_elem_state(state, state->elem_count, true)) {
-				ZCBOR_FAIL();
-			}
-		} else {
-			payload_bak = state->payload;
-			elem_count_bak = state->elem_count;
+		if (!multi_decode_elem(decoder, state, (uint8_t *)result + i*result_len, backup,
+				&decoded)) {
+			ZCBOR_FAIL();
 		}
 
-		if (!decoder(state, (uint8_t *)result + i*result_len)) {
+		if (!decoded) {
 			*num_decode = i;
-
-			if (backup) {
-				if (!zcbor_process_backup(state,
-						ZCBOR_FLAG_CONSUME | ZCBOR_FLAG_RESTORE,
-						ZCBOR_MAX_ELEM_COUNT)) {
-					ZCBOR_FAIL();
-				}
-			} else {
-				state->payload = payload_bak;
-				state->elem_count = elem_count_bak;
-			}
-
 			zcbor_log("Found %zu elements.\r\n", i);
 			ZCBOR_ERR_IF(i < min_decode, ZCBOR_ERR_ITERATIONS);
 			return true;
 		}
-
-		if (backup) {
-			if (!zcbor_process_backup(state, ZCBOR_FLAG_CONSUME, ZCBOR_MAX_ELEM_COUNT)) {
-				ZCBOR_FAIL();
-			}
-		}
 	}
 	zcbor_log("Found %zu elements.\r\n", max_decode);
 	*num_decode = max_decode;
@@ -1854,6 +2238,117 @@ bool zcbor_multi_decode_w_backup(size_t min_decode,
 }
 
 
+#ifdef ZCBOR_ARENA
+static bool multi_decode_arena(size_t min_decode,
+		size_t max_decode,
+		size_t *num_decode,
+		zcbor_decoder_t decoder,
+		zcbor_state_t *state,
+		void *result,
+		size_t result_len,
+		bool backup)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	ZCBOR_CHECK_NULL(state);
+	ZCBOR_CHECK_ERROR();
+
+	struct zcbor_arena *arena = state->decode_state.arena;
+
+	ZCBOR_ERR_IF(arena == NULL, ZCBOR_ERR_NO_ARENA_MEM);
+
+	size_t slot_len = ARENA_ROUND_UP(result_len);
+	size_t used_start = arena->used;
+	size_t scratch_start = arena->scratch;
+	size_t i = 0;
+	bool ok = true;
+
+	/* Decode each element into its own slot, placed downwards from the end of the buffer. */
+	for (; i < max_decode; i++) {
+		size_t used_bak = arena->used;
+		bool decoded;
+
+		ok = arena_reserve(state, arena, arena->used, arena->scratch + slot_len);
+		if (!ok) {
+			break;
+		}
+		arena->scratch += slot_len;
+
+		ok = multi_decode_elem(decoder, state, &arena->buf[arena->size - arena->scratch],
+				backup, &decoded);
+		if (!ok || !decoded) {
+			/* Drop the element, and the nested arrays that were placed while decoding it. */
+			arena->scratch -= slot_len;
+			arena->used = used_bak;
+			/* Running out of arena must not look like the end of the repetition. */
+			ok = ok && (zcbor_peek_error(state) != ZCBOR_ERR_NO_ARENA_MEM);
+			break;
+		}
+	}
+
+	arena->scratch = scratch_start;
+	zcbor_log("Found %zu elements.\r\n", i);
+
+	if (ok && (i < min_decode)) {
+		zcbor_error(state, ZCBOR_ERR_ITERATIONS);
+		ok = false;
+	}
+
+	/* Move the elements to the start of the buffer. The destination must not overlap the
+	 * slots, since they are in reverse order. */
+	size_t array_len = ARENA_ROUND_UP(i * result_len);
+	uint8_t *array = NULL;
+
+	ok = ok && ((i == 0) || arena_reserve(state, arena, arena->used + array_len,
+				scratch_start + (i * slot_len)));
+
+	if (!ok) {
+		arena->used = used_start;
+		ZCBOR_FAIL();
+	}
+
+	if ((i > 0) && !arena->count_only) {
+		array = &arena->buf[arena->used];
+
+		for (size_t j = 0; j < i; j++) {
+			memcpy(&array[j * result_len],
+				&arena->buf[arena->size - scratch_start - ((j + 1) * slot_len)],
+				result_len);
+		}
+	}
+	arena->used += array_len;
+	*num_decode = i;
+	memcpy(result, &array, sizeof(array));
+	return true;
+}
+
+
+bool zcbor_multi_decode_arena(size_t min_decode,
+		size_t max_decode,
+		size_t *num_decode,
+		zcbor_decoder_t decoder,
+		zcbor_state_t *state,
+		void *result,
+		size_t result_len)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	return multi_decode_arena(min_decode, max_decode, num_decode, decoder, state, result, result_len, false);
+}
+
+
+bool zcbor_multi_decode_arena_w_backup(size_t min_decode,
+		size_t max_decode,
+		size_t *num_decode,
+		zcbor_decoder_t decoder,
+		zcbor_state_t *state,
+		void *result,
+		size_t result_len)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	return multi_decode_arena(min_decode, max_decode, num_decode, decoder, state, result, result_len, true);
+}
+#endif
+
+
 bool zcbor_present_decode(bool *present,
 		zcbor_decoder_t decoder,
 		zcbor_state_t *state,
@@ -1885,6 +2380,49 @@ bool zcbor_present_decode_w_backup(bool *present,
 }
 
 
+bool zcbor_multi_decode_soa(size_t min_decode,
+		size_t max_decode,
+		size_t *num_decode,
+		zcbor_soa_decoder_t decoder,
+		zcbor_state_t *state,
+		void *result)
+{
+	ZCBOR_PRINT_FUNC_NAME();
+	ZCBOR_CHECK_NULL(state);
+	ZCBOR_CHECK_ERROR();
+
+	for (size_t i = 0; i < max_decode; i++) {
+		uint8_t const *payload_bak = state->payload;
+		size_t elem_count_bak = state->elem_count;
+
+		if (!decoder(state, result, i)) {
+			state->payload = payload_bak;
+			state->elem_count = elem_count_bak;
+			*num_decode = i;
+			zcbor_log("Found %zu elements.\r\n", i);
+			ZCBOR_ERR_IF(i < min_decode, ZCBOR_ERR_ITERATIONS);
+			return true;
+		}
+	}
+	zcbor_log("Found %zu elements.\r\n", max_decode);
+	*num_decode = max_decode;
+	return true;
+}
+
+
+bool zcbor_soa_present_set(uint8_t *bitmap, size_t index, bool present)
+{
+	uint8_t mask = (uint8_t)(1 << (index % 8));
+
+	if (present) {
+		bitmap[index / 8] |= mask;
+	} else {
+		bitmap[index / 8] &= (uint8_t)~mask;
+	}
+	return true;
+}
+
+
 void zcbor_new_decode_state(zcbor_state_t *state_array, size_t n_states,
 		const uint8_t *payload, size_t payload_len, size_t elem_count,
 		uint8_t *flags, size_t flags_bytes)
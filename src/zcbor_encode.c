@@ -12,6 +12,10 @@
 #include "zcbor_common.h"
 #include "zcbor_print.h"
 
+#ifndef ZCBOR_INLINE
+#include "zcbor_encode_inline.h"
+#endif
+
 _Static_assert((sizeof(size_t) == sizeof(void *)),
 	"This code needs size_t to be the same length as pointers.");
 
@@ -153,98 +157,6 @@ bool zcbor_uint_encode(zcbor_state_t *state, const void *input_uint, size_t uint
 	return true;
 }
 
-bool zcbor_int8_encode(zcbor_state_t *state, const int8_t *input)
-{
-	return zcbor_int_encode(state, input, sizeof(*input));
-}
-
-bool zcbor_int16_encode(zcbor_state_t *state, const int16_t *input)
-{
-	return zcbor_int_encode(state, input, sizeof(*input));
-}
-
-bool zcbor_int32_encode(zcbor_state_t *state, const int32_t *input)
-{
-	return zcbor_int_encode(state, input, sizeof(*input));
-}
-
-bool zcbor_int64_encode(zcbor_state_t *state, const int64_t *input)
-{
-	return zcbor_int_encode(state, input, sizeof(*input));
-}
-
-bool zcbor_uint8_encode(zcbor_state_t *state, const uint8_t *input)
-{
-	return zcbor_uint_encode(state, input, sizeof(*input));
-}
-
-bool zcbor_uint16_encode(zcbor_state_t *state, const uint16_t *input)
-{
-	return zcbor_uint_encode(state, input, sizeof(*input));
-}
-
-bool zcbor_uint32_encode(zcbor_state_t *state, const uint32_t *input)
-{
-	return zcbor_uint_encode(state, input, sizeof(*input));
-}
-
-bool zcbor_uint64_encode(zcbor_state_t *state, const uint64_t *input)
-{
-	return zcbor_uint_encode(state, input, sizeof(*input));
-}
-
-bool zcbor_int8_put(zcbor_state_t *state, int8_t input)
-{
-	return zcbor_int_encode(state, &input, sizeof(input));
-}
-
-bool zcbor_int16_put(zcbor_state_t *state, int16_t input)
-{
-	return zcbor_int_encode(state, &input, sizeof(input));
-}
-
-bool zcbor_int32_put(zcbor_state_t *state, int32_t input)
-{
-	return zcbor_int_encode(state, &input, sizeof(input));
-}
-
-bool zcbor_int64_put(zcbor_state_t *state, int64_t input)
-{
-	return zcbor_int_encode(state, &input, sizeof(input));
-}
-
-bool zcbor_uint8_put(zcbor_state_t *state, uint8_t input)
-{
-	return zcbor_uint_encode(state, &input, sizeof(input));
-}
-
-bool zcbor_uint16_put(zcbor_state_t *state, uint16_t input)
-{
-	return zcbor_uint_encode(state, &input, sizeof(input));
-}
-
-bool zcbor_uint32_put(zcbor_state_t *state, uint32_t input)
-{
-	return zcbor_uint_encode(state, &input, sizeof(input));
-}
-
-bool zcbor_uint64_put(zcbor_state_t *state, uint64_t input)
-{
-	return zcbor_uint_encode(state, &input, sizeof(input));
-}
-
-#ifdef ZCBOR_SUPPORTS_SIZE_T
-bool zcbor_size_put(zcbor_state_t *state, size_t input)
-{
-	return zcbor_uint_encode(state, &input, sizeof(input));
-}
-
-
-bool zcbor_size_encode(zcbor_state_t *state, const size_t *input)
-{
-	return zcbor_uint_encode(state, input, sizeof(*input));
-}
-#endif
 
 static bool str_start_encode(zcbor_state_t *state,
 		const struct zcbor_string *input, zcbor_major_type_t major_type)
@@ -343,20 +255,22 @@ bool zcbor_tstr_encode(zcbor_state_t *state, const struct zcbor_string *input)
 }
 
 
-bool zcbor_bstr_encode_ptr(zcbor_state_t *state, const char *str, size_t len)
+#ifdef ZCBOR_STRING_OFFSETS
+bool zcbor_bstr_off_encode(zcbor_state_t *state, const struct zcbor_string_off *input)
 {
-	const struct zcbor_string zs = { .value = (const uint8_t *)str, .len = len };
+	const struct zcbor_string str = zcbor_string_off_get(state->string_base, input);
 
-	return zcbor_bstr_encode(state, &zs);
+	return str_encode(state, &str, ZCBOR_MAJOR_TYPE_BSTR);
 }
 
 
-bool zcbor_tstr_encode_ptr(zcbor_state_t *state, const char *str, size_t len)
+bool zcbor_tstr_off_encode(zcbor_state_t *state, const struct zcbor_string_off *input)
 {
-	const struct zcbor_string zs = { .value = (const uint8_t *)str, .len = len };
+	const struct zcbor_string str = zcbor_string_off_get(state->string_base, input);
 
-	return zcbor_tstr_encode(state, &zs);
+	return str_encode(state, &str, ZCBOR_MAJOR_TYPE_TSTR);
 }
+#endif
 
 
 bool zcbor_bstr_put_term(zcbor_state_t *state, char const *str, size_t maxlen)
@@ -371,6 +285,57 @@ bool zcbor_tstr_put_term(zcbor_state_t *state, char const *str, size_t maxlen)
 }
 
 
+static bool str_chunks_start_encode(zcbor_state_t *state, zcbor_major_type_t major_type)
+{
+	if (!encode_header_byte(state, major_type, ZCBOR_VALUE_IS_INDEFINITE_LENGTH)) {
+		ZCBOR_FAIL();
+	}
+	state->elem_count++;
+	return true;
+}
+
+
+bool zcbor_bstr_chunks_start_encode(zcbor_state_t *state)
+{
+	return str_chunks_start_encode(state, ZCBOR_MAJOR_TYPE_BSTR);
+}
+
+
+bool zcbor_tstr_chunks_start_encode(zcbor_state_t *state)
+{
+	return str_chunks_start_encode(state, ZCBOR_MAJOR_TYPE_TSTR);
+}
+
+
+static bool str_chunk_encode(zcbor_state_t *state,
+		const struct zcbor_string *chunk, zcbor_major_type_t major_type)
+{
+	if (!str_encode(state, chunk, major_type)) {
+		ZCBOR_FAIL();
+	}
+	state->elem_count--; /* The chunks are part of a single element. */
+	return true;
+}
+
+
+bool zcbor_bstr_chunk_encode(zcbor_state_t *state, const struct zcbor_string *chunk)
+{
+	return str_chunk_encode(state, chunk, ZCBOR_MAJOR_TYPE_BSTR);
+}
+
+
+bool zcbor_tstr_chunk_encode(zcbor_state_t *state, const struct zcbor_string *chunk)
+{
+	return str_chunk_encode(state, chunk, ZCBOR_MAJOR_TYPE_TSTR);
+}
+
+
+bool zcbor_str_chunks_end_encode(zcbor_state_t *state)
+{
+	return encode_header_byte(state, ZCBOR_MAJOR_TYPE_SIMPLE, ZCBOR_VALUE_IS_INDEFINITE_LENGTH);
+}
+
+
 #ifdef ZCBOR_FRAGMENTS
 
 static bool start_encode_fragments(zcbor_state_t *state,
@@ -570,6 +535,8 @@ static bool list_map_end_encode(zcbor_state_t *state, size_t size_hint,
 			ZCBOR_ERR(ZCBOR_ERR_NO_PAYLOAD);
 		}
 		memmove(new_body_start, old_body_start, body_size);
+		ZCBOR_STATS_ADD(canonical_memmoves, 1);
+		ZCBOR_STATS_ADD(canonical_bytes_moved, body_size);
 	}
 
 	/* Reencode header of list with the actual number of elements. */
@@ -617,6 +584,50 @@ bool zcbor_list_map_end_force_encode(zcbor_state_t *state)
 }
 
 
+bool zcbor_list_chunks_encode(zcbor_state_t *state, size_t num_elems,
+		const struct zcbor_string *chunks, size_t num_chunks)
+{
+	size_t total_len = 0;
+
+	ZCBOR_CHECK_PAYLOAD();
+
+	for (size_t i = 0; i < num_chunks; i++) {
+		ZCBOR_ERR_IF(chunks[i].len > (SIZE_MAX - total_len), ZCBOR_ERR_INT_SIZE);
+		total_len += chunks[i].len;
+	}
+
+	/* Check the space for the contents up front, so nothing is written on failure. */
+	if ((total_len + zcbor_header_len(num_elems))
+			> (size_t)(state->payload_end - state->payload)) {
+		ZCBOR_ERR(ZCBOR_ERR_NO_PAYLOAD);
+	}
+
+	if (!value_encode(state, ZCBOR_MAJOR_TYPE_LIST, &num_elems, sizeof(num_elems))) {
+		ZCBOR_FAIL();
+	}
+
+	for (size_t i = 0; i < num_chunks; i++) {
+		memcpy(state->payload_mut, chunks[i].value, chunks[i].len);
+		state->payload += chunks[i].len;
+	}
+	return true;
+}
+
+
+bool zcbor_raw_put(zcbor_state_t *state, const void *raw, size_t len)
+{
+	ZCBOR_CHECK_PAYLOAD(); /* To make the size_t cast below safe. */
+
+	if (len > (size_t)(state->payload_end - state->payload)) {
+		ZCBOR_ERR(ZCBOR_ERR_NO_PAYLOAD);
+	}
+	memmove(state->payload_mut, raw, len);
+	state->payload += len;
+	state->elem_count++;
+	return true;
+}
+
+
 bool zcbor_simple_encode(zcbor_state_t *state, uint8_t *input)
 {
 	/* Simple values 24 to 31 inclusive are unused. Ref: RFC8949 sec 3.3 */
@@ -674,12 +685,6 @@ bool zcbor_float64_encode(zcbor_state_t *state, const double *input)
 }
 
 
-bool zcbor_float64_put(zcbor_state_t *state, double input)
-{
-	return zcbor_float64_encode(state, &input);
-}
-
-
 bool zcbor_float32_encode(zcbor_state_t *state, const float *input)
 {
 	if (!value_encode_len(state, ZCBOR_MAJOR_TYPE_SIMPLE, input,
@@ -691,24 +696,6 @@ bool zcbor_float32_encode(zcbor_state_t *state, const float *input)
 }
 
 
-bool zcbor_float32_put(zcbor_state_t *state, float input)
-{
-	return zcbor_float32_encode(state, &input);
-}
-
-
-bool zcbor_float16_encode(zcbor_state_t *state, const float *input)
-{
-	return zcbor_float16_put(state, *input);
-}
-
-
-bool zcbor_float16_put(zcbor_state_t *state, float input)
-{
-	return zcbor_float16_bytes_put(state, zcbor_float32_to_16(input));
-}
-
-
 bool zcbor_float16_bytes_encode(zcbor_state_t *state, const uint16_t *input)
 {
 	if (!value_encode_len(state, ZCBOR_MAJOR_TYPE_SIMPLE, input,
@@ -720,12 +707,6 @@ bool zcbor_float16_bytes_encode(zcbor_state_t *state, const uint16_t *input)
 }
 
 
-bool zcbor_float16_bytes_put(zcbor_state_t *state, uint16_t input)
-{
-	return zcbor_float16_bytes_encode(state, &input);
-}
-
-
 bool zcbor_tag_put(zcbor_state_t *state, uint32_t tag)
 {
 	if (!value_encode(state, ZCBOR_MAJOR_TYPE_TAG, &tag, sizeof(tag))) {
@@ -737,12 +718,6 @@ bool zcbor_tag_put(zcbor_state_t *state, uint32_t tag)
 }
 
 
-bool zcbor_tag_encode(zcbor_state_t *state, uint32_t *tag)
-{
-	return zcbor_tag_put(state, *tag);
-}
-
-
 bool zcbor_multi_encode_minmax(size_t min_encode, size_t max_encode,
 		const size_t *num_encode, zcbor_encoder_t encoder,
 		zcbor_state_t *state, const void *input, size_t result_len)
@@ -772,6 +747,27 @@ bool zcbor_multi_encode(const size_t num_encode, zcbor_encoder_t encoder,
 }
 
 
+bool zcbor_multi_encode_soa_minmax(size_t min_encode, size_t max_encode,
+		const size_t *num_encode, zcbor_soa_encoder_t encoder,
+		zcbor_state_t *state, const void *input)
+{
+	ZCBOR_CHECK_NULL(state);
+	ZCBOR_CHECK_ERROR();
+
+	if ((*num_encode < min_encode) || (*num_encode > max_encode)) {
+		ZCBOR_ERR(ZCBOR_ERR_ITERATIONS);
+	}
+
+	for (size_t i = 0; i < *num_encode; i++) {
+		if (!encoder(state, input, i)) {
+			ZCBOR_FAIL();
+		}
+	}
+	zcbor_log("Encoded %zu elements.\n", *num_encode);
+	return true;
+}
+
+
 void zcbor_new_encode_state(zcbor_state_t *state_array, size_t n_states,
 		uint8_t *payload, size_t payload_len, size_t elem_count)
 {
@@ -99,6 +99,9 @@ const char *zcbor_error_str(int error)
 		ZCBOR_ERR_CASE(ZCBOR_ERR_TOO_LARGE_FOR_STRING)
 		ZCBOR_ERR_CASE(ZCBOR_ERR_NOT_IN_FRAGMENT)
 		ZCBOR_ERR_CASE(ZCBOR_ERR_INSIDE_STRING)
+		ZCBOR_ERR_CASE(ZCBOR_ERR_INVALID_UTF8)
+		ZCBOR_ERR_CASE(ZCBOR_ERR_WORK_BUDGET)
+		ZCBOR_ERR_CASE(ZCBOR_ERR_NO_ARENA_MEM)
 	}
 	#undef ZCBOR_ERR_CASE
 
@@ -122,3 +125,48 @@ void zcbor_dump_hex(const uint8_t *str, size_t str_len)
 	}
 	zcbor_do_print("\n");
 }
+
+
+/** Whether entry @p a comes before entry @p b in a profile sorted by self time. */
+static bool profile_before(const struct zcbor_profile_entry *entries, size_t a, size_t b)
+{
+	return (entries[a].self_ticks > entries[b].self_ticks)
+		|| ((entries[a].self_ticks == entries[b].self_ticks) && (a < b));
+}
+
+
+void zcbor_profile_print(const struct zcbor_profile_entry *entries, size_t num_entries)
+{
+	uint64_t total_ticks = 0;
+	size_t prev = SIZE_MAX;
+
+	for (size_t i = 0; i < num_entries; i++) {
+		total_ticks += entries[i].self_ticks;
+	}
+
+	zcbor_do_print("%7s %14s %14s %10s  %s\r\n",
+		"self %", "self ticks", "total ticks", "calls", "rule");
+
+	/* Selection sort on the fly, so the table can stay const. */
+	for (size_t n = 0; n < num_entries; n++) {
+		size_t next = SIZE_MAX;
+
+		for (size_t i = 0; i < num_entries; i++) {
+			if (((prev == SIZE_MAX) || profile_before(entries, prev, i))
+				&& ((next == SIZE_MAX) || profile_before(entries, i, next))) {
+				next = i;
+			}
+		}
+
+		const struct zcbor_profile_entry *entry = &entries[next];
+		uint64_t permille = total_ticks ? (entry->self_ticks * 1000 / total_ticks) : 0;
+
+		prev = next;
+		if (entry->calls == 0) {
+			continue;
+		}
+		zcbor_do_print("%5" PRIu64 ".%" PRIu64 " %14" PRIu64 " %14" PRIu64 " %10" PRIu64 "  %s\r\n",
+			permille / 10, permille % 10, entry->self_ticks, entry->ticks,
+			entry->calls, entry->rule);
+	}
+}
@@ -0,0 +1,477 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Benchmarks for the C library. Prints the results as JSON to stdout.
+ *
+ * Usage: zcbor_bench [--min-time-ms <ms>] [--filter <substring>]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <zcbor_decode.h>
+#include <zcbor_encode.h>
+#include "bench.h"
+#include "bench_cases.h"
+#include "parallel.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAS_CYCLES true
+#define read_cycles() __rdtsc()
+#else
+#define HAS_CYCLES false
+#define read_cycles() 0
+#endif
+
+#define MAX_ENCODED_LEN 16384
+#define MAX_MAP_SIZE 1024
+#define PARALLEL_SEQ_LEN 1024
+
+static const size_t map_sizes[] = {4, 16, 64, 256, MAX_MAP_SIZE};
+static const size_t thread_counts[] = {1, 2, 4, 8};
+
+static uint64_t min_time_ns = 200000000;
+static const char *filter;
+static bool first_result = true;
+static bool failed;
+
+typedef bool (*bench_fn_t)(void *ctx);
+
+struct measurement {
+	uint64_t iterations;
+	uint64_t ns;
+	uint64_t cycles;
+};
+
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+
+/** Run @p fn repeatedly, doubling the number of iterations until a batch runs
+ *  for at least min_time_ns. The last batch is the one that is reported. */
+static bool measure(bench_fn_t fn, void *ctx, struct measurement *m)
+{
+	/* The first call doubles as a warmup and a correctness check. */
+	if (!fn(ctx)) {
+		return false;
+	}
+
+	for (uint64_t iterations = 1; ; iterations *= 2) {
+		uint64_t start_cycles = read_cycles();
+		uint64_t start = now_ns();
+
+		for (uint64_t i = 0; i < iterations; i++) {
+			if (!fn(ctx)) {
+				return false;
+			}
+		}
+
+		m->ns = now_ns() - start;
+		m->cycles = read_cycles() - start_cycles;
+		m->iterations = iterations;
+
+		if (m->ns >= min_time_ns) {
+			return true;
+		}
+	}
+}
+
+
+static void report(const char *benchmark, const char *case_name, const char *input,
+		size_t bytes, size_t items, size_t threads, const struct measurement *m)
+{
+	double ns_per_iteration = (double)m->ns / m->iterations;
+
+	printf("%s\n    {\"benchmark\": \"%s\", \"case\": \"%s\", \"input\": \"%s\", "
+		"\"bytes\": %zu, \"items\": %zu, \"threads\": %zu, \"iterations\": %llu, "
+		"\"ns_per_item\": %.3f, \"mb_per_s\": %.3f, \"cycles_per_byte\": ",
+		first_result ? "" : ",", benchmark, case_name, input, bytes, items, threads,
+		(unsigned long long)m->iterations,
+		ns_per_iteration / items, bytes * 1000.0 / ns_per_iteration);
+	if (HAS_CYCLES) {
+		printf("%.3f}", (double)m->cycles / m->iterations / bytes);
+	} else {
+		printf("null}");
+	}
+	first_result = false;
+}
+
+
+/** Whether the benchmark was selected with --filter (all are, by default). */
+static bool selected(const char *benchmark, const char *case_name, const char *input)
+{
+	char full_name[128];
+
+	snprintf(full_name, sizeof(full_name), "%s/%s/%s", benchmark, case_name, input);
+	return !filter || strstr(full_name, filter);
+}
+
+
+static void run_threads(const char *benchmark, const char *case_name, const char *input,
+		size_t bytes, size_t items, size_t threads, bench_fn_t fn, void *ctx)
+{
+	struct measurement m;
+
+	if (!selected(benchmark, case_name, input)) {
+		return;
+	}
+
+	if (!measure(fn, ctx, &m)) {
+		fprintf(stderr, "%s/%s/%s failed.\n", benchmark, case_name, input);
+		failed = true;
+		return;
+	}
+
+	report(benchmark, case_name, input, bytes, items, threads, &m);
+}
+
+
+static void run(const char *benchmark, const char *case_name, const char *input,
+		size_t bytes, size_t items, bench_fn_t fn, void *ctx)
+{
+	run_threads(benchmark, case_name, input, bytes, items, 1, fn, ctx);
+}
+
+
+struct codec_ctx {
+	const struct bench_case *bench_case;
+	const struct bench_input *input;
+	uint8_t *buf;
+	size_t encoded_len;
+};
+
+
+static bool decode_one(void *ctx)
+{
+	struct codec_ctx *c = ctx;
+	size_t len_out;
+
+	return c->bench_case->decode(c->input->payload, c->input->len, &len_out) == ZCBOR_SUCCESS;
+}
+
+
+static bool encode_one(void *ctx)
+{
+	struct codec_ctx *c = ctx;
+	size_t len_out;
+
+	return (c->bench_case->encode(c->buf, MAX_ENCODED_LEN, &len_out) == ZCBOR_SUCCESS)
+		&& (len_out == c->encoded_len);
+}
+
+
+static bool skip_one(void *ctx)
+{
+	const struct bench_input *input = ctx;
+	ZCBOR_STATE_D(state, 0, input->payload, input->len, 1, 0);
+
+	return zcbor_any_skip(state, NULL) && (state->payload == input->payload + input->len);
+}
+
+
+static void run_case(const struct bench_case *bench_case)
+{
+	static uint8_t buf[MAX_ENCODED_LEN];
+
+	for (size_t i = 0; i < bench_case->num_inputs; i++) {
+		const struct bench_input *input = &bench_case->inputs[i];
+		struct codec_ctx ctx = {
+			.bench_case = bench_case, .input = input, .buf = buf};
+		size_t len_out;
+
+		run("decode", bench_case->name, input->name, input->len, 1, decode_one, &ctx);
+		run("skip", bench_case->name, input->name, input->len, 1,
+			skip_one, (void *)input);
+
+		if (!selected("encode", bench_case->name, input->name)) {
+			continue;
+		}
+
+		/* Encode the data from a fresh decode of the input. The re-encoded
+		 * payload is not necessarily identical to the input. */
+		if (decode_one(&ctx)
+			&& (bench_case->encode(buf, sizeof(buf), &len_out) == ZCBOR_SUCCESS)) {
+			ctx.encoded_len = len_out;
+			run("encode", bench_case->name, input->name, len_out, 1, encode_one, &ctx);
+		} else {
+			fprintf(stderr, "encode/%s/%s failed.\n", bench_case->name, input->name);
+			failed = true;
+		}
+	}
+}
+
+
+struct parallel_ctx {
+	const struct bench_case *bench_case;
+	const uint8_t *payload;
+	size_t len;
+	size_t *offsets;
+	void *results;
+	uint8_t *scratch;
+	uint8_t *encoded;
+	zcbor_state_t *states;
+	size_t buf_len;
+	size_t encoded_len;
+	size_t num_threads;
+};
+
+
+static bool parallel_decode_all(void *ctx)
+{
+	struct parallel_ctx *c = ctx;
+	size_t num_items;
+
+	return (parallel_decode_seq(c->payload, c->len, c->offsets, PARALLEL_SEQ_LEN,
+			c->bench_case->decode_seq, c->results, c->bench_case->result_size,
+			c->num_threads, &num_items) == ZCBOR_SUCCESS)
+		&& (num_items == PARALLEL_SEQ_LEN);
+}
+
+
+static bool parallel_decode_list_all(void *ctx)
+{
+	struct parallel_ctx *c = ctx;
+	size_t num_items;
+
+	return (parallel_decode_list(c->encoded, c->encoded_len, c->offsets, PARALLEL_SEQ_LEN,
+			c->bench_case->decode_seq, c->results, c->bench_case->result_size,
+			c->num_threads, &num_items) == ZCBOR_SUCCESS)
+		&& (num_items == PARALLEL_SEQ_LEN);
+}
+
+
+static bool parallel_decode_states_all(void *ctx)
+{
+	struct parallel_ctx *c = ctx;
+	size_t num_items;
+
+	return (parallel_decode_seq_with_states(c->payload, c->len, c->offsets,
+			PARALLEL_SEQ_LEN, c->bench_case->decode_with_states, c->states,
+			c->bench_case->num_states, c->results, c->bench_case->result_size,
+			c->num_threads, &num_items) == ZCBOR_SUCCESS)
+		&& (num_items == PARALLEL_SEQ_LEN);
+}
+
+
+static bool parallel_encode_all(void *ctx)
+{
+	struct parallel_ctx *c = ctx;
+	size_t len_out;
+
+	return (parallel_encode_list(c->results, PARALLEL_SEQ_LEN, c->bench_case->result_size,
+			c->bench_case->encode_seq, c->scratch, c->buf_len, c->num_threads,
+			c->encoded, c->buf_len, &len_out) == ZCBOR_SUCCESS)
+		&& (len_out == c->encoded_len);
+}
+
+
+/** Decode a sequence of PARALLEL_SEQ_LEN copies of the first input of the case, encode
+ *  the results as a list, and decode that list, with different numbers of threads.
+ *  Also decode the sequence item by item, with one state array per thread. */
+static void run_parallel(const struct bench_case *bench_case)
+{
+	const struct bench_input *input = &bench_case->inputs[0];
+	static size_t offsets[PARALLEL_SEQ_LEN + 1];
+	struct parallel_ctx ctx = {
+		.bench_case = bench_case,
+		.len = input->len * PARALLEL_SEQ_LEN,
+		.offsets = offsets,
+		.num_threads = 1,
+	};
+	uint8_t *payload;
+
+	if (!bench_case->decode_seq || !bench_case->encode_seq || !bench_case->decode_with_states
+		|| (!selected("parallel_decode", bench_case->name, input->name)
+			&& !selected("parallel_encode", bench_case->name, input->name)
+			&& !selected("parallel_decode_list", bench_case->name, input->name)
+			&& !selected("parallel_decode_states", bench_case->name, input->name))) {
+		return;
+	}
+
+	/* The re-encoded payload is not necessarily the same size as the input. */
+	ctx.buf_len = ctx.len * 2 + 16;
+	payload = malloc(ctx.len);
+	ctx.results = calloc(PARALLEL_SEQ_LEN, bench_case->result_size);
+	ctx.scratch = malloc(ctx.buf_len);
+	ctx.encoded = malloc(ctx.buf_len);
+	/* The state arrays of all threads, allocated once and reused by every run. */
+	ctx.states = calloc(thread_counts[ZCBOR_ARRAY_SIZE(thread_counts) - 1]
+			* bench_case->num_states, sizeof(zcbor_state_t));
+
+	if (!payload || !ctx.results || !ctx.scratch || !ctx.encoded || !ctx.states) {
+		fprintf(stderr, "parallel/%s/%s: Out of memory.\n", bench_case->name, input->name);
+		failed = true;
+		goto out;
+	}
+
+	for (size_t i = 0; i < PARALLEL_SEQ_LEN; i++) {
+		memcpy(&payload[i * input->len], input->payload, input->len);
+	}
+	ctx.payload = payload;
+
+	/* Decode and encode once, to get the results to encode, and the encoded length. */
+	if (!parallel_decode_all(&ctx)
+		|| (parallel_encode_list(ctx.results, PARALLEL_SEQ_LEN, bench_case->result_size,
+			bench_case->encode_seq, ctx.scratch, ctx.buf_len, 1, ctx.encoded,
+			ctx.buf_len, &ctx.encoded_len) != ZCBOR_SUCCESS)) {
+		fprintf(stderr, "parallel/%s/%s failed.\n", bench_case->name, input->name);
+		failed = true;
+		goto out;
+	}
+
+	for (size_t i = 0; i < ZCBOR_ARRAY_SIZE(thread_counts); i++) {
+		ctx.num_threads = thread_counts[i];
+		run_threads("parallel_decode", bench_case->name, input->name, ctx.len,
+			PARALLEL_SEQ_LEN, ctx.num_threads, parallel_decode_all, &ctx);
+	}
+	for (size_t i = 0; i < ZCBOR_ARRAY_SIZE(thread_counts); i++) {
+		ctx.num_threads = thread_counts[i];
+		run_threads("parallel_encode", bench_case->name, input->name, ctx.encoded_len,
+			PARALLEL_SEQ_LEN, ctx.num_threads, parallel_encode_all, &ctx);
+	}
+	for (size_t i = 0; i < ZCBOR_ARRAY_SIZE(thread_counts); i++) {
+		ctx.num_threads = thread_counts[i];
+		run_threads("parallel_decode_list", bench_case->name, input->name,
+			ctx.encoded_len, PARALLEL_SEQ_LEN, ctx.num_threads,
+			parallel_decode_list_all, &ctx);
+	}
+	for (size_t i = 0; i < ZCBOR_ARRAY_SIZE(thread_counts); i++) {
+		ctx.num_threads = thread_counts[i];
+		run_threads("parallel_decode_states", bench_case->name, input->name, ctx.len,
+			PARALLEL_SEQ_LEN, ctx.num_threads, parallel_decode_states_all, &ctx);
+	}
+
+out:
+	free(payload);
+	free(ctx.results);
+	free(ctx.scratch);
+	free(ctx.encoded);
+	free(ctx.states);
+}
+
+
+struct map_ctx {
+	const uint8_t *payload;
+	size_t len;
+	size_t n_elems;
+};
+
+
+/** Search for all keys of a map of n_elems uint keys, in a scrambled order. */
+static bool map_search_all(void *ctx)
+{
+	struct map_ctx *c = ctx;
+	ZCBOR_STATE_D(state, 1, c->payload, c->len, 1, MAX_MAP_SIZE);
+
+	if (!zcbor_unordered_map_start_decode(state)) {
+		return false;
+	}
+
+	for (size_t i = 0; i < c->n_elems; i++) {
+		/* n_elems is a power of 2 and the stride is odd, so this visits every
+		 * key exactly once, each about half a map away from the previous one. */
+		uint32_t key = (i * (c->n_elems / 2 + 1)) % c->n_elems;
+		uint32_t value;
+
+		if (!zcbor_unordered_map_search(ZCBOR_CAST_FP(zcbor_uint32_pexpect), state, &key)
+			|| !zcbor_uint32_decode(state, &value)
+			|| (value != ~key)) {
+			return false;
+		}
+	}
+
+	return zcbor_unordered_map_end_decode(state);
+}
+
+
+static void run_map_search(void)
+{
+	static uint8_t payload[MAX_MAP_SIZE * 8 + 8];
+
+	for (size_t i = 0; i < ZCBOR_ARRAY_SIZE(map_sizes); i++) {
+		size_t n_elems = map_sizes[i];
+		char input_name[16];
+		ZCBOR_STATE_E(state, 1, payload, sizeof(payload), 0);
+		bool ok = zcbor_map_start_encode(state, n_elems);
+
+		for (uint32_t key = 0; ok && (key < n_elems); key++) {
+			ok = zcbor_uint32_put(state, key) && zcbor_uint32_put(state, ~key);
+		}
+		if (!ok || !zcbor_map_end_encode(state, n_elems)) {
+			fprintf(stderr, "Could not encode map with %zu elements.\n", n_elems);
+			failed = true;
+			return;
+		}
+
+		struct map_ctx ctx = {
+			.payload = payload,
+			.len = state->payload - payload,
+			.n_elems = n_elems,
+		};
+
+		snprintf(input_name, sizeof(input_name), "uint%zu", n_elems);
+		run("map_search", "unordered_map", input_name, ctx.len, n_elems,
+			map_search_all, &ctx);
+	}
+}
+
+
+int main(int argc, char **argv)
+{
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "--min-time-ms") && (i + 1 < argc)) {
+			min_time_ns = strtoull(argv[++i], NULL, 10) * 1000000;
+		} else if (!strcmp(argv[i], "--filter") && (i + 1 < argc)) {
+			filter = argv[++i];
+		} else {
+			fprintf(stderr, "Usage: %s [--min-time-ms <ms>] [--filter <substring>]\n",
+				argv[0]);
+			return 2;
+		}
+	}
+
+	printf("{\n  \"zcbor_version\": \"%s\",\n", ZCBOR_VERSION_STR);
+	printf("  \"config\": {\"canonical\": %s, \"map_smart_search\": %s, \"inline\": %s, "
+		"\"min_time_ms\": %llu, \"cores\": %ld},\n",
+#ifdef ZCBOR_CANONICAL
+		"true",
+#else
+		"false",
+#endif
+#ifdef ZCBOR_MAP_SMART_SEARCH
+		"true",
+#else
+		"false",
+#endif
+#ifdef ZCBOR_INLINE
+		"true",
+#else
+		"false",
+#endif
+		(unsigned long long)(min_time_ns / 1000000), sysconf(_SC_NPROCESSORS_ONLN));
+	printf("  \"results\": [");
+
+	for (size_t i = 0; i < ZCBOR_ARRAY_SIZE(bench_cases); i++) {
+		run_case(bench_cases[i]);
+	}
+	for (size_t i = 0; i < ZCBOR_ARRAY_SIZE(bench_cases); i++) {
+		run_parallel(bench_cases[i]);
+	}
+	run_map_search();
+
+	printf("\n  ]\n}\n");
+
+	return failed ? 1 : 0;
+}
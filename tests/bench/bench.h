@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef BENCH_H__
+#define BENCH_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <zcbor_common.h>
+
+/** One encoded payload to benchmark a case with. */
+struct bench_input {
+	const char *name;
+	const uint8_t *payload;
+	size_t len;
+};
+
+/** A generated codec together with the inputs to run it on.
+ *
+ * @ref decode decodes into a result struct owned by the case, and @ref encode
+ * encodes that same struct, so @ref encode must only be called after a
+ * successful @ref decode. Both return a ZCBOR_SUCCESS or an error code, like
+ * the generated entry functions.
+ */
+struct bench_case {
+	const char *name;
+	const struct bench_input *inputs;
+	size_t num_inputs;
+	int (*decode)(const uint8_t *payload, size_t payload_len, size_t *payload_len_out);
+	int (*encode)(uint8_t *payload, size_t payload_len, size_t *payload_len_out);
+
+	/** The generated sequence function (see the PARALLEL option of bench_case()),
+	 *  or NULL. It decodes into @p results, an array of result structs, each of
+	 *  size @ref result_size. */
+	int (*decode_seq)(const uint8_t *payload, size_t payload_len, void *results,
+			size_t max_results, size_t *num_results);
+
+	/** The generated sequence function, like @ref decode_seq, encoding from an
+	 *  array of result structs, or NULL. */
+	int (*encode_seq)(uint8_t *payload, size_t payload_len, const void *inputs,
+			size_t num_inputs, size_t *num_encoded, size_t *payload_len_out);
+	size_t result_size;
+
+	/** The generated function with a caller-provided state array (see the PARALLEL
+	 *  option of bench_case()), decoding into @p result, or NULL. */
+	int (*decode_with_states)(const uint8_t *payload, size_t payload_len, void *result,
+			size_t *payload_len_out, zcbor_state_t *states, size_t n_states);
+
+	/** The number of states needed by @ref decode_with_states. */
+	size_t num_states;
+};
+
+#endif /* BENCH_H__ */
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Compiled once per case. See bench_case() in CMakeLists.txt for the defines. */
+
+#include "bench.h"
+#include <zcbor_common.h>
+#include BENCH_DECODE_H
+#include BENCH_ENCODE_H
+#include BENCH_INPUTS_H
+
+static BENCH_RESULT_TYPE result;
+
+
+static int decode(const uint8_t *payload, size_t payload_len, size_t *payload_len_out)
+{
+	return BENCH_DECODE(payload, payload_len, &result, payload_len_out);
+}
+
+
+static int encode(uint8_t *payload, size_t payload_len, size_t *payload_len_out)
+{
+	return BENCH_ENCODE(payload, payload_len, &result, payload_len_out);
+}
+
+
+#ifdef BENCH_DECODE_SEQ
+static int decode_seq(const uint8_t *payload, size_t payload_len, void *results,
+		size_t max_results, size_t *num_results)
+{
+	size_t len_out;
+
+	return BENCH_DECODE_SEQ(payload, payload_len, results, max_results, num_results,
+			&len_out);
+}
+#endif
+
+
+#ifdef BENCH_ENCODE_SEQ
+static int encode_seq(uint8_t *payload, size_t payload_len, const void *inputs,
+		size_t num_inputs, size_t *num_encoded, size_t *payload_len_out)
+{
+	return BENCH_ENCODE_SEQ(payload, payload_len, inputs, num_inputs, num_encoded,
+			payload_len_out);
+}
+#endif
+
+
+#ifdef BENCH_DECODE_WITH_STATES
+static int decode_with_states(const uint8_t *payload, size_t payload_len, void *result,
+		size_t *payload_len_out, zcbor_state_t *states, size_t n_states)
+{
+	return BENCH_DECODE_WITH_STATES(payload, payload_len, result, payload_len_out,
+			states, n_states);
+}
+#endif
+
+
+const struct bench_case BENCH_CASE_SYMBOL = {
+	.name = BENCH_CASE_NAME,
+	.inputs = bench_inputs,
+	.num_inputs = ZCBOR_ARRAY_SIZE(bench_inputs),
+	.decode = decode,
+	.encode = encode,
+#ifdef BENCH_DECODE_SEQ
+	.decode_seq = decode_seq,
+#endif
+#ifdef BENCH_ENCODE_SEQ
+	.encode_seq = encode_seq,
+#endif
+	.result_size = sizeof(result),
+#ifdef BENCH_DECODE_WITH_STATES
+	.decode_with_states = decode_with_states,
+	.num_states = BENCH_NUM_STATES,
+#endif
+};
@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* An example host (pthreads) driver for decoding CBOR sequences and lists, and encoding
+ * lists, in parallel, as described in "Decoding and encoding in parallel" in the README.
+ * It is not part of the library, which has no threading of its own. It is used by the
+ * parallel benchmarks, and can be copied into an application as a starting point. */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <zcbor_decode.h>
+#include <zcbor_encode.h>
+#include "parallel.h"
+
+#define MAX_THREADS 64
+
+struct decode_chunk {
+	const uint8_t *payload;
+	size_t len;
+	void *results;
+	size_t num_items;
+	parallel_seq_decode_t decode_seq;
+	int err;
+};
+
+
+static void *decode_chunk(void *arg)
+{
+	struct decode_chunk *chunk = arg;
+	size_t num_decoded;
+
+	chunk->err = chunk->decode_seq(chunk->payload, chunk->len, chunk->results,
+			chunk->num_items, &num_decoded);
+
+	if ((chunk->err == ZCBOR_SUCCESS) && (num_decoded != chunk->num_items)) {
+		chunk->err = ZCBOR_ERR_HIGH_ELEM_COUNT;
+	}
+	return NULL;
+}
+
+
+struct states_chunk {
+	const uint8_t *items;
+	const size_t *offsets;
+	size_t num_items;
+	void *results;
+	size_t result_size;
+	parallel_states_decode_t decode;
+	zcbor_state_t *states;
+	size_t num_states;
+	int err;
+};
+
+
+static void *decode_states_chunk(void *arg)
+{
+	struct states_chunk *chunk = arg;
+
+	for (size_t i = 0; i < chunk->num_items; i++) {
+		size_t len = chunk->offsets[i + 1] - chunk->offsets[i];
+		size_t len_out;
+
+		chunk->err = chunk->decode(chunk->items + chunk->offsets[i], len,
+				(uint8_t *)chunk->results + i * chunk->result_size, &len_out,
+				chunk->states, chunk->num_states);
+
+		if ((chunk->err == ZCBOR_SUCCESS) && (len_out != len)) {
+			chunk->err = ZCBOR_ERR_PAYLOAD_NOT_CONSUMED;
+		}
+		if (chunk->err != ZCBOR_SUCCESS) {
+			break;
+		}
+	}
+	return NULL;
+}
+
+
+struct encode_chunk {
+	const void *inputs;
+	size_t num_items;
+	uint8_t *buf;
+	size_t buf_len;
+	parallel_seq_encode_t encode_seq;
+	size_t encoded_len;
+	int err;
+};
+
+
+static void *encode_chunk(void *arg)
+{
+	struct encode_chunk *chunk = arg;
+	size_t num_encoded;
+
+	chunk->err = chunk->encode_seq(chunk->buf, chunk->buf_len, chunk->inputs,
+			chunk->num_items, &num_encoded, &chunk->encoded_len);
+	return NULL;
+}
+
+
+/** Call @p work on each of the first @p num_threads of @p chunks, on one thread each.
+ *  Chunk 0 is processed on the calling thread, after starting the others. */
+static void run_chunks(void *(*work)(void *), void *chunks, size_t chunk_size,
+		size_t num_threads)
+{
+	pthread_t threads[MAX_THREADS];
+	bool started[MAX_THREADS] = {false};
+
+	for (size_t t = 1; t < num_threads; t++) {
+		void *chunk = (uint8_t *)chunks + t * chunk_size;
+
+		started[t] = !pthread_create(&threads[t], NULL, work, chunk);
+		if (!started[t]) {
+			work(chunk);
+		}
+	}
+
+	work(chunks);
+
+	for (size_t t = 1; t < num_threads; t++) {
+		if (started[t]) {
+			pthread_join(threads[t], NULL);
+		}
+	}
+}
+
+
+/** Decode the @p num_items items indexed in @p offsets, relative to @p items, as a CBOR
+ *  sequence split into @p num_threads chunks. */
+static int decode_chunks(const uint8_t *items, const size_t *offsets, size_t num_items,
+		parallel_seq_decode_t decode_seq, void *results, size_t result_size,
+		size_t num_threads)
+{
+	struct decode_chunk chunks[MAX_THREADS];
+
+	for (size_t t = 0; t < num_threads; t++) {
+		size_t first = num_items * t / num_threads;
+		size_t end = num_items * (t + 1) / num_threads;
+
+		chunks[t] = (struct decode_chunk){
+			.payload = items + offsets[first],
+			.len = offsets[end] - offsets[first],
+			.results = (uint8_t *)results + first * result_size,
+			.num_items = end - first,
+			.decode_seq = decode_seq,
+		};
+	}
+
+	run_chunks(decode_chunk, chunks, sizeof(chunks[0]), num_threads);
+
+	for (size_t t = 0; t < num_threads; t++) {
+		if (chunks[t].err != ZCBOR_SUCCESS) {
+			return chunks[t].err;
+		}
+	}
+
+	return ZCBOR_SUCCESS;
+}
+
+
+/** Index the items of the CBOR sequence at @p payload into @p offsets. */
+static int index_seq(const uint8_t *payload, size_t payload_len, size_t *offsets,
+		size_t max_items, size_t num_threads, size_t *num_items)
+{
+	ZCBOR_STATE_D(state, 0, payload, payload_len, ZCBOR_LARGE_ELEM_COUNT, 0);
+
+	*num_items = 0;
+
+	if ((num_threads == 0) || (num_threads > MAX_THREADS)) {
+		return ZCBOR_ERR_UNKNOWN;
+	}
+
+	if (!zcbor_index_items(state, offsets, max_items, num_items)) {
+		return zcbor_peek_error(state);
+	}
+	if (!zcbor_payload_at_end(state)) {
+		return ZCBOR_ERR_HIGH_ELEM_COUNT;
+	}
+
+	return ZCBOR_SUCCESS;
+}
+
+
+int parallel_decode_seq(const uint8_t *payload, size_t payload_len, size_t *offsets,
+		size_t max_items, parallel_seq_decode_t decode_seq, void *results,
+		size_t result_size, size_t num_threads, size_t *num_items)
+{
+	int err = index_seq(payload, payload_len, offsets, max_items, num_threads, num_items);
+
+	if (err != ZCBOR_SUCCESS) {
+		return err;
+	}
+
+	return decode_chunks(payload, offsets, *num_items, decode_seq, results, result_size,
+			num_threads);
+}
+
+
+int parallel_decode_seq_with_states(const uint8_t *payload, size_t payload_len,
+		size_t *offsets, size_t max_items, parallel_states_decode_t decode,
+		zcbor_state_t *states, size_t num_states, void *results, size_t result_size,
+		size_t num_threads, size_t *num_items)
+{
+	struct states_chunk chunks[MAX_THREADS];
+	int err = index_seq(payload, payload_len, offsets, max_items, num_threads, num_items);
+
+	if (err != ZCBOR_SUCCESS) {
+		return err;
+	}
+
+	for (size_t t = 0; t < num_threads; t++) {
+		size_t first = *num_items * t / num_threads;
+		size_t end = *num_items * (t + 1) / num_threads;
+
+		chunks[t] = (struct states_chunk){
+			.items = payload,
+			.offsets = &offsets[first],
+			.num_items = end - first,
+			.results = (uint8_t *)results + first * result_size,
+			.result_size = result_size,
+			.decode = decode,
+			.states = &states[t * num_states],
+			.num_states = num_states,
+		};
+	}
+
+	run_chunks(decode_states_chunk, chunks, sizeof(chunks[0]), num_threads);
+
+	for (size_t t = 0; t < num_threads; t++) {
+		if (chunks[t].err != ZCBOR_SUCCESS) {
+			return chunks[t].err;
+		}
+	}
+
+	return ZCBOR_SUCCESS;
+}
+
+
+int parallel_decode_list(const uint8_t *payload, size_t payload_len, size_t *offsets,
+		size_t max_items, parallel_seq_decode_t decode_seq, void *results,
+		size_t result_size, size_t num_threads, size_t *num_items)
+{
+	ZCBOR_STATE_D(state, 1, payload, payload_len, 1, 0);
+	const uint8_t *items;
+
+	*num_items = 0;
+
+	if ((num_threads == 0) || (num_threads > MAX_THREADS)) {
+		return ZCBOR_ERR_UNKNOWN;
+	}
+
+	if (!zcbor_list_start_decode(state)) {
+		return zcbor_peek_error(state);
+	}
+	items = state->payload;
+
+	if (!zcbor_index_items(state, offsets, max_items, num_items)) {
+		return zcbor_peek_error(state);
+	}
+	if (!zcbor_array_at_end(state)) {
+		return ZCBOR_ERR_HIGH_ELEM_COUNT;
+	}
+	if (!zcbor_list_end_decode(state)) {
+		return zcbor_peek_error(state);
+	}
+	if (!zcbor_payload_at_end(state)) {
+		return ZCBOR_ERR_PAYLOAD_NOT_CONSUMED;
+	}
+
+	return decode_chunks(items, offsets, *num_items, decode_seq, results, result_size,
+			num_threads);
+}
+
+
+int parallel_encode_list(const void *inputs, size_t num_items, size_t input_size,
+		parallel_seq_encode_t encode_seq, uint8_t *scratch, size_t scratch_len,
+		size_t num_threads, uint8_t *payload, size_t payload_len, size_t *payload_len_out)
+{
+	ZCBOR_STATE_E(state, 0, payload, payload_len, 0);
+	struct encode_chunk chunks[MAX_THREADS];
+	struct zcbor_string encoded[MAX_THREADS];
+
+	if ((num_threads == 0) || (num_threads > MAX_THREADS)) {
+		return ZCBOR_ERR_UNKNOWN;
+	}
+
+	for (size_t t = 0; t < num_threads; t++) {
+		size_t first = num_items * t / num_threads;
+		size_t scratch_first = scratch_len * t / num_threads;
+
+		chunks[t] = (struct encode_chunk){
+			.inputs = (const uint8_t *)inputs + first * input_size,
+			.num_items = num_items * (t + 1) / num_threads - first,
+			.buf = scratch + scratch_first,
+			.buf_len = scratch_len * (t + 1) / num_threads - scratch_first,
+			.encode_seq = encode_seq,
+		};
+	}
+
+	run_chunks(encode_chunk, chunks, sizeof(chunks[0]), num_threads);
+
+	for (size_t t = 0; t < num_threads; t++) {
+		if (chunks[t].err != ZCBOR_SUCCESS) {
+			return chunks[t].err;
+		}
+		encoded[t].value = chunks[t].buf;
+		encoded[t].len = chunks[t].encoded_len;
+	}
+
+	if (!zcbor_list_chunks_encode(state, num_items, encoded, num_threads)) {
+		return zcbor_peek_error(state);
+	}
+
+	*payload_len_out = (size_t)(state->payload - payload);
+	return ZCBOR_SUCCESS;
+}
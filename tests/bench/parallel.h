@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* An example driver for decoding and encoding in parallel, see parallel.c. */
+
+#ifndef PARALLEL_H__
+#define PARALLEL_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <zcbor_common.h>
+
+/** A function generated with --sequence-entry-types, with the result type erased. */
+typedef int (*parallel_seq_decode_t)(const uint8_t *payload, size_t payload_len,
+		void *results, size_t max_results, size_t *num_results);
+
+/** Decode the CBOR sequence at @p payload into @p results, on @p num_threads threads.
+ *
+ * First, @ref zcbor_index_items finds the start of each item, then the items are
+ * divided into @p num_threads chunks of consecutive items, and each chunk is decoded
+ * with @p decode_seq on its own thread (the first on the calling thread), directly
+ * into its part of @p results.
+ *
+ * @param[out] offsets      Array of at least @p max_items + 1 offsets, for the index.
+ * @param[in]  result_size  The size of each result struct in @p results.
+ * @param[out] num_items    The number of decoded items.
+ *
+ * @return ZCBOR_SUCCESS, the error from the index pass or from the first chunk that
+ *         failed, or ZCBOR_ERR_HIGH_ELEM_COUNT if there are more than @p max_items items.
+ */
+int parallel_decode_seq(const uint8_t *payload, size_t payload_len, size_t *offsets,
+		size_t max_items, parallel_seq_decode_t decode_seq, void *results,
+		size_t result_size, size_t num_threads, size_t *num_items);
+
+/** Decode the CBOR list at @p payload into @p results, on @p num_threads threads.
+ *
+ * Like @ref parallel_decode_seq, but for a top-level list whose elements all have the
+ * type decoded by @p decode_seq. The list header is decoded first, then the elements are
+ * indexed, and decoded in chunks as CBOR sequences, since a slice of the elements of a
+ * list is a valid CBOR sequence.
+ *
+ * @return Like @ref parallel_decode_seq, and ZCBOR_ERR_PAYLOAD_NOT_CONSUMED if there is
+ *         data after the list.
+ */
+int parallel_decode_list(const uint8_t *payload, size_t payload_len, size_t *offsets,
+		size_t max_items, parallel_seq_decode_t decode_seq, void *results,
+		size_t result_size, size_t num_threads, size_t *num_items);
+
+/** A function generated with --external-state-entry-types, with the result type erased. */
+typedef int (*parallel_states_decode_t)(const uint8_t *payload, size_t payload_len,
+		void *result, size_t *payload_len_out, zcbor_state_t *states, size_t n_states);
+
+/** Decode the CBOR sequence at @p payload into @p results, one item at a time, on
+ *  @p num_threads threads.
+ *
+ * Like @ref parallel_decode_seq, but each thread decodes the items of its chunk one by
+ * one with @p decode, using its own part of @p states as the state array. The state
+ * arrays are provided by the caller, who can e.g. allocate them once per worker and reuse
+ * them for every call. Nothing is shared between the threads, so no locking is needed.
+ *
+ * @param[in] states      Array of @p num_threads * @p num_states states. Thread t uses
+ *                        the @p num_states states starting at index t * @p num_states.
+ * @param[in] num_states  The number of states per thread, e.g.
+ *                        CBOR_DECODE_<TYPE>_NUM_STATES.
+ *
+ * @return Like @ref parallel_decode_seq, and ZCBOR_ERR_PAYLOAD_NOT_CONSUMED if @p decode
+ *         did not consume a whole item.
+ */
+int parallel_decode_seq_with_states(const uint8_t *payload, size_t payload_len,
+		size_t *offsets, size_t max_items, parallel_states_decode_t decode,
+		zcbor_state_t *states, size_t num_states, void *results, size_t result_size,
+		size_t num_threads, size_t *num_items);
+
+/** A function generated with --sequence-entry-types, with the input type erased. */
+typedef int (*parallel_seq_encode_t)(uint8_t *payload, size_t payload_len,
+		const void *inputs, size_t num_inputs, size_t *num_encoded,
+		size_t *payload_len_out);
+
+/** Encode @p inputs as a CBOR list of @p num_items elements, on @p num_threads threads.
+ *
+ * The inputs are divided into @p num_threads chunks of consecutive inputs, and each
+ * chunk is encoded with @p encode_seq on its own thread (the first on the calling
+ * thread), into its own part of @p scratch. Then @ref zcbor_list_chunks_encode writes
+ * the list header followed by the encoded chunks into @p payload.
+ *
+ * @param[in]  input_size       The size of each input struct in @p inputs.
+ * @param[in]  scratch          Buffer for the encoded chunks. Each thread gets an equal
+ *                              part of it, which must fit the thread's chunk.
+ * @param[out] payload_len_out  The length of the encoded list.
+ *
+ * @return ZCBOR_SUCCESS, the error from the first chunk that failed, or
+ *         ZCBOR_ERR_NO_PAYLOAD if the list does not fit in @p payload.
+ */
+int parallel_encode_list(const void *inputs, size_t num_items, size_t input_size,
+		parallel_seq_encode_t encode_seq, uint8_t *scratch, size_t scratch_len,
+		size_t num_threads, uint8_t *payload, size_t payload_len, size_t *payload_len_out);
+
+#endif /* PARALLEL_H__ */
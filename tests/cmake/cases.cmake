@@ -0,0 +1,119 @@
+#
+# Copyright (c) 2024 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+
+# The CDDL cases (from tests/cases) that are generated by the benchmarks
+# (tests/bench) and the size report (tests/size_report).
+#
+# Before including this file, define a function called zcbor_case(NAME ...) that
+# adds one case. It is called with these arguments:
+#
+#  CDDL:        The CDDL files, relative to tests/cases.
+#  TYPES:       The entry types. The first one is the main type of the case.
+#  ARGS:        Extra arguments to "zcbor code".
+#  RESULT_TYPE: The struct that the first type is decoded into.
+#  INPUTS:      Example payloads for the first type, either .yaml files (converted
+#               via the CDDL) or .cborhex files. Cases without inputs can't be run,
+#               so they are only generated and compiled, e.g. for the size report.
+#  PARALLEL:    The result struct is small enough to decode sequences of the first
+#               type into arrays of results.
+#
+# The everything case is not included, since everything.cddl currently fails to parse.
+
+zcbor_case(pet
+  CDDL pet.cddl
+  TYPES Pet
+  RESULT_TYPE "struct Pet"
+  INPUTS pet0.yaml
+  PARALLEL
+  )
+
+zcbor_case(manifest12
+  CDDL manifest12.cddl
+  TYPES SUIT_Envelope SUIT_Envelope_Tagged SUIT_Command_Sequence
+  RESULT_TYPE "struct SUIT_Envelope"
+  ARGS --default-max-qty 16
+  INPUTS
+    manifest12_example0.cborhex manifest12_example1.cborhex manifest12_example2.cborhex
+    manifest12_example3.cborhex manifest12_example4.cborhex manifest12_example5.cborhex
+  )
+
+zcbor_case(manifest14
+  CDDL manifest14.cddl cose.cddl
+  TYPES SUIT_Envelope_Tagged SUIT_Envelope SUIT_Manifest SUIT_Command_Sequence SUIT_Common_Sequence
+  RESULT_TYPE "struct SUIT_Envelope"
+  ARGS --default-max-qty 4 --unordered-maps
+  INPUTS
+    manifest14_example0.cborhex manifest14_example1.cborhex manifest14_example2.cborhex
+    manifest14_example3.cborhex manifest14_example4.cborhex manifest14_example5.cborhex
+  )
+
+zcbor_case(manifest16
+  CDDL manifest16.cddl cose.cddl
+  TYPES SUIT_Envelope_Tagged SUIT_Envelope SUIT_Manifest SUIT_Command_Sequence SUIT_Common_Sequence
+  RESULT_TYPE "struct SUIT_Envelope"
+  ARGS --default-max-qty 4 --unordered-maps
+  )
+
+zcbor_case(manifest20
+  CDDL manifest20.cddl cose.cddl
+  TYPES SUIT_Envelope_Tagged SUIT_Envelope SUIT_Manifest SUIT_Command_Sequence SUIT_Shared_Sequence
+  RESULT_TYPE "struct SUIT_Envelope"
+  ARGS --default-max-qty 4 --unordered-maps
+  INPUTS
+    manifest20_example0.cborhex manifest20_example1.cborhex manifest20_example2.cborhex
+    manifest20_example3.cborhex manifest20_example4.cborhex manifest20_example5.cborhex
+  )
+
+zcbor_case(manifest9_simple
+  CDDL manifest9_simple.cddl
+  TYPES SUIT_Envelope SUIT_Manifest
+  RESULT_TYPE "struct SUIT_Envelope"
+  )
+
+zcbor_case(cose
+  CDDL cose.cddl
+  TYPES COSE_Sign1_Tagged
+  RESULT_TYPE "struct COSE_Sign1"
+  INPUTS cose_example0.yaml
+  PARALLEL
+  )
+
+zcbor_case(senml
+  CDDL senml.cddl
+  TYPES lwm2m_senml
+  RESULT_TYPE "struct lwm2m_senml"
+  ARGS --default-max-qty 8
+  INPUTS senml_example0.yaml
+  PARALLEL
+  )
+
+zcbor_case(unordered_map
+  CDDL unordered_map.cddl
+  TYPES UnorderedMap1
+  RESULT_TYPE "struct UnorderedMap1"
+  ARGS --unordered-maps
+  INPUTS unordered_map_example0.yaml
+  PARALLEL
+  )
+
+zcbor_case(serial_recovery
+  CDDL serial_recovery.cddl
+  TYPES Upload
+  RESULT_TYPE "struct Upload"
+  ARGS --unordered-maps
+  )
+
+zcbor_case(corner_cases
+  CDDL corner_cases.cddl
+  TYPES
+    NestedListMap NestedMapListMap Numbers Numbers2 NumberMap TaggedUnion Strings Simple2
+    Optional Union Map Level1 Range ValueRange ValueRange2 FloatRange SingleBstr SingleInt
+    SingleInt2 Unabstracted QuantityRange DoubleMap Floats Floats2 CBORBstr MapLength UnionInt2
+    Intmax1 Intmax2 Intmax4 InvalidIdentifiers MapUnionPrimAlias EmptyContainer SingleElemList
+    Choice1 Choice2 Choice3 Choice4 Choice5 OptList UnionDefault
+  RESULT_TYPE "struct NestedListMap"
+  ARGS --default-max-qty 6
+  )
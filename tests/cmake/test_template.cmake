@@ -25,8 +25,52 @@ if (MAP_SMART_SEARCH)
   zephyr_compile_definitions(ZCBOR_MAP_SMART_SEARCH)
 endif()
 
+if (VALIDATE_UTF8)
+  zephyr_compile_definitions(ZCBOR_VALIDATE_UTF8)
+endif()
+
+if (STATS)
+  zephyr_compile_definitions(ZCBOR_STATS)
+endif()
+
+if (TRACE_BUFFER)
+  zephyr_compile_definitions(ZCBOR_TRACE_BUFFER)
+endif()
+
+if (WORK_BUDGET)
+  zephyr_compile_definitions(ZCBOR_WORK_BUDGET)
+endif()
+
+if (ARENA)
+  zephyr_compile_definitions(ZCBOR_ARENA)
+endif()
+
+if (STRING_OFFSETS)
+  zephyr_compile_definitions(ZCBOR_STRING_OFFSETS)
+endif()
+
+if (INLINE)
+  zephyr_compile_definitions(ZCBOR_INLINE)
+endif()
+
+if (TRUSTED_INPUT)
+  zephyr_compile_definitions(ZCBOR_TRUSTED_INPUT)
+endif()
+
+if (BSTR_STREAM)
+  zephyr_compile_definitions(ZCBOR_BSTR_STREAM)
+endif()
+
+if (HASH_REGION)
+  zephyr_compile_definitions(ZCBOR_HASH_REGION)
+endif()
+
 zephyr_compile_options(-Werror)
 
 if (CONFIG_64BIT)
   set(bit_arg --default-bit-size 64)
 endif()
+
+if (PROFILE)
+  set(profile_arg --profile)
+endif()
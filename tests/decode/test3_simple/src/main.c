@@ -450,6 +450,182 @@ ZTEST(cbor_decode_test3, test_pet)
 }
 
 
+#ifdef ZCBOR_TRACE_BUFFER
+/* Check the events recorded by the generated code when tracing is enabled,
+ * including when the ring buffer wraps around.
+ */
+ZTEST(cbor_decode_test3, test_pet_trace)
+{
+	struct Pet pet;
+	size_t decode_len;
+	static struct zcbor_trace_event events[4];
+	static struct zcbor_trace_buffer trace;
+	uint8_t input[] = {
+		0x83, 0x82, 0x63, 0x66, 0x6f, 0x6f, 0x63, 0x62, 0x61, 0x72,
+		0x48, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+		0x02};
+
+	zcbor_trace_start(&trace, events, ARRAY_SIZE(events));
+	zassert_equal(ZCBOR_SUCCESS, cbor_decode_Pet(input, sizeof(input), &pet, &decode_len), "");
+	zcbor_trace_stop();
+
+	/* The error comes from looking for a third name. */
+	zassert_equal(3, trace.next, NULL);
+	zassert_equal(ZCBOR_TRACE_ENTER, events[0].type, NULL);
+	zassert_equal(0, events[0].payload_offset, NULL);
+	zassert_equal(ZCBOR_TRACE_ERROR, events[1].type, NULL);
+	zassert_equal(ZCBOR_ERR_WRONG_TYPE, events[1].error, NULL);
+	zassert_equal(0, events[1].func_id, NULL);
+	zassert_equal(10, events[1].payload_offset, NULL);
+	zassert_equal(ZCBOR_TRACE_SUCCESS, events[2].type, NULL);
+	zassert_equal(events[0].func_id, events[2].func_id, NULL);
+	zassert_equal(sizeof(input), events[2].payload_offset, NULL);
+	zassert_equal(ZCBOR_TRACE_NONE, events[3].type, NULL);
+
+	/* Invalid species. The oldest events are overwritten. */
+	zcbor_trace_start(&trace, events, ARRAY_SIZE(events));
+	zassert_equal(ZCBOR_SUCCESS, cbor_decode_Pet(input, sizeof(input), &pet, &decode_len), "");
+	input[19] = 0x04;
+	zassert_equal(ZCBOR_ERR_WRONG_VALUE,
+		cbor_decode_Pet(input, sizeof(input), &pet, &decode_len), "");
+	zcbor_trace_stop();
+
+	size_t last = (trace.next - 1) % ARRAY_SIZE(events);
+
+	zassert_true(trace.next > ARRAY_SIZE(events), NULL);
+	zassert_equal(ZCBOR_TRACE_FAIL, events[last].type, NULL);
+	zassert_equal(ZCBOR_ERR_WRONG_VALUE, events[last].error, NULL);
+
+	/* Nothing is recorded after stopping. */
+	size_t next = trace.next;
+
+	zassert_equal(ZCBOR_ERR_WRONG_VALUE,
+		cbor_decode_Pet(input, sizeof(input), &pet, &decode_len), "");
+	zassert_equal(next, trace.next, NULL);
+}
+#endif
+
+/* Decode a CBOR sequence of 'Pet' instances with the generated sequence
+ * decoding function, and check that decoding stops at the end of the payload,
+ * at max_results, and at the first invalid element.
+ */
+ZTEST(cbor_decode_test3, test_pet_seq)
+{
+	struct Pet pets[4];
+	size_t num_pets;
+	size_t decode_len;
+	uint8_t input[] = {
+		0x83, 0x81, 0x63, 0x66, 0x6f, 0x6f,
+		0x48, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+		0x01,
+		0x83, 0x82, 0x63, 0x66, 0x6f, 0x6f, 0x63, 0x62, 0x61, 0x72,
+		0x48, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+		0x02,
+		0x83, 0x81, 0x63, 0x62, 0x61, 0x72,
+		0x48, 0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01,
+		0x03};
+	size_t first_len = 16;
+	size_t second_len = 20;
+
+	zassert_equal(ZCBOR_SUCCESS, cbor_decode_Pet_seq(input, sizeof(input),
+		pets, ZCBOR_ARRAY_SIZE(pets), &num_pets, &decode_len), NULL);
+	zassert_equal(3, num_pets, "%d\r\n", num_pets);
+	zassert_equal(sizeof(input), decode_len, NULL);
+	zassert_equal(1, pets[0].names_count, NULL);
+	zassert_mem_equal("foo", pets[0].names[0].value, 3, NULL);
+	zassert_equal(Pet_species_cat_c, pets[0].species_choice, NULL);
+	zassert_equal(2, pets[1].names_count, NULL);
+	zassert_equal(Pet_species_dog_c, pets[1].species_choice, NULL);
+	zassert_mem_equal("bar", pets[2].names[0].value, 3, NULL);
+	zassert_equal(Pet_species_other_c, pets[2].species_choice, NULL);
+
+	/* Stop at max_results. */
+	zassert_equal(ZCBOR_SUCCESS, cbor_decode_Pet_seq(input, sizeof(input),
+		pets, 2, &num_pets, &decode_len), NULL);
+	zassert_equal(2, num_pets, NULL);
+	zassert_equal(first_len + second_len, decode_len, NULL);
+
+	/* Stop at the first invalid element, keeping the ones before it. */
+	input[first_len + second_len - 1] = 0x04;
+	zassert_equal(ZCBOR_ERR_WRONG_VALUE, cbor_decode_Pet_seq(input, sizeof(input),
+		pets, ZCBOR_ARRAY_SIZE(pets), &num_pets, &decode_len), NULL);
+	zassert_equal(1, num_pets, NULL);
+	zassert_equal(first_len, decode_len, NULL);
+}
+
+
+struct pet_stream_ctx {
+	uint8_t birthday[8];
+	size_t num_chunks;
+	const uint8_t *next_section;
+	size_t next_section_len;
+};
+
+
+static bool pet_stream_cb(void *ctx, zcbor_state_t *state,
+		const struct zcbor_string_fragment *chunk)
+{
+	struct pet_stream_ctx *stream = ctx;
+
+	zassert_equal(sizeof(stream->birthday), chunk->total_len, NULL);
+	zassert_true(chunk->offset + chunk->fragment.len <= sizeof(stream->birthday), NULL);
+	memcpy(&stream->birthday[chunk->offset], chunk->fragment.value, chunk->fragment.len);
+	stream->num_chunks++;
+
+	if (((chunk->offset + chunk->fragment.len) < chunk->total_len)
+			&& (stream->next_section != NULL)) {
+		zcbor_update_state(state, stream->next_section, stream->next_section_len);
+		stream->next_section = NULL;
+	}
+	return true;
+}
+
+
+/* Decode a 'Pet' instance whose birthday (listed in --stream-bstr-types) is
+ * passed to a callback, both from a single payload section and split across two.
+ */
+ZTEST(cbor_decode_test3, test_pet_stream)
+{
+	struct Pet pet;
+	size_t decode_len;
+	uint8_t input[] = {
+		0x83, 0x82, 0x63, 0x66, 0x6f, 0x6f, 0x63, 0x62, 0x61, 0x72,
+		0x48, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+		0x02};
+	uint8_t exp_birthday[] = {1,2,3,4,5,6,7,8};
+	size_t split = 14; /* 3 bytes into the birthday. */
+	struct pet_stream_ctx stream = {0};
+
+	zassert_equal(ZCBOR_SUCCESS, cbor_decode_Pet_stream(input, sizeof(input), &pet,
+		&decode_len, pet_stream_cb, &stream), NULL);
+	zassert_equal(sizeof(input), decode_len, NULL);
+	zassert_equal(1, stream.num_chunks, NULL);
+	zassert_mem_equal(exp_birthday, stream.birthday, 8, NULL);
+	zassert_is_null(pet.birthday.value, NULL);
+	zassert_equal(8, pet.birthday.len, NULL);
+	zassert_equal(Pet_species_dog_c, pet.species_choice, NULL);
+
+	stream = (struct pet_stream_ctx){
+		.next_section = &input[split],
+		.next_section_len = sizeof(input) - split,
+	};
+	zassert_equal(ZCBOR_SUCCESS, cbor_decode_Pet_stream(input, split, &pet,
+		&decode_len, pet_stream_cb, &stream), NULL);
+	zassert_equal(sizeof(input) - split, decode_len, NULL);
+	zassert_equal(2, stream.num_chunks, NULL);
+	zassert_mem_equal(exp_birthday, stream.birthday, 8, NULL);
+	zassert_equal(2, pet.names_count, NULL);
+	zassert_mem_equal("bar", pet.names[1].value, 3, NULL);
+	zassert_equal(Pet_species_dog_c, pet.species_choice, NULL);
+
+	/* The callback doesn't provide the rest of the string. */
+	stream = (struct pet_stream_ctx){0};
+	zassert_equal(ZCBOR_ERR_NO_PAYLOAD, cbor_decode_Pet_stream(input, split, &pet,
+		&decode_len, pet_stream_cb, &stream), NULL);
+	zassert_equal(1, stream.num_chunks, NULL);
+}
+
+
 bool fuzz_one_input(const uint8_t *data, size_t size);
 
 #define FUZZ(x) fuzz_one_input(x, sizeof(x))
@@ -2796,4 +2796,32 @@ ZTEST(cbor_decode_test5, test_opt_union)
 }
 
 
+#ifdef TEST_COMPACT_TYPES
+ZTEST(cbor_decode_test5, test_compact_types)
+{
+	const uint8_t payload_map[] = {
+		MAP(4), LIST(2), 0x05, 0x06, END 0xF5, // [5,6] => true
+		0x27, 0x01, // -8 => 1
+		0xf6, 0x41, 'a', // nil => "a"
+		0xf6, 0x41, 'b', // nil => "b"
+		END
+	};
+	struct Map map;
+	struct QuantityRange qr;
+
+	/* Choices and counts with a known maximum use the smallest integer types. */
+	zassert_equal(1, sizeof(map.Union_choice), NULL);
+	zassert_equal(1, sizeof(map.twotothree_count), NULL);
+	zassert_equal(1, sizeof(qr.upto4nils_count), NULL);
+	zassert_equal(sizeof(size_t), sizeof(qr.from3true_count), NULL);
+
+	zassert_equal(ZCBOR_SUCCESS, cbor_decode_Map(payload_map, sizeof(payload_map), &map, NULL), NULL);
+	zassert_equal(union_nint8uint_c, map.Union_choice, NULL);
+	zassert_equal(1, map.nint8uint, NULL);
+	zassert_equal(2, map.twotothree_count, NULL);
+	zassert_mem_equal("b", map.twotothree[1].twotothree.value, 1, NULL);
+}
+#endif
+
+
 ZTEST_SUITE(cbor_decode_test5, NULL, NULL, NULL, NULL, NULL);
@@ -859,4 +859,45 @@ ZTEST(cbor_decode_test8, test_manifest12_crash23)
 	FUZZ(crash_vector23);
 }
 
+#ifdef MANIFEST12_DECODE_PROFILE_LEN
+ZTEST(cbor_decode_test8, test_profile)
+{
+	struct SUIT_Envelope result;
+	size_t payload_len_out;
+	const struct zcbor_profile_entry *top = NULL;
+	uint64_t self_ticks = 0;
+	size_t called = 0;
+
+	manifest12_decode_profile_reset();
+	cbor_decode_SUIT_Envelope_Tagged(crash_vector0, sizeof(crash_vector0),
+		&result, &payload_len_out);
+
+	for (size_t i = 0; i < MANIFEST12_DECODE_PROFILE_LEN; i++) {
+		const struct zcbor_profile_entry *entry = &manifest12_decode_profile[i];
+
+		zassert_true(entry->ticks >= entry->self_ticks, "%s", entry->rule);
+		self_ticks += entry->self_ticks;
+		called += (entry->calls > 0);
+		if (!strcmp(entry->rule, "SUIT_Envelope_Tagged")) {
+			top = entry;
+		}
+	}
+	zassert_not_null(top);
+	zassert_equal(1, top->calls);
+	zassert_true(called > 1);
+
+	/* The time spent in each rule itself adds up to the time of the outermost call. */
+	zassert_equal(top->ticks, self_ticks);
+
+	manifest12_decode_profile_dump();
+	manifest12_decode_profile_reset();
+
+	for (size_t i = 0; i < MANIFEST12_DECODE_PROFILE_LEN; i++) {
+		zassert_equal(0, manifest12_decode_profile[i].calls);
+		zassert_equal(0, manifest12_decode_profile[i].ticks);
+		zassert_equal(0, manifest12_decode_profile[i].self_ticks);
+	}
+}
+#endif
+
 ZTEST_SUITE(cbor_decode_test8, NULL, NULL, NULL, NULL, NULL);
@@ -86,6 +86,38 @@ ZTEST(cbor_decode_testA, test_unordered_map1)
 	zassert_equal(ZCBOR_ERR_ELEMS_NOT_PROCESSED, err, "%s\n", zcbor_error_str(err));
 }
 
+/* Decode with a caller-provided state array instead of one on the stack. */
+ZTEST(cbor_decode_testA, test_unordered_map1_external_states)
+{
+	const uint8_t payload_unordered_map1_2[] = {
+		MAP(5),
+		2, 0x63, 't', 'w', 'o',
+		3, 0x40,
+		1, 0x63, 'o', 'n', 'e',
+		0x63, 'b', 'a', 'z', 0x63, 'b', 'o', 'z',
+		0x63, 'f', 'o', 'o', 0x63, 'b', 'a', 'r',
+		END
+	};
+	static zcbor_state_t states[CBOR_DECODE_UNORDEREDMAP1_NUM_STATES];
+	struct UnorderedMap1 unordered_map1;
+	size_t payload_len_out;
+
+	int err = cbor_decode_UnorderedMap1_with_states(payload_unordered_map1_2,
+			sizeof(payload_unordered_map1_2), &unordered_map1, &payload_len_out,
+			states, ZCBOR_ARRAY_SIZE(states));
+	zassert_equal(ZCBOR_SUCCESS, err, "%s %d\n", zcbor_error_str(err), err);
+	zassert_equal(sizeof(payload_unordered_map1_2), payload_len_out);
+	zassert_equal(3, unordered_map1.UnorderedMap1_intbstr_key);
+	zassert_equal(0, unordered_map1.UnorderedMap1_intlist_m_count);
+
+	/* Too few states. */
+	err = cbor_decode_UnorderedMap1_with_states(payload_unordered_map1_2,
+			sizeof(payload_unordered_map1_2), &unordered_map1, &payload_len_out,
+			states, ZCBOR_ARRAY_SIZE(states) - 1);
+	zassert_equal(ZCBOR_ERR_NO_BACKUP_MEM, err, "%s\n", zcbor_error_str(err));
+}
+
+
 ZTEST(cbor_decode_testA, test_unordered_map2)
 {
 	const uint8_t payload_unordered_map2_1[] = {
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zcbor_common.h>
+#include "pet_decode.h"
+#include "pet_encode.h"
+#include "corner_cases_decode.h"
+#include <common_test.h>
+
+
+ZTEST(cbor_decode_testB, test_pet)
+{
+	struct zcbor_string names[] = {
+		{.value = (const uint8_t *)"Foo", .len = 3},
+		{.value = (const uint8_t *)"Bar", .len = 3},
+	};
+	const uint8_t timestamp[] = {1, 2, 3, 4, 5, 6, 7, 8};
+	struct Pet pet_in = {
+		.names = names,
+		.names_count = 2,
+		.birthday = {.value = timestamp, .len = sizeof(timestamp)},
+		.species_choice = Pet_species_dog_c,
+	};
+	struct Pet pet;
+	uint8_t payload[50];
+	size_t payload_len;
+	_Alignas(ZCBOR_ARENA_ALIGN) uint8_t arena_buf[200];
+	struct zcbor_arena arena;
+	int err;
+
+	zassert_equal(ZCBOR_SUCCESS, cbor_encode_Pet(payload, sizeof(payload), &pet_in, &payload_len), NULL);
+
+	/* The counting pass finds the exact arena size, but doesn't store the names. */
+	zcbor_arena_count_init(&arena, arena_buf, sizeof(arena_buf));
+	err = cbor_decode_Pet(payload, payload_len, &pet, NULL, &arena);
+	zassert_equal(ZCBOR_SUCCESS, err, "%d\r\n", err);
+	zassert_equal(2, pet.names_count, NULL);
+	zassert_is_null(pet.names, NULL);
+	zassert_true(arena.peak >= (2 * sizeof(struct zcbor_string)), "%zu\r\n", arena.peak);
+	zassert_equal(0, arena.peak % ZCBOR_ARENA_ALIGN, NULL);
+
+	zcbor_arena_init(&arena, arena_buf, arena.peak);
+	err = cbor_decode_Pet(payload, payload_len, &pet, NULL, &arena);
+	zassert_equal(ZCBOR_SUCCESS, err, "%d\r\n", err);
+	zassert_equal(2, pet.names_count, NULL);
+	zassert_equal_ptr(arena_buf, pet.names, NULL);
+	zassert_mem_equal("Foo", pet.names[0].value, 3, NULL);
+	zassert_mem_equal("Bar", pet.names[1].value, 3, NULL);
+	zassert_equal(2 * sizeof(struct zcbor_string), arena.used, NULL);
+	zassert_equal(0, arena.scratch, NULL);
+	zassert_equal(Pet_species_dog_c, pet.species_choice, NULL);
+
+	zcbor_arena_init(&arena, arena_buf, arena.peak - ZCBOR_ARENA_ALIGN);
+	err = cbor_decode_Pet(payload, payload_len, &pet, NULL, &arena);
+	zassert_equal(ZCBOR_ERR_NO_ARENA_MEM, err, "%d\r\n", err);
+
+	err = cbor_decode_Pet(payload, payload_len, &pet, NULL, NULL);
+	zassert_equal(ZCBOR_ERR_NO_ARENA_MEM, err, "%d\r\n", err);
+}
+
+
+/* Indefinite length strings with several chunks are coalesced into the arena. */
+ZTEST(cbor_decode_testB, test_pet_indefinite_strings)
+{
+	const uint8_t payload[] = {
+		LIST(3),
+			LIST(2),
+				0x7F, 0x62, 'F', 'o', 0x61, 'o', 0xFF,
+				0x7F, 0x60, 0x63, 'B', 'a', 'r', 0xFF,
+			END
+			0x5F, 0x44, 1, 2, 3, 4, 0x44, 5, 6, 7, 8, 0xFF,
+			0x02,
+		END
+	};
+	_Alignas(ZCBOR_ARENA_ALIGN) uint8_t arena_buf[200];
+	struct zcbor_arena arena;
+	struct Pet pet;
+	int err;
+
+	zcbor_arena_count_init(&arena, arena_buf, sizeof(arena_buf));
+	err = cbor_decode_Pet(payload, sizeof(payload), &pet, NULL, &arena);
+#ifdef ZCBOR_CANONICAL
+	/* Indefinite length strings are not canonical. */
+	zassert_not_equal(ZCBOR_SUCCESS, err, NULL);
+#else
+	const uint8_t timestamp[] = {1, 2, 3, 4, 5, 6, 7, 8};
+
+	zassert_equal(ZCBOR_SUCCESS, err, "%d\r\n", err);
+	zassert_is_null(pet.birthday.value, NULL);
+	zassert_equal(sizeof(timestamp), pet.birthday.len, NULL);
+
+	zcbor_arena_init(&arena, arena_buf, arena.peak);
+	err = cbor_decode_Pet(payload, sizeof(payload), &pet, NULL, &arena);
+	zassert_equal(ZCBOR_SUCCESS, err, "%d\r\n", err);
+	zassert_equal(2, pet.names_count, NULL);
+	zassert_equal(3, pet.names[0].len, NULL);
+	zassert_mem_equal("Foo", pet.names[0].value, 3, NULL);
+	zassert_equal_ptr(arena_buf, pet.names[0].value, NULL);
+	/* A single non-empty chunk is not copied. */
+	zassert_equal(3, pet.names[1].len, NULL);
+	zassert_equal_ptr(&payload[12], pet.names[1].value, NULL);
+	zassert_equal(sizeof(timestamp), pet.birthday.len, NULL);
+	zassert_mem_equal(timestamp, pet.birthday.value, sizeof(timestamp), NULL);
+	zassert_true(arena.used >= ((2 * sizeof(struct zcbor_string)) + 3 + sizeof(timestamp)), NULL);
+
+	err = cbor_decode_Pet(payload, sizeof(payload), &pet, NULL, NULL);
+	zassert_equal(ZCBOR_ERR_NO_ARENA_MEM, err, "%d\r\n", err);
+#endif
+}
+
+
+ZTEST(cbor_decode_testB, test_level1)
+{
+	const uint8_t payload_level1[] = {
+		LIST(1), LIST(2),
+			LIST(4), LIST(1), 0, END LIST(1), 0, END LIST(1), 0, END LIST(1), 0, END END
+			LIST(5), LIST(1), 0, END LIST(1), 0, END LIST(1), 0, END LIST(1), 0, END
+				LIST(1), 0, END END
+		END END
+	};
+	_Alignas(ZCBOR_ARENA_ALIGN) uint8_t arena_buf[200];
+	struct zcbor_arena arena;
+	struct Level2 level1;
+	int err;
+
+	zcbor_arena_init(&arena, arena_buf, sizeof(arena_buf));
+	err = cbor_decode_Level1(payload_level1, sizeof(payload_level1), &level1, NULL, &arena);
+	zassert_equal(ZCBOR_SUCCESS, err, "%d\r\n", err);
+	zassert_equal(2, level1.Level3_m_count, NULL);
+	zassert_equal(4, level1.Level3_m[0].Level4_m_count, NULL);
+	zassert_equal(5, level1.Level3_m[1].Level4_m_count, NULL);
+}
+
+
+ZTEST(cbor_decode_testB, test_nested_list_map)
+{
+	const uint8_t payload_nested_lm1[] = {LIST(0), END};
+	const uint8_t payload_nested_lm5[] = {LIST(2), MAP(0), END MAP(1), 0x01, 0x04, END END};
+	const uint8_t payload_nested_lm6_inv[] = {LIST(2), MAP(0), END MAP(1), 0x04, END END};
+	_Alignas(ZCBOR_ARENA_ALIGN) uint8_t arena_buf[200];
+	struct zcbor_arena arena;
+	struct NestedListMap listmap;
+
+	zcbor_arena_init(&arena, arena_buf, sizeof(arena_buf));
+	zassert_equal(ZCBOR_SUCCESS, cbor_decode_NestedListMap(payload_nested_lm1,
+			sizeof(payload_nested_lm1), &listmap, NULL, &arena), NULL);
+	zassert_equal(0, listmap.map_count, NULL);
+	zassert_is_null(listmap.map, NULL);
+	zassert_equal(0, arena.used, NULL);
+
+	/* Consecutive results are placed after each other in the arena. */
+	zassert_equal(ZCBOR_SUCCESS, cbor_decode_NestedListMap(payload_nested_lm5,
+			sizeof(payload_nested_lm5), &listmap, NULL, &arena), NULL);
+	zassert_equal(2, listmap.map_count, NULL);
+	zassert_false(listmap.map[0].uint4_present, NULL);
+	zassert_true(listmap.map[1].uint4_present, NULL);
+	zassert_equal(ZCBOR_SUCCESS, cbor_decode_NestedListMap(payload_nested_lm5,
+			sizeof(payload_nested_lm5), &listmap, NULL, &arena), NULL);
+	zassert_equal(2, listmap.map_count, NULL);
+	zassert_true(listmap.map[1].uint4_present, NULL);
+	zassert_equal_ptr(&arena_buf[arena.used / 2], listmap.map, NULL);
+
+	zassert_not_equal(ZCBOR_SUCCESS, cbor_decode_NestedListMap(payload_nested_lm6_inv,
+			sizeof(payload_nested_lm6_inv), &listmap, NULL, &arena), NULL);
+	zassert_equal(0, arena.scratch, NULL);
+}
+
+ZTEST_SUITE(cbor_decode_testB, NULL, NULL, NULL, NULL, NULL);
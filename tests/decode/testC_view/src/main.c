@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zcbor_common.h>
+#include "pet_decode.h"
+#include "pet_encode.h"
+#include "corner_cases_decode.h"
+#include <common_test.h>
+
+
+ZTEST(cbor_decode_testC, test_pet)
+{
+	struct zcbor_string names[] = {
+		{.value = (const uint8_t *)"Foo", .len = 3},
+		{.value = (const uint8_t *)"Bar", .len = 3},
+	};
+	const uint8_t timestamp[] = {1, 2, 3, 4, 5, 6, 7, 8};
+	struct Pet pet_in = {
+		.names = {names[0], names[1]},
+		.names_count = 2,
+		.birthday = {.value = timestamp, .len = sizeof(timestamp)},
+		.species_choice = Pet_species_dog_c,
+	};
+	struct Pet pet;
+	struct Pet_view view;
+	struct Pet_view_name name;
+	struct Pet_view_birthday birthday;
+	struct Pet_view_species species;
+	uint8_t payload[50];
+	uint8_t payload_copy[50];
+	size_t payload_len;
+	size_t view_len;
+	int err;
+
+	zassert_equal(ZCBOR_SUCCESS, cbor_encode_Pet(payload, sizeof(payload), &pet_in, &payload_len), NULL);
+
+	err = cbor_decode_Pet_view(payload, payload_len, &view, &view_len);
+	zassert_equal(ZCBOR_SUCCESS, err, "%d\r\n", err);
+	zassert_equal(payload_len, view_len, NULL);
+	zassert_equal_ptr(payload, view.raw.value, NULL);
+	zassert_equal(payload_len, view.raw.len, NULL);
+
+	/* Each member is decoded into its own struct, with the same variables as in struct Pet. */
+	err = cbor_decode_Pet_view_birthday(&view, &birthday);
+	zassert_equal(ZCBOR_SUCCESS, err, "%d\r\n", err);
+	zassert_equal(sizeof(timestamp), birthday.birthday.len, NULL);
+	zassert_mem_equal(timestamp, birthday.birthday.value, sizeof(timestamp), NULL);
+	zassert_true(sizeof(birthday) < sizeof(pet), NULL);
+
+	err = cbor_decode_Pet_view_species(&view, &species);
+	zassert_equal(ZCBOR_SUCCESS, err, "%d\r\n", err);
+	zassert_equal(Pet_species_dog_c, species.species_choice, NULL);
+
+	/* The positions are relative to the encoded value, so they are still valid for a copy. */
+	memcpy(payload_copy, view.raw.value, view.raw.len);
+	memset(payload, 0xFF, sizeof(payload));
+	view.raw.value = payload_copy;
+	err = cbor_decode_Pet_view_name(&view, &name);
+	zassert_equal(ZCBOR_SUCCESS, err, "%d\r\n", err);
+	zassert_equal(2, name.names_count, NULL);
+	zassert_mem_equal("Foo", name.names[0].value, 3, NULL);
+	zassert_mem_equal("Bar", name.names[1].value, 3, NULL);
+	zassert_equal_ptr(&payload_copy[3], name.names[0].value, NULL);
+
+	view.raw.len = 2;
+	err = cbor_decode_Pet_view_species(&view, &species);
+	zassert_equal(ZCBOR_ERR_NO_PAYLOAD, err, "%d\r\n", err);
+
+	/* The whole payload is validated, like when decoding it. */
+	payload_copy[payload_len - 1] = 4;
+	err = cbor_decode_Pet_view(payload_copy, payload_len, &view, NULL);
+	zassert_not_equal(ZCBOR_SUCCESS, err, NULL);
+	zassert_equal(cbor_decode_Pet(payload_copy, payload_len, &pet, NULL), err, "%d\r\n", err);
+}
+
+
+ZTEST(cbor_decode_testC, test_number_map)
+{
+	const uint8_t payload_number_map1[] = {
+		MAP(3),
+			0x64, 'b', 'y', 't', 'e',
+			0x18, 42,
+			0x69, 'o', 'p', 't', '_', 's', 'h', 'o', 'r', 't',
+			0x19, 0x12, 0x34,
+			0x68, 'o', 'p', 't', '_', 'c', 'b', 'o', 'r',
+			0x45, 0x1A, 0x12, 0x34, 0x56, 0x78,
+		END
+	};
+	const uint8_t payload_number_map2[] = {
+		MAP(2),
+			0x64, 'b', 'y', 't', 'e',
+			0x04,
+			0x68, 'o', 'p', 't', '_', 'c', 'b', 'o', 'r',
+			0x45, 0x1A, 0x12, 0x34, 0x56, 0x78,
+		END
+	};
+	const uint8_t payload_number_map3_inv[] = {
+		MAP(2),
+			0x64, 'b', 'y', 't', 'e',
+			0x18, 42,
+			0x69, 'o', 'p', 't', '_', 's', 'h', 'o', 'r', 't',
+			0x1A, 0x12, 0x34, 0x56, 0x78,
+		END
+	};
+	struct NumberMap_view view;
+	struct NumberMap number_map;
+	struct NumberMap_view_byte byte;
+	struct NumberMap_view_opt_short opt_short;
+	struct NumberMap_view_opt_cbor opt_cbor;
+
+	zassert_equal(ZCBOR_SUCCESS, cbor_decode_NumberMap_view(payload_number_map1,
+		sizeof(payload_number_map1), &view, NULL), NULL);
+	zassert_equal(sizeof(payload_number_map1), view.raw.len, NULL);
+	zassert_equal(ZCBOR_SUCCESS, cbor_decode_NumberMap_view_opt_cbor(&view, &opt_cbor), NULL);
+	zassert_true(opt_cbor.opt_cbor_present, NULL);
+	zassert_equal(0x12345678, opt_cbor.opt_cbor.opt_cbor_cbor, NULL);
+	zassert_equal(ZCBOR_SUCCESS, cbor_decode_NumberMap_view_opt_short(&view, &opt_short), NULL);
+	zassert_true(opt_short.opt_short_present, NULL);
+	zassert_equal(0x1234, opt_short.opt_short.opt_short, NULL);
+	zassert_equal(ZCBOR_SUCCESS, cbor_decode_NumberMap_view_byte(&view, &byte), NULL);
+	zassert_equal(42, byte.byte, NULL);
+
+	/* Optional members that are not present are reported as such. */
+	zassert_equal(ZCBOR_SUCCESS, cbor_decode_NumberMap_view(payload_number_map2,
+		sizeof(payload_number_map2), &view, NULL), NULL);
+	zassert_equal(ZCBOR_SUCCESS, cbor_decode_NumberMap_view_opt_short(&view, &opt_short), NULL);
+	zassert_false(opt_short.opt_short_present, NULL);
+	zassert_equal(ZCBOR_SUCCESS, cbor_decode_NumberMap_view_opt_cbor(&view, &opt_cbor), NULL);
+	zassert_true(opt_cbor.opt_cbor_present, NULL);
+	zassert_equal(0x12345678, opt_cbor.opt_cbor.opt_cbor_cbor, NULL);
+	zassert_equal(ZCBOR_SUCCESS, cbor_decode_NumberMap_view_byte(&view, &byte), NULL);
+	zassert_equal(4, byte.byte, NULL);
+
+	zassert_not_equal(ZCBOR_SUCCESS, cbor_decode_NumberMap_view(payload_number_map3_inv,
+		sizeof(payload_number_map3_inv), &view, NULL), NULL);
+	zassert_equal(cbor_decode_NumberMap(payload_number_map3_inv,
+		sizeof(payload_number_map3_inv), &number_map, NULL),
+		cbor_decode_NumberMap_view(payload_number_map3_inv,
+			sizeof(payload_number_map3_inv), &view, NULL), NULL);
+}
+
+ZTEST_SUITE(cbor_decode_testC, NULL, NULL, NULL, NULL, NULL);
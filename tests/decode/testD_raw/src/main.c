@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zcbor_common.h>
+#include "corner_cases_decode.h"
+#include "corner_cases_encode.h"
+#include <common_test.h>
+
+
+ZTEST(cbor_decode_testD, test_raw_forward)
+{
+	const uint8_t payload_raw_forward1[] = {
+		LIST(4),
+			0x05,
+			LIST(2), 0x61, 'x', 0xF5, END
+			MAP(2),
+				0x61, 'a', 0x18, 42,
+				0x61, 'b', LIST(2), 0x61, 'c', 0x62, 'd', 'e', END
+			END
+			0xD8, 0x20, 0x43, 1, 2, 3,
+		END
+	};
+	const uint8_t opaque_exp[] = {LIST(2), 0x61, 'x', 0xF5, END};
+	const uint8_t nested_exp[] = {
+		MAP(2),
+			0x61, 'a', 0x18, 42,
+			0x61, 'b', LIST(2), 0x61, 'c', 0x62, 'd', 'e', END
+		END
+	};
+	struct RawForward raw_forward;
+	struct RawForward raw_forward2;
+	uint8_t payload[50];
+	uint8_t payload2[50];
+	size_t payload_len;
+	size_t payload2_len;
+	int err;
+
+	err = cbor_decode_RawForward(payload_raw_forward1, sizeof(payload_raw_forward1),
+			&raw_forward, NULL);
+	zassert_equal(ZCBOR_SUCCESS, err, "%d\r\n", err);
+	zassert_equal(5, raw_forward.id, NULL);
+
+	/* The spans point into the payload, and contain the whole encoded values. */
+	zassert_equal_ptr(&payload_raw_forward1[2], raw_forward.opaque.value, NULL);
+	zassert_equal(sizeof(opaque_exp), raw_forward.opaque.len, NULL);
+	zassert_mem_equal(opaque_exp, raw_forward.opaque.value, sizeof(opaque_exp), NULL);
+	zassert_equal(sizeof(nested_exp), raw_forward.nested.len, NULL);
+	zassert_mem_equal(nested_exp, raw_forward.nested.value, sizeof(nested_exp), NULL);
+
+	/* The tag is part of the type, so only the tagged value is captured. */
+	zassert_equal(4, raw_forward.tagged.len, NULL);
+	zassert_mem_equal("\x43\x01\x02\x03", raw_forward.tagged.value, 4, NULL);
+
+	/* Forward the captured values with a new id, without decoding them. */
+	raw_forward.id = 6;
+	err = cbor_encode_RawForward(payload, sizeof(payload), &raw_forward, &payload_len);
+	zassert_equal(ZCBOR_SUCCESS, err, "%d\r\n", err);
+
+	err = cbor_decode_RawForward(payload, payload_len, &raw_forward2, NULL);
+	zassert_equal(ZCBOR_SUCCESS, err, "%d\r\n", err);
+	zassert_equal(6, raw_forward2.id, NULL);
+	zassert_mem_equal(opaque_exp, raw_forward2.opaque.value, sizeof(opaque_exp), NULL);
+	zassert_mem_equal(nested_exp, raw_forward2.nested.value, sizeof(nested_exp), NULL);
+	zassert_equal(4, raw_forward2.tagged.len, NULL);
+
+	err = cbor_encode_RawForward(payload2, sizeof(payload2), &raw_forward2, &payload2_len);
+	zassert_equal(ZCBOR_SUCCESS, err, "%d\r\n", err);
+	zassert_equal(payload_len, payload2_len, NULL);
+	zassert_mem_equal(payload, payload2, payload_len, NULL);
+
+	/* The spans are copied as-is, so the payload must have room for them. */
+	err = cbor_encode_RawForward(payload2, payload_len - 1, &raw_forward2, NULL);
+	zassert_equal(ZCBOR_ERR_NO_PAYLOAD, err, "%d\r\n", err);
+}
+
+
+ZTEST(cbor_decode_testD, test_raw_forward_inv)
+{
+	const uint8_t payload_raw_forward2_inv[] = {
+		LIST(4),
+			0x05,
+			0x61, 'x',
+			LIST(0), END
+			0xD8, 0x20, 0x43, 1, 2, 3,
+		END
+	};
+	const uint8_t payload_raw_forward3_inv[] = {
+		LIST(4),
+			0x05,
+			0x61, 'x',
+			MAP(0), END
+			0xD8, 0x21, 0x43, 1, 2, 3,
+		END
+	};
+	const uint8_t payload_raw_forward4_inv[] = {
+		LIST(4),
+			0x05,
+			0x62, 'x',
+		END
+	};
+	struct RawForward raw_forward;
+	int err;
+
+	/* Raw values are only checked for well-formedness, so this is accepted. */
+	err = cbor_decode_RawForward(payload_raw_forward2_inv, sizeof(payload_raw_forward2_inv),
+			&raw_forward, NULL);
+	zassert_equal(ZCBOR_SUCCESS, err, "%d\r\n", err);
+	zassert_equal(2, raw_forward.opaque.len, NULL);
+	zassert_equal(sizeof((uint8_t []){LIST(0), END}), raw_forward.nested.len, NULL);
+
+	/* Tags outside the raw values are still checked. */
+	err = cbor_decode_RawForward(payload_raw_forward3_inv, sizeof(payload_raw_forward3_inv),
+			&raw_forward, NULL);
+	zassert_equal(ZCBOR_ERR_WRONG_VALUE, err, "%d\r\n", err);
+
+	err = cbor_decode_RawForward(payload_raw_forward4_inv, sizeof(payload_raw_forward4_inv),
+			&raw_forward, NULL);
+	zassert_not_equal(ZCBOR_SUCCESS, err, NULL);
+}
+
+ZTEST_SUITE(cbor_decode_testD, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zcbor_common.h>
+#include "corner_cases_decode.h"
+#include "corner_cases_encode.h"
+#include <common_test.h>
+
+
+ZTEST(cbor_decode_testE, test_soa_records)
+{
+	const uint8_t payload_soa_records1[] = {
+		LIST(3),
+			LIST(3), 0x01, 0xFA, 0x3F, 0xC0, 0x00, 0x00, 0x61, 'a', END
+			LIST(4), 0x02, 0xFA, 0xC0, 0x00, 0x00, 0x00, 0x62, 'b', 'c', 0xF5, END
+			LIST(4), 0x18, 30, 0xFA, 0x41, 0xA2, 0x00, 0x00, 0x60, 0xF4, END
+		END
+	};
+	const uint8_t payload_soa_records2_inv[] = {
+		LIST(5),
+			LIST(3), 0x01, 0xFA, 0x3F, 0xC0, 0x00, 0x00, 0x60, END
+			LIST(3), 0x01, 0xFA, 0x3F, 0xC0, 0x00, 0x00, 0x60, END
+			LIST(3), 0x01, 0xFA, 0x3F, 0xC0, 0x00, 0x00, 0x60, END
+			LIST(3), 0x01, 0xFA, 0x3F, 0xC0, 0x00, 0x00, 0x60, END
+			LIST(3), 0x01, 0xFA, 0x3F, 0xC0, 0x00, 0x00, 0x60, END
+		END
+	};
+	struct SoaRecords records;
+	struct SoaRecords records2;
+	uint8_t payload[60];
+	size_t payload_len;
+	float temp_sum = 0;
+	int err;
+
+	memset(&records, 0xFF, sizeof(records));
+	err = cbor_decode_SoaRecords(payload_soa_records1, sizeof(payload_soa_records1),
+			&records, NULL);
+	zassert_equal(ZCBOR_SUCCESS, err, "%d\r\n", err);
+	zassert_equal(3, records.SoaRecord_m_count, NULL);
+	zassert_equal(1, records.SoaRecord_m.id[0], NULL);
+	zassert_equal(2, records.SoaRecord_m.id[1], NULL);
+	zassert_equal(30, records.SoaRecord_m.id[2], NULL);
+	zassert_mem_equal("bc", records.SoaRecord_m.name[1].value, 2, NULL);
+	zassert_equal(0, records.SoaRecord_m.name[2].len, NULL);
+
+	/* Each member is in its own array, so loops over it are contiguous. */
+	for (size_t i = 0; i < records.SoaRecord_m_count; i++) {
+		temp_sum += records.SoaRecord_m.temp[i];
+	}
+	zassert_equal(19.75f, temp_sum, NULL);
+
+	/* Bits are cleared for elements without the member. */
+	zassert_false(ZCBOR_SOA_PRESENT(records.SoaRecord_m.flag_present, 0), NULL);
+	zassert_true(ZCBOR_SOA_PRESENT(records.SoaRecord_m.flag_present, 1), NULL);
+	zassert_true(ZCBOR_SOA_PRESENT(records.SoaRecord_m.flag_present, 2), NULL);
+	zassert_true(records.SoaRecord_m.flag[1], NULL);
+	zassert_false(records.SoaRecord_m.flag[2], NULL);
+
+	err = cbor_encode_SoaRecords(payload, sizeof(payload), &records, &payload_len);
+	zassert_equal(ZCBOR_SUCCESS, err, "%d\r\n", err);
+	memset(&records2, 0, sizeof(records2));
+	err = cbor_decode_SoaRecords(payload, payload_len, &records2, NULL);
+	zassert_equal(ZCBOR_SUCCESS, err, "%d\r\n", err);
+	zassert_equal(3, records2.SoaRecord_m_count, NULL);
+	zassert_mem_equal(records.SoaRecord_m.id, records2.SoaRecord_m.id,
+			3 * sizeof(records.SoaRecord_m.id[0]), NULL);
+	zassert_mem_equal(records.SoaRecord_m.temp, records2.SoaRecord_m.temp,
+			3 * sizeof(records.SoaRecord_m.temp[0]), NULL);
+	zassert_equal(0x6, records2.SoaRecord_m.flag_present[0], NULL);
+
+	/* Only the elements that have the member encode it. */
+	records.SoaRecord_m.flag_present[0] = 0;
+	err = cbor_encode_SoaRecords(payload, sizeof(payload), &records, &payload_len);
+	zassert_equal(ZCBOR_SUCCESS, err, "%d\r\n", err);
+	err = cbor_decode_SoaRecords(payload, payload_len, &records2, NULL);
+	zassert_equal(ZCBOR_SUCCESS, err, "%d\r\n", err);
+	zassert_equal(0, records2.SoaRecord_m.flag_present[0], NULL);
+
+	records.SoaRecord_m_count = 5;
+	err = cbor_encode_SoaRecords(payload, sizeof(payload), &records, &payload_len);
+	zassert_equal(ZCBOR_ERR_ITERATIONS, err, "%d\r\n", err);
+
+	err = cbor_decode_SoaRecords(payload_soa_records2_inv, sizeof(payload_soa_records2_inv),
+			&records, NULL);
+	zassert_not_equal(ZCBOR_SUCCESS, err, NULL);
+}
+
+
+ZTEST(cbor_decode_testE, test_soa_map_records)
+{
+	const uint8_t payload_soa_map_records1[] = {
+		LIST(2),
+			MAP(2), 0x62, 'i', 'd', 0x01, 0x61, 'v', 0x39, 0x01, 0x00, END
+			MAP(2), 0x62, 'i', 'd', 0x02, 0x61, 'v', 0x19, 0x7F, 0xFF, END
+		END
+	};
+	const uint8_t payload_soa_map_records2_inv[] = {
+		LIST(2),
+			MAP(2), 0x62, 'i', 'd', 0x01, 0x61, 'v', 0x39, 0x01, 0x00, END
+			MAP(2), 0x62, 'i', 'd', 0x02, 0x61, 'v', 0x19, 0x80, 0x00, END
+		END
+	};
+	const uint8_t payload_soa_map_records3_inv[] = {
+		LIST(0),
+		END
+	};
+	struct SoaMapRecords records;
+	int err;
+
+	err = cbor_decode_SoaMapRecords(payload_soa_map_records1,
+			sizeof(payload_soa_map_records1), &records, NULL);
+	zassert_equal(ZCBOR_SUCCESS, err, "%d\r\n", err);
+	zassert_equal(2, records.SoaMapRecord_m_count, NULL);
+	zassert_equal(1, records.SoaMapRecord_m.id[0], NULL);
+	zassert_equal(2, records.SoaMapRecord_m.id[1], NULL);
+	zassert_equal(-257, records.SoaMapRecord_m.v[0], NULL);
+	zassert_equal(32767, records.SoaMapRecord_m.v[1], NULL);
+
+	err = cbor_decode_SoaMapRecords(payload_soa_map_records2_inv,
+			sizeof(payload_soa_map_records2_inv), &records, NULL);
+	zassert_not_equal(ZCBOR_SUCCESS, err, NULL);
+
+	err = cbor_decode_SoaMapRecords(payload_soa_map_records3_inv,
+			sizeof(payload_soa_map_records3_inv), &records, NULL);
+	zassert_equal(ZCBOR_ERR_ITERATIONS, err, "%d\r\n", err);
+}
+
+ZTEST_SUITE(cbor_decode_testE, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zcbor_common.h>
+#include "senml_decode.h"
+#include "senml_encode.h"
+#include "pet_decode.h"
+#include "pet_encode.h"
+#include "map_bstr_decode.h"
+#include "map_bstr_encode.h"
+
+#ifndef ZCBOR_CANONICAL
+#define TEST_INDEFINITE_LENGTH_ARRAYS
+#endif
+#include <common_test.h>
+
+
+ZTEST(cbor_decode_testF, test_senml)
+{
+	const uint8_t payload[] = {
+		LIST(2),
+			MAP(3),
+				0x21, 0x63, 'F', 'o', 'o', // bn => "Foo"
+				0x00, 0x63, 'B', 'a', 'r', // n => "Bar"
+				0x03, 0x62, 'h', 'i', // vs => "hi"
+			END
+			MAP(2),
+				0x00, 0x61, 'B', // n => "B"
+				0x63, 'x', 'y', 'z', 0x42, 0x01, 0x02, // "xyz" => h'0102'
+			END
+		END
+	};
+	struct lwm2m_senml senml;
+	struct record *record = &senml.lwm2m_senml_record_m[0];
+	struct key_value_pair_label *kvp;
+	uint8_t payload2[sizeof(payload) + 10];
+	size_t payload_len;
+	size_t payload2_len;
+	int err;
+
+	zassert_equal(8, sizeof(record->record_bn.record_bn), NULL);
+
+	err = cbor_decode_lwm2m_senml(payload, sizeof(payload), &senml, &payload_len);
+	zassert_equal(ZCBOR_SUCCESS, err, "%d\r\n", err);
+	zassert_equal(sizeof(payload), payload_len, NULL);
+	zassert_equal(2, senml.lwm2m_senml_record_m_count, NULL);
+
+	/* The offsets are relative to the start of the payload. */
+	zassert_true(record->record_bn_present, NULL);
+	zassert_equal(4, record->record_bn.record_bn.offset, NULL);
+	zassert_equal(3, record->record_bn.record_bn.len, NULL);
+	zassert_mem_equal("Foo", zcbor_string_off_ptr(payload, &record->record_bn.record_bn), 3, NULL);
+	zassert_true(record->record_n_present, NULL);
+	zassert_mem_equal("Bar", zcbor_string_off_ptr(payload, &record->record_n.record_n), 3, NULL);
+	zassert_true(record->record_union_present, NULL);
+	zassert_equal(union_vs_c, record->record_union.record_union_choice, NULL);
+	zassert_mem_equal("hi", zcbor_string_off_ptr(payload, &record->record_union.union_vs), 2, NULL);
+
+	record = &senml.lwm2m_senml_record_m[1];
+	zassert_false(record->record_bn_present, NULL);
+	zassert_mem_equal("B", zcbor_string_off_ptr(payload, &record->record_n.record_n), 1, NULL);
+	zassert_equal(1, record->record_key_value_pair_m_count, NULL);
+	kvp = &record->record_key_value_pair_m[0].record_key_value_pair_m;
+	zassert_equal(non_b_label_m_c, kvp->key_value_pair_label_key.label_choice, NULL);
+	zassert_equal(non_b_label_tstr_c,
+		kvp->key_value_pair_label_key.non_b_label_m.non_b_label_choice, NULL);
+	zassert_mem_equal("xyz", zcbor_string_off_ptr(payload,
+		&kvp->key_value_pair_label_key.non_b_label_m.non_b_label_tstr), 3, NULL);
+	zassert_equal(value_bstr_c, kvp->key_value_pair_label.value_choice, NULL);
+	zassert_equal(2, kvp->key_value_pair_label.value_bstr.len, NULL);
+	zassert_mem_equal("\x01\x02",
+		zcbor_string_off_ptr(payload, &kvp->key_value_pair_label.value_bstr), 2, NULL);
+
+	/* Encode it again, with the decoded payload as the base pointer. */
+	err = cbor_encode_lwm2m_senml(payload2, sizeof(payload2), &senml, &payload2_len, payload);
+	zassert_equal(ZCBOR_SUCCESS, err, "%d\r\n", err);
+	zassert_equal(sizeof(payload), payload2_len, NULL);
+	zassert_mem_equal(payload, payload2, payload2_len, NULL);
+}
+
+
+ZTEST(cbor_decode_testF, test_pet)
+{
+	const uint8_t strings[] = "FooBar\x01\x02\x03\x04\x05\x06\x07\x08";
+	struct Pet pet_in = {
+		.names = {{.offset = 0, .len = 3}, {.offset = 3, .len = 3}},
+		.names_count = 2,
+		.birthday = {.offset = 6, .len = 8},
+		.species_choice = Pet_species_dog_c,
+	};
+	const uint8_t exp_payload[] = {
+		LIST(3),
+			LIST(2),
+				0x63, 'F', 'o', 'o',
+				0x63, 'B', 'a', 'r',
+			END
+			0x48, 1, 2, 3, 4, 5, 6, 7, 8,
+			0x02,
+		END
+	};
+	struct Pet pet;
+	uint8_t payload[30];
+	size_t payload_len;
+	int err;
+
+	err = cbor_encode_Pet(payload, sizeof(payload), &pet_in, &payload_len, strings);
+	zassert_equal(ZCBOR_SUCCESS, err, "%d\r\n", err);
+	zassert_equal(sizeof(exp_payload), payload_len, NULL);
+	zassert_mem_equal(exp_payload, payload, payload_len, NULL);
+
+	err = cbor_decode_Pet(payload, payload_len, &pet, NULL);
+	zassert_equal(ZCBOR_SUCCESS, err, "%d\r\n", err);
+	zassert_equal(2, pet.names_count, NULL);
+	zassert_mem_equal("Bar", zcbor_string_off_ptr(payload, &pet.names[1]), 3, NULL);
+	zassert_equal(8, pet.birthday.len, NULL);
+	zassert_mem_equal(&strings[6], zcbor_string_off_ptr(payload, &pet.birthday), 8, NULL);
+
+	/* The .size check of the birthday still applies. */
+	pet_in.birthday.len = 7;
+	err = cbor_encode_Pet(payload, sizeof(payload), &pet_in, &payload_len, strings);
+	zassert_not_equal(ZCBOR_SUCCESS, err, NULL);
+}
+
+/* CBOR-encoded bstrs are kept as struct zcbor_string. */
+ZTEST(cbor_decode_testF, test_map_bstr)
+{
+	const uint8_t payload[] = {
+		MAP(3),
+			0x64, 't', 'e', 's', 't', 0x42, 0x01, 0x02,
+			0x65, 't', 'e', 's', 't', '2', 0xD9, 0x04, 0xD2, 0x41, 0x03,
+			LIST(1), 0x65, 't', 'e', 's', 't', '3', END
+			0x43, 0x19, 0x04, 0xD2,
+		END
+	};
+	struct map map;
+	uint8_t payload2[sizeof(payload) + 10];
+	size_t payload_len;
+	size_t payload2_len;
+	int err;
+
+	err = cbor_decode_map(payload, sizeof(payload), &map, &payload_len);
+	zassert_equal(ZCBOR_SUCCESS, err, "%d\r\n", err);
+	zassert_equal(sizeof(payload), payload_len, NULL);
+	zassert_equal(2, map.map_test.len, NULL);
+	zassert_mem_equal("\x01\x02", zcbor_string_off_ptr(payload, &map.map_test), 2, NULL);
+	zassert_equal(1, map.map_test2.len, NULL);
+	zassert_mem_equal("\x03", zcbor_string_off_ptr(payload, &map.map_test2), 1, NULL);
+	zassert_equal(3, map.map_test3_tstr_lbstr.len, NULL);
+	zassert_true((map.map_test3_tstr_lbstr.value > payload)
+		&& (map.map_test3_tstr_lbstr.value < &payload[sizeof(payload)]), NULL);
+	zassert_mem_equal("\x19\x04\xD2", map.map_test3_tstr_lbstr.value, 3, NULL);
+
+	err = cbor_encode_map(payload2, sizeof(payload2), &map, &payload2_len, payload);
+	zassert_equal(ZCBOR_SUCCESS, err, "%d\r\n", err);
+	zassert_equal(sizeof(payload), payload2_len, NULL);
+	zassert_mem_equal(payload, payload2, payload2_len, NULL);
+
+	/* Without a value, the contents are encoded from the CDDL. */
+	map.map_test3_tstr_lbstr.value = NULL;
+	err = cbor_encode_map(payload2, sizeof(payload2), &map, &payload2_len, payload);
+	zassert_equal(ZCBOR_SUCCESS, err, "%d\r\n", err);
+	zassert_mem_equal(payload, payload2, payload2_len, NULL);
+}
+
+ZTEST_SUITE(cbor_decode_testF, NULL, NULL, NULL, NULL, NULL);
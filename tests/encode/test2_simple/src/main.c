@@ -103,4 +103,92 @@ ZTEST(cbor_encode_test2, test_pet_raw)
 	zassert_mem_equal(exp_output, payload, sizeof(exp_output), NULL);
 }
 
+
+/* Encode two slices of a list of 'Pet' instances into separate buffers with
+ * the generated sequence encoding function, as separate threads might, then
+ * stitch them together behind a list header.
+ */
+ZTEST(cbor_encode_test2, test_pet_seq_chunks)
+{
+	struct Pet pets[3] = {
+		{
+			.names = {{.value = "foo", .len = 3}},
+			.names_count = 1,
+			.birthday = {.value = (uint8_t[]){1,2,3,4,5,6,7,8}, .len = 8},
+			.species_choice = Pet_species_cat_c
+		},
+		{
+			.names = {{.value = "foo", .len = 3}, {.value = "bar", .len = 3}},
+			.names_count = 2,
+			.birthday = {.value = (uint8_t[]){1,2,3,4,5,6,7,8}, .len = 8},
+			.species_choice = Pet_species_dog_c
+		},
+		{
+			.names = {{.value = "bar", .len = 3}},
+			.names_count = 1,
+			.birthday = {.value = (uint8_t[]){8,7,6,5,4,3,2,1}, .len = 8},
+			.species_choice = Pet_species_other_c
+		},
+	};
+	uint8_t exp_output[] = {
+		0x83,
+		LIST(3),
+		LIST(1),
+			0x63, 0x66, 0x6f, 0x6f, /* foo */
+		END
+		0x48, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+		0x01, /* 1: cat */
+		END
+		LIST(3),
+		LIST(2),
+			0x63, 0x66, 0x6f, 0x6f, /* foo */
+			0x63, 0x62, 0x61, 0x72, /* bar */
+		END
+		0x48, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+		0x02, /* 2: dog */
+		END
+		LIST(3),
+		LIST(1),
+			0x63, 0x62, 0x61, 0x72, /* bar */
+		END
+		0x48, 0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01,
+		0x03, /* 3: other */
+		END
+	};
+	uint8_t slice_bufs[2][50];
+	struct zcbor_string slices[2];
+	uint8_t output[sizeof(exp_output)];
+	size_t num_encoded;
+	ZCBOR_STATE_E(state, 0, output, sizeof(output), 0);
+
+	zassert_equal(ZCBOR_SUCCESS, cbor_encode_Pet_seq(slice_bufs[0], sizeof(slice_bufs[0]),
+		&pets[0], 1, &num_encoded, &slices[0].len), NULL);
+	zassert_equal(1, num_encoded, NULL);
+	zassert_equal(ZCBOR_SUCCESS, cbor_encode_Pet_seq(slice_bufs[1], sizeof(slice_bufs[1]),
+		&pets[1], 2, &num_encoded, &slices[1].len), NULL);
+	zassert_equal(2, num_encoded, NULL);
+
+	/* Room for the first pet only. All inputs must be encoded. */
+	zassert_equal(ZCBOR_ERR_NO_PAYLOAD, cbor_encode_Pet_seq(slice_bufs[1], slices[0].len,
+		&pets[0], 2, &num_encoded, &slices[1].len), NULL);
+	zassert_equal(1, num_encoded, NULL);
+	zassert_equal(slices[0].len, slices[1].len, NULL);
+
+	zassert_equal(ZCBOR_SUCCESS, cbor_encode_Pet_seq(slice_bufs[1], sizeof(slice_bufs[1]),
+		&pets[1], 2, &num_encoded, &slices[1].len), NULL);
+	slices[0].value = slice_bufs[0];
+	slices[1].value = slice_bufs[1];
+
+	/* Not enough room. Nothing is written. */
+	state->payload_end--;
+	zassert_false(zcbor_list_chunks_encode(state, 3, slices, 2), NULL);
+	zassert_equal_ptr(output, state->payload, NULL);
+	state->payload_end++;
+
+	zassert_true(zcbor_list_chunks_encode(state, 3, slices, 2), NULL);
+	zassert_equal(sizeof(exp_output), state->payload - output, "%d != %d\r\n",
+		sizeof(exp_output), state->payload - output);
+	zassert_mem_equal(exp_output, output, sizeof(exp_output), NULL);
+}
+
 ZTEST_SUITE(cbor_encode_test2, NULL, NULL, NULL, NULL, NULL);
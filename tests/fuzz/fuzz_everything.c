@@ -5,8 +5,8 @@ bool fuzz_one_input(const uint8_t *data, size_t size)
 {
     size_t payload_len_out = 0;
     struct EverythingUnion_r result;
-    bool ret = cbor_decode_EverythingUnion(data, size,
+    bool ret = fuzz_check_result(cbor_decode_EverythingUnion(data, size,
                                &result,
-                               &payload_len_out);
+                               &payload_len_out), size);
     return ret;
 }
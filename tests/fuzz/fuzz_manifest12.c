@@ -1,6 +1,17 @@
 #include "manifest12_decode.h"
 #include "main_entry.h"
 
+/* Decode a nested command sequence. The work budget is based on the length of
+ * the nested payload, so that is the size reported for pathological inputs. */
+static bool decode_command_seq(const struct zcbor_string *cbor,
+                               struct SUIT_Command_Sequence *command_seq)
+{
+    size_t payload_len_out = 0;
+
+    return fuzz_check_result(cbor_decode_SUIT_Command_Sequence(cbor->value, cbor->len,
+                               command_seq, &payload_len_out), cbor->len);
+}
+
 bool fuzz_one_input(const uint8_t *data, size_t size)
 {
     size_t payload_len_out = 0;
@@ -8,18 +19,19 @@ bool fuzz_one_input(const uint8_t *data, size_t size)
     struct SUIT_Envelope result2;
     struct SUIT_Command_Sequence command_seq;
 
-    bool ret = cbor_decode_SUIT_Envelope_Tagged(data, size,
+    bool ret = fuzz_check_result(cbor_decode_SUIT_Envelope_Tagged(data, size,
                                &result,
-                               &payload_len_out);
+                               &payload_len_out), size);
     if (!ret) {
         return ret;
     }
 
     for (int i = 0; i < result.SUIT_Envelope_suit_integrated_dependency_key_count; i++) {
-        ret = cbor_decode_SUIT_Envelope(
-            result.SUIT_Envelope_suit_integrated_dependency_key[i].SUIT_Envelope_suit_integrated_dependency_key.value,
-            result.SUIT_Envelope_suit_integrated_dependency_key[i].SUIT_Envelope_suit_integrated_dependency_key.len,
-            &result2, &payload_len_out);
+        const struct zcbor_string *dependency =
+            &result.SUIT_Envelope_suit_integrated_dependency_key[i].SUIT_Envelope_suit_integrated_dependency_key;
+
+        ret = fuzz_check_result(cbor_decode_SUIT_Envelope(dependency->value, dependency->len,
+            &result2, &payload_len_out), dependency->len);
         if (!ret) {
             return ret;
         }
@@ -28,16 +40,12 @@ bool fuzz_one_input(const uint8_t *data, size_t size)
     if (result.SUIT_Envelope_suit_manifest_cbor
               .SUIT_Manifest_SUIT_Severable_Manifest_Members_m
               .SUIT_Severable_Manifest_Members_suit_dependency_resolution_present) {
-        ret = cbor_decode_SUIT_Command_Sequence(
-            result.SUIT_Envelope_suit_manifest_cbor
-                .SUIT_Manifest_SUIT_Severable_Manifest_Members_m
-                .SUIT_Severable_Manifest_Members_suit_dependency_resolution
-                .SUIT_Severable_Manifest_Members_suit_dependency_resolution.value,
-            result.SUIT_Envelope_suit_manifest_cbor
+        ret = decode_command_seq(
+            &result.SUIT_Envelope_suit_manifest_cbor
                 .SUIT_Manifest_SUIT_Severable_Manifest_Members_m
                 .SUIT_Severable_Manifest_Members_suit_dependency_resolution
-                .SUIT_Severable_Manifest_Members_suit_dependency_resolution.len,
-            &command_seq, &payload_len_out);
+                .SUIT_Severable_Manifest_Members_suit_dependency_resolution,
+            &command_seq);
         if (!ret) {
             return ret;
         }
@@ -46,16 +54,12 @@ bool fuzz_one_input(const uint8_t *data, size_t size)
     if (result.SUIT_Envelope_suit_manifest_cbor
               .SUIT_Manifest_SUIT_Severable_Manifest_Members_m
               .SUIT_Severable_Manifest_Members_suit_payload_fetch_present) {
-        ret = cbor_decode_SUIT_Command_Sequence(
-            result.SUIT_Envelope_suit_manifest_cbor
-                .SUIT_Manifest_SUIT_Severable_Manifest_Members_m
-                .SUIT_Severable_Manifest_Members_suit_payload_fetch
-                .SUIT_Severable_Manifest_Members_suit_payload_fetch.value,
-            result.SUIT_Envelope_suit_manifest_cbor
+        ret = decode_command_seq(
+            &result.SUIT_Envelope_suit_manifest_cbor
                 .SUIT_Manifest_SUIT_Severable_Manifest_Members_m
                 .SUIT_Severable_Manifest_Members_suit_payload_fetch
-                .SUIT_Severable_Manifest_Members_suit_payload_fetch.len,
-            &command_seq, &payload_len_out);
+                .SUIT_Severable_Manifest_Members_suit_payload_fetch,
+            &command_seq);
         if (!ret) {
             return ret;
         }
@@ -64,16 +68,12 @@ bool fuzz_one_input(const uint8_t *data, size_t size)
     if (result.SUIT_Envelope_suit_manifest_cbor
               .SUIT_Manifest_SUIT_Severable_Manifest_Members_m
               .SUIT_Severable_Manifest_Members_suit_install_present) {
-        ret = cbor_decode_SUIT_Command_Sequence(
-            result.SUIT_Envelope_suit_manifest_cbor
-                .SUIT_Manifest_SUIT_Severable_Manifest_Members_m
-                .SUIT_Severable_Manifest_Members_suit_install
-                .SUIT_Severable_Manifest_Members_suit_install.value,
-            result.SUIT_Envelope_suit_manifest_cbor
+        ret = decode_command_seq(
+            &result.SUIT_Envelope_suit_manifest_cbor
                 .SUIT_Manifest_SUIT_Severable_Manifest_Members_m
                 .SUIT_Severable_Manifest_Members_suit_install
-                .SUIT_Severable_Manifest_Members_suit_install.len,
-            &command_seq, &payload_len_out);
+                .SUIT_Severable_Manifest_Members_suit_install,
+            &command_seq);
         if (!ret) {
             return ret;
         }
@@ -82,16 +82,12 @@ bool fuzz_one_input(const uint8_t *data, size_t size)
     if (result.SUIT_Envelope_suit_manifest_cbor
               .SUIT_Manifest_SUIT_Unseverable_Members_m
               .SUIT_Unseverable_Members_suit_validate_present) {
-        ret = cbor_decode_SUIT_Command_Sequence(
-            result.SUIT_Envelope_suit_manifest_cbor
-                .SUIT_Manifest_SUIT_Unseverable_Members_m
-                .SUIT_Unseverable_Members_suit_validate
-                .SUIT_Unseverable_Members_suit_validate.value,
-            result.SUIT_Envelope_suit_manifest_cbor
+        ret = decode_command_seq(
+            &result.SUIT_Envelope_suit_manifest_cbor
                 .SUIT_Manifest_SUIT_Unseverable_Members_m
                 .SUIT_Unseverable_Members_suit_validate
-                .SUIT_Unseverable_Members_suit_validate.len,
-            &command_seq, &payload_len_out);
+                .SUIT_Unseverable_Members_suit_validate,
+            &command_seq);
         if (!ret) {
             return ret;
         }
@@ -100,16 +96,12 @@ bool fuzz_one_input(const uint8_t *data, size_t size)
     if (result.SUIT_Envelope_suit_manifest_cbor
               .SUIT_Manifest_SUIT_Unseverable_Members_m
               .SUIT_Unseverable_Members_suit_load_present) {
-        ret = cbor_decode_SUIT_Command_Sequence(
-            result.SUIT_Envelope_suit_manifest_cbor
+        ret = decode_command_seq(
+            &result.SUIT_Envelope_suit_manifest_cbor
                 .SUIT_Manifest_SUIT_Unseverable_Members_m
                 .SUIT_Unseverable_Members_suit_load
-                .SUIT_Unseverable_Members_suit_load.value,
-            result.SUIT_Envelope_suit_manifest_cbor
-                .SUIT_Manifest_SUIT_Unseverable_Members_m
-                .SUIT_Unseverable_Members_suit_load
-                .SUIT_Unseverable_Members_suit_load.len,
-            &command_seq, &payload_len_out);
+                .SUIT_Unseverable_Members_suit_load,
+            &command_seq);
         if (!ret) {
             return ret;
         }
@@ -118,16 +110,12 @@ bool fuzz_one_input(const uint8_t *data, size_t size)
     if (result.SUIT_Envelope_suit_manifest_cbor
               .SUIT_Manifest_SUIT_Unseverable_Members_m
               .SUIT_Unseverable_Members_suit_run_present) {
-        ret = cbor_decode_SUIT_Command_Sequence(
-            result.SUIT_Envelope_suit_manifest_cbor
-                .SUIT_Manifest_SUIT_Unseverable_Members_m
-                .SUIT_Unseverable_Members_suit_run
-                .SUIT_Unseverable_Members_suit_run.value,
-            result.SUIT_Envelope_suit_manifest_cbor
+        ret = decode_command_seq(
+            &result.SUIT_Envelope_suit_manifest_cbor
                 .SUIT_Manifest_SUIT_Unseverable_Members_m
                 .SUIT_Unseverable_Members_suit_run
-                .SUIT_Unseverable_Members_suit_run.len,
-            &command_seq, &payload_len_out);
+                .SUIT_Unseverable_Members_suit_run,
+            &command_seq);
         if (!ret) {
             return ret;
         }
@@ -0,0 +1,12 @@
+#include "unordered_map_decode.h"
+#include "main_entry.h"
+
+bool fuzz_one_input(const uint8_t *data, size_t size)
+{
+    size_t payload_len_out = 0;
+    struct UnorderedMap1 result;
+    bool ret = fuzz_check_result(cbor_decode_UnorderedMap1(data, size,
+                               &result,
+                               &payload_len_out), size);
+    return ret;
+}
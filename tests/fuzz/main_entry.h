@@ -1,5 +1,30 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <zcbor_common.h>
+
+#ifdef ZCBOR_WORK_BUDGET
+#include <stdio.h>
+#include <stdlib.h>
+#endif
 
 bool fuzz_one_input(const uint8_t *data, size_t size);
+
+/* Check the result of decoding @p size bytes of fuzz input.
+ * When ZCBOR_WORK_BUDGET is defined, an input that uses up the work budget
+ * takes disproportionately long to decode for its size, so it is reported
+ * like a crash, which makes the fuzzer save it. */
+static inline int fuzz_check_result(int err, size_t size)
+{
+#ifdef ZCBOR_WORK_BUDGET
+	if (err == ZCBOR_ERR_WORK_BUDGET) {
+		fprintf(stderr, "Pathological input: decoding used up the work budget "
+			"(%u steps per byte) on an input of %zu bytes.\n",
+			(unsigned int)ZCBOR_WORK_BUDGET_PER_BYTE, size);
+		abort();
+	}
+#else
+	(void)size;
+#endif
+	return err;
+}
@@ -4,7 +4,7 @@
 # SPDX-License-Identifier: Apache-2.0
 #
 
-echo "Usage: $0 <seconds to run> <bit width> <test case>"
+echo "Usage: $0 <seconds to run> <bit width> <test case> [work budget per byte]"
 
 # For convenience (use for extra checks):
 # export AFL_USE_ASAN=1
@@ -14,7 +14,7 @@ export AFL_I_DONT_CARE_ABOUT_MISSING_CRASHES=1
 if [ -d "build-afl" ]; then rm -r build-afl; fi
 mkdir build-afl
 pushd build-afl
-cmake .. -DCMAKE_C_COMPILER=afl-clang-fast -DCMAKE_C_FLAGS="-m$2" -DTEST_CASE=$3
+cmake .. -DCMAKE_C_COMPILER=afl-clang-fast -DCMAKE_C_FLAGS="-m$2" -DTEST_CASE=$3 ${4:+-DWORK_BUDGET_PER_BYTE=$4}
 [[ $? -ne 0 ]] && exit 1
 make fuzz_target
 [[ $? -ne 0 ]] && exit 1
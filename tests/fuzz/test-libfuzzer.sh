@@ -7,7 +7,7 @@
 if [ -d "build-libfuzzer" ]; then rm -r build-libfuzzer; fi
 mkdir build-libfuzzer
 pushd build-libfuzzer
-cmake .. -DCMAKE_C_COMPILER=clang -DCMAKE_C_FLAGS="-fsanitize=fuzzer,address -DLIBFUZZER" -DCMAKE_C_COMPILER_WORKS=On -DTEST_CASE=manifest12
+cmake .. -DCMAKE_C_COMPILER=clang -DCMAKE_C_FLAGS="-fsanitize=fuzzer,address -DLIBFUZZER" -DCMAKE_C_COMPILER_WORKS=On -DTEST_CASE=manifest12 ${2:+-DWORK_BUDGET_PER_BYTE=$2}
 [[ $? -ne 0 ]] && exit 1
 make fuzz_target
 [[ $? -ne 0 ]] && exit 1
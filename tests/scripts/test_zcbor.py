@@ -16,6 +16,7 @@ from yaml import safe_load, safe_dump
 from tempfile import mkdtemp, NamedTemporaryFile
 from shutil import rmtree
 from os import linesep
+import struct
 
 try:
     import zcbor
@@ -1802,6 +1803,60 @@ class TestFuncPointer(PopenTest, TempdTest):
         check_file(output_c_e, "encode")
 
 
+class TestTrace(PopenTest, TempdTest):
+    def test_trace(self):
+        types = ["NestedListMap", "NumberMap", "Union", "Choice3"]
+        # The ids depend on the generated functions, so use options that add functions.
+        # fmt: off
+        self.popen_test(
+            ["zcbor", "code", "--cddl", p_corner_cases, "-t", *types, "-d",
+             "--raw-types", "any", "--view-entry-types", "NumberMap",
+             "--output-cmake", self.tempd / "trace.cmake",
+             "--output-trace-ids", self.tempd / "trace.json"]
+        )
+        # fmt: on
+        output_c = (self.tempd / "src" / "trace_decode.c").read_text()
+        func_ids = {
+            int(m.group("id")): m.group("func")
+            for m in compile(
+                r"static bool (?P<func>\w+)\(\n[^\n]*\n\{\n\tzcbor_log[^\n]*\n"
+                r"\tzcbor_trace_enter\(state, (?P<id>\d+)\);"
+            ).finditer(output_c)
+        }
+        self.assertGreater(len(func_ids), 5)
+        self.assertEqual(list(range(1, len(func_ids) + 1)), sorted(func_ids))
+
+        # A wrapped ring buffer with room for all the enter and exit events, and one error.
+        events = [(i, 1, func_id, 1, 0) for i, func_id in enumerate(func_ids)]
+        events += [(100, 0, 0, 4, 8)]
+        events += [(200 + i, 0, func_id, 3, 8) for i, func_id in enumerate(reversed(func_ids))]
+        next_event = len(events) + 5
+        start = next_event % len(events)
+        dump = b"".join(struct.pack("<IIHBb", *ev) for ev in events)
+        dump = dump[-start * 12 :] + dump[: -start * 12]
+        (self.tempd / "trace.bin").write_bytes(dump)
+
+        # fmt: off
+        stdout, _ = self.popen_test(
+            ["zcbor", "trace", "--trace-ids", self.tempd / "trace.json", "-d",
+             "-i", self.tempd / "trace.bin", "--next", str(next_event)]
+        )
+        # fmt: on
+        output = stdout.decode("utf-8")
+        lines = output.splitlines()
+        self.assertEqual(len(events), len(lines))
+        for index, (line, (offset, _, func_id, ev_type, _)) in enumerate(zip(lines, events), 5):
+            self.assertTrue(line.lstrip().startswith(f"{index} "), line)
+            self.assertIn(f"offset={offset} ", line)
+            if ev_type == 4:
+                self.assertIn("error   ZCBOR_ERR_NO_PAYLOAD ", line)
+            else:
+                self.assertIn(f" {func_ids[func_id]} ", line)
+        self.assertIn("enter   decode_NestedListMap (NestedListMap)", output)
+        self.assertIn(f"{'  ' * len(func_ids)}error   ZCBOR_ERR_NO_PAYLOAD", output)
+        self.assertIn("error=ZCBOR_ERR_NO_PAYLOAD", lines[-1])
+
+
 class TestControlGroups(TestCase):
     def test_single_member(self):
         """Test that control groups with a single member don't cause an exception,
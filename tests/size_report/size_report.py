@@ -0,0 +1,268 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+
+"""Report the code size, stack usage, state count, and struct sizes of generated code.
+
+This script has two commands:
+
+sizes-program: Write a C program that prints the sizeof of every generated struct, and the
+               number of states each entry function reserves.
+report:        Combine the output of that program with the -fstack-usage and -fcallgraph-info
+               output of the compiler and the symbol sizes from nm into a report per entry
+               function, and check the results against a budgets file.
+"""
+
+from argparse import ArgumentParser
+from collections import defaultdict
+from json import dump
+from pathlib import Path
+from re import compile, DOTALL, MULTILINE
+from subprocess import run
+from sys import exit, stderr
+from yaml import safe_load
+
+ENTRY_FUNC_RE = compile(r"^cbor_(de|en)code_\w+$")
+FUNC_DEF_RE = compile(r"^(?:static )?\w+ (\w+)\([^;{]*\)\n\{\n(.*?)^\}", MULTILINE | DOTALL)
+STRUCT_RE = compile(r"^struct (\w+) \{", MULTILINE)
+NUM_FLAGS_RE = compile(r"const size_t num_flags = (.*);")
+STATES_RE = compile(r"zcbor_state_t states\[(.*)\];")
+CI_NODE_RE = compile(r'node: \{ title: "([^"]*)" label: "([^"]*)"')
+CI_EDGE_RE = compile(r'edge: \{ sourcename: "([^"]*)" targetname: "([^"]*)"')
+CI_GRAPH_RE = compile(r'graph: \{ title: "([^"]*)"')
+INDIRECT_CALL = "__indirect_call"
+
+
+def generated_functions(c_file):
+    """Return a dict of the functions defined in a generated C file, with their bodies."""
+    return {m[1]: m[2] for m in FUNC_DEF_RE.finditer(Path(c_file).read_text(encoding="utf-8"))}
+
+
+def sizes_program(args):
+    """Write a C program that prints the struct sizes and state counts of a generated codec."""
+    lines = []
+    for header in args.types_h:
+        for struct in STRUCT_RE.findall(Path(header).read_text(encoding="utf-8")):
+            lines.append(f'\tprintf("struct %s %zu\\n", "{struct}", sizeof(struct {struct}));')
+    for c_file in args.c_file:
+        for func, body in generated_functions(c_file).items():
+            states = STATES_RE.search(body)
+            if not ENTRY_FUNC_RE.match(func) or not states:
+                continue
+            num_flags = NUM_FLAGS_RE.search(body)
+            lines.append("\t{")
+            if num_flags:
+                lines.append(f"\t\tconst size_t num_flags = {num_flags[1]};")
+            lines.append(f'\t\tprintf("states %s %zu\\n", "{func}", (size_t)({states[1]}));')
+            lines.append("\t}")
+    includes = "\n".join(f'#include "{Path(h).name}"' for h in args.types_h)
+    body = "\n".join(lines)
+    Path(args.output).write_text(
+        f"""/* Generated by {Path(__file__).name}. */
+
+#include <stdio.h>
+#include <zcbor_common.h>
+{includes}
+
+int main(void)
+{{
+\tprintf("state_size %zu\\n", sizeof(zcbor_state_t));
+{body}
+\treturn 0;
+}}
+""",
+        encoding="utf-8",
+    )
+
+
+class CallGraph:
+    """The functions of a set of object files, with their frame sizes, text sizes, and calls.
+
+    Functions are identified like in the .ci files: global functions by their name, and static
+    functions by "<source file>:<name>".
+    """
+
+    def __init__(self, nm):
+        self.nm = nm
+        self.frames = {}
+        self.text = {}
+        self.calls = defaultdict(set)
+        self.refs = {}  # Functions whose address is taken, per generated function.
+        self.stack_cache = {}
+
+    def add_object(self, obj, generated):
+        base = str(obj)[: -len(".o")] if str(obj).endswith(".o") else str(obj)
+        ci = Path(base + ".ci").read_text(encoding="utf-8")
+        source = CI_GRAPH_RE.search(ci)[1]
+        locations = {}
+        for title, label in CI_NODE_RE.findall(ci):
+            label_lines = label.split("\\n")
+            if len(label_lines) >= 3:  # Only functions defined in this file have a stack usage.
+                locations[f"{label_lines[1]}:{label_lines[0]}"] = title
+        for source_name, target_name in CI_EDGE_RE.findall(ci):
+            self.calls[source_name].add(target_name)
+
+        for line in Path(base + ".su").read_text(encoding="utf-8").splitlines():
+            location, frame, _ = line.split("\t")
+            self.frames[locations.get(location, location.split(":")[-1])] = int(frame)
+
+        nm_out = run([self.nm, "-S", "--defined-only", str(obj)], capture_output=True, check=True)
+        for line in nm_out.stdout.decode().splitlines():
+            fields = line.split()
+            if len(fields) == 4 and fields[2] in "tT":
+                name = fields[3] if fields[2] == "T" else f"{source}:{fields[3]}"
+                self.text[name] = int(fields[1], 16)
+
+        if generated:
+            funcs = generated_functions(source)
+            for func, body in funcs.items():
+                title = func if func in self.frames else f"{source}:{func}"
+                self.refs[title] = {
+                    (f if f in self.frames else f"{source}:{f}")
+                    for f in funcs
+                    if f != func and compile(rf"\b{f}\b").search(body)
+                }
+
+    def callees(self, func, targets):
+        """The functions called by func. Indirect calls can reach the functions whose address
+        was taken by the closest generated function up the call chain (targets)."""
+        for callee in self.calls[func]:
+            if callee == INDIRECT_CALL:
+                yield from targets
+            else:
+                yield callee
+
+    def max_stack(self, func, targets=frozenset(), path=()):
+        """Return the maximum stack usage of func, and whether it is recursive.
+
+        For recursive functions, the stack usage of one pass through the recursion is reported."""
+        if func in path:
+            return 0, True
+        targets = frozenset(self.refs.get(func, targets))
+        if (func, targets) not in self.stack_cache:
+            usage, recursive = 0, False
+            for callee in set(self.callees(func, targets)):
+                callee_usage, callee_recursive = self.max_stack(callee, targets, path + (func,))
+                usage = max(usage, callee_usage)
+                recursive |= callee_recursive
+            self.stack_cache[(func, targets)] = (self.frames.get(func, 0) + usage, recursive)
+        return self.stack_cache[(func, targets)]
+
+    def text_size(self, func):
+        """Return the text size of func and all functions it can call or reference."""
+        reachable, to_visit = set(), [func]
+        while to_visit:
+            f = to_visit.pop()
+            if f not in reachable:
+                reachable.add(f)
+                to_visit.extend(self.calls[f] | self.refs.get(f, set()))
+        return sum(self.text.get(f, 0) for f in reachable)
+
+
+def budget(budgets, kind, case, name):
+    """Look up the budget for a case/name, a name, a case, or the default, in that order."""
+    overrides = budgets.get("overrides", {})
+    for key in (f"{case}/{name}", name, case):
+        if kind in overrides.get(key, {}):
+            return overrides[key][kind]
+    return budgets.get("default", {}).get(kind)
+
+
+def report(args):
+    """Print the report for each case, and check it against the budgets."""
+    budgets = safe_load(Path(args.budgets).read_text(encoding="utf-8")) if args.budgets else {}
+    results = {}
+    exceeded = []
+
+    def check(kind, case, name, value):
+        limit = budget(budgets, kind, case, name)
+        if limit is not None and value > limit:
+            exceeded.append(f"{case}/{name}: {kind} is {value}, budget is {limit}")
+
+    for case, sizes_exe, *objs in args.case:
+        graph = CallGraph(args.nm)
+        for obj in args.lib:
+            graph.add_object(obj, generated=False)
+        for obj in objs:
+            graph.add_object(obj, generated=True)
+
+        sizes = defaultdict(dict)
+        sizes_out = run([sizes_exe], capture_output=True, check=True).stdout.decode()
+        for line in sizes_out.splitlines():
+            kind, *fields = line.split()
+            if kind == "state_size":
+                state_size = int(fields[0])
+            else:
+                sizes[kind][fields[0]] = int(fields[1])
+
+        entries = sorted(f for f in graph.frames if ENTRY_FUNC_RE.match(f))
+        results[case] = {"entry_points": {}, "structs": sizes["struct"]}
+        print(f"{case}:")
+        print(f"  {'Entry point':<50} {'text':>8} {'stack':>8} {'states':>14}")
+        for entry in entries:
+            text = graph.text_size(entry)
+            stack, recursive = graph.max_stack(entry)
+            states = sizes["states"].get(entry)
+            results[case]["entry_points"][entry] = {
+                "text": text,
+                "stack": stack,
+                "recursive": recursive,
+                "states": states,
+                "state_bytes": states * state_size if states is not None else None,
+            }
+            states_str = f"{states} ({states * state_size} B)" if states is not None else "-"
+            stack_str = f"{stack}{'+' if recursive else ''}"
+            print(f"  {entry:<50} {text:>8} {stack_str:>8} {states_str:>14}")
+            check("text", case, entry, text)
+            check("stack", case, entry, stack)
+            if states is not None:
+                check("states", case, entry, states)
+        print(f"  {'Struct':<50} {'size':>8}")
+        for struct, size in sorted(sizes["struct"].items()):
+            print(f"  {'struct ' + struct:<50} {size:>8}")
+            check("struct", case, struct, size)
+        print()
+
+    if args.json:
+        with open(args.json, "w", encoding="utf-8") as f:
+            dump(results, f, indent=2)
+
+    if exceeded:
+        print("Budgets exceeded:\n  " + "\n  ".join(exceeded), file=stderr)
+        exit(1)
+
+
+def parse_args():
+    parser = ArgumentParser(description=__doc__.split("\n")[0])
+    subparsers = parser.add_subparsers(dest="command", required=True)
+
+    sizes_parser = subparsers.add_parser("sizes-program", help=sizes_program.__doc__)
+    sizes_parser.add_argument("--types-h", nargs="+", required=True, help="Generated type headers.")
+    sizes_parser.add_argument("--c-file", nargs="+", required=True, help="Generated C files.")
+    sizes_parser.add_argument("--output", required=True, help="The C file to write.")
+    sizes_parser.set_defaults(func=sizes_program)
+
+    report_parser = subparsers.add_parser("report", help=report.__doc__)
+    report_parser.add_argument("--nm", default="nm", help="The nm executable to use.")
+    report_parser.add_argument("--budgets", help="YAML file with the budgets.")
+    report_parser.add_argument("--json", help="Also write the report as JSON to this file.")
+    report_parser.add_argument("--lib", nargs="*", default=[], help="Object files of the zcbor library.")
+    report_parser.add_argument(
+        "--case",
+        nargs="+",
+        action="append",
+        required=True,
+        metavar=("NAME SIZES_PROGRAM", "OBJECT"),
+        help="A case name, its sizes program, and the object files of its generated code.",
+    )
+    report_parser.set_defaults(func=report)
+
+    return parser.parse_args()
+
+
+if __name__ == "__main__":
+    args = parse_args()
+    args.func(args)
@@ -171,7 +171,15 @@ ZTEST(zcbor_unit_tests, test_size64)
 
 	zassert_true(zcbor_tstr_encode(state_e, &tstr), NULL);
 	zassert_false(zcbor_bstr_decode(state_d, &tstr_res), NULL);
+#ifdef ZCBOR_VALIDATE_UTF8
+	/* large_string[128] is a lone continuation byte. */
+	zassert_false(zcbor_tstr_decode(state_d, &tstr_res), NULL);
+	zassert_equal(ZCBOR_ERR_INVALID_UTF8, zcbor_pop_error(state_d), NULL);
+	large_payload[0] = (large_payload[0] & 0x1F) | (ZCBOR_MAJOR_TYPE_BSTR << 5);
+	zassert_true(zcbor_bstr_decode(state_d, &tstr_res), NULL);
+#else
 	zassert_true(zcbor_tstr_decode(state_d, &tstr_res), NULL);
+#endif
 	zassert_equal(tstr_res.len, tstr.len, NULL);
 	zassert_equal_ptr(tstr_res.value, &large_payload[9], NULL);
 	zassert_mem_equal(tstr_res.value, large_string, tstr.len, NULL);
@@ -1494,10 +1502,13 @@ ZTEST(zcbor_unit_tests, test_error_str)
 	test_str(ZCBOR_ERR_TOO_LARGE_FOR_STRING);
 	test_str(ZCBOR_ERR_NOT_IN_FRAGMENT);
 	test_str(ZCBOR_ERR_INSIDE_STRING);
+	test_str(ZCBOR_ERR_INVALID_UTF8);
+	test_str(ZCBOR_ERR_WORK_BUDGET);
+	test_str(ZCBOR_ERR_NO_ARENA_MEM);
 	test_str(ZCBOR_ERR_UNKNOWN);
 	zassert_mem_equal(zcbor_error_str(-1), "ZCBOR_ERR_UNKNOWN", sizeof("ZCBOR_ERR_UNKNOWN"), NULL);
 	zassert_mem_equal(zcbor_error_str(-10), "ZCBOR_ERR_UNKNOWN", sizeof("ZCBOR_ERR_UNKNOWN"), NULL);
-	zassert_mem_equal(zcbor_error_str(ZCBOR_ERR_INSIDE_STRING + 1), "ZCBOR_ERR_UNKNOWN", sizeof("ZCBOR_ERR_UNKNOWN"), NULL);
+	zassert_mem_equal(zcbor_error_str(ZCBOR_ERR_NO_ARENA_MEM + 1), "ZCBOR_ERR_UNKNOWN", sizeof("ZCBOR_ERR_UNKNOWN"), NULL);
 	zassert_mem_equal(zcbor_error_str(100000), "ZCBOR_ERR_UNKNOWN", sizeof("ZCBOR_ERR_UNKNOWN"), NULL);
 }
 
@@ -1624,6 +1635,11 @@ ZTEST(zcbor_unit_tests, test_unordered_map)
 	uint8_t const *start2, *start3, *start4;
 	bool ret;
 
+#ifdef ZCBOR_WORK_BUDGET
+	/* The map below is deliberately searched in the worst possible order. */
+	state_d->decode_state.work_budget = SIZE_MAX;
+#endif
+
 	zassert_true(zcbor_map_start_encode(state_e, 0), NULL);
 	zassert_true(zcbor_map_end_encode(state_e, 0), NULL);
 	start2 = state_e->payload;
@@ -1892,7 +1908,13 @@ ZTEST(zcbor_unit_tests, test_canonical_check)
 	zassert_true(zcbor_map_start_decode(state_d), NULL);
 	zassert_true(zcbor_list_start_decode(state_d), NULL);
 	zassert_true(zcbor_tstr_decode(state_d, &str_result), NULL);
+#ifdef ZCBOR_VALIDATE_UTF8
+	/* The string value is the rest of the test vector, which isn't valid UTF-8. */
+	zassert_false(zcbor_tstr_decode(state_d, &str_result), NULL);
+	zassert_equal(ZCBOR_ERR_INVALID_UTF8, zcbor_pop_error(state_d), NULL);
+#else
 	zassert_true(zcbor_tstr_decode(state_d, &str_result), NULL);
+#endif
 	state_d->payload = state_d->payload_bak + 2; /* Reset since test vector doesn't contain the string value, just the header. */
 	zassert_true(zcbor_bstr_decode(state_d, &str_result), NULL);
 	state_d->payload = state_d->payload_bak + 3; /* Reset since test vector doesn't contain the string value, just the header. */
@@ -2174,6 +2196,69 @@ ZTEST(zcbor_unit_tests, test_elem_state_backup)
 #endif
 }
 
+ZTEST(zcbor_unit_tests, test_unordered_map_mostly_processed)
+{
+#ifdef ZCBOR_MAP_SMART_SEARCH
+	/* Test that searches skip runs of processed elements correctly, both within a flag word,
+	 * across flag words, and when there are no unprocessed elements before the end of the map. */
+	static uint8_t payload[1000];
+	const uint32_t num_elems = 100;
+	ZCBOR_STATE_E(state_e, 1, payload, sizeof(payload), 0);
+	ZCBOR_STATE_D(state_d, 2, payload, sizeof(payload), 1, 100);
+
+	zassert_true(zcbor_map_start_encode(state_e, num_elems), NULL);
+	for (uint32_t i = 0; i < num_elems; i++) {
+		zassert_true(zcbor_uint32_put(state_e, i), NULL);
+		zassert_true(zcbor_uint32_put(state_e, i + 1000), NULL);
+	}
+	zassert_true(zcbor_map_end_encode(state_e, num_elems), NULL);
+
+	zassert_true(zcbor_unordered_map_start_decode(state_d), NULL);
+
+	/* Process all elements except 3, 31, 32, and 98, in descending order. */
+	for (uint32_t i = num_elems - 1; i < num_elems; i--) {
+		if (i == 3 || i == 31 || i == 32 || i == 98) {
+			continue;
+		}
+		zassert_true(zcbor_unordered_map_search(ZCBOR_CAST_FP(zcbor_uint32_pexpect),
+				state_d, &i), "%u\n", i);
+		zassert_true(zcbor_uint32_expect(state_d, i + 1000), NULL);
+	}
+
+	/* Processed elements are not found again. */
+	zassert_false(zcbor_unordered_map_search(ZCBOR_CAST_FP(zcbor_uint32_pexpect),
+			state_d, &((uint32_t){50})), NULL);
+	zassert_equal(ZCBOR_ERR_ELEM_NOT_FOUND, zcbor_pop_error(state_d), NULL);
+	zassert_false(zcbor_unordered_map_search(ZCBOR_CAST_FP(zcbor_uint32_pexpect),
+			state_d, &((uint32_t){0})), NULL);
+	zassert_equal(ZCBOR_ERR_ELEM_NOT_FOUND, zcbor_pop_error(state_d), NULL);
+
+	zassert_true(zcbor_unordered_map_search(ZCBOR_CAST_FP(zcbor_uint32_pexpect),
+			state_d, &((uint32_t){32})), NULL);
+	zassert_true(zcbor_uint32_expect(state_d, 1032), NULL);
+	zassert_true(zcbor_unordered_map_search(ZCBOR_CAST_FP(zcbor_uint32_pexpect),
+			state_d, &((uint32_t){3})), NULL);
+	zassert_true(zcbor_uint32_expect(state_d, 1003), NULL);
+	zassert_true(zcbor_unordered_map_search(ZCBOR_CAST_FP(zcbor_uint32_pexpect),
+			state_d, &((uint32_t){98})), NULL);
+	zassert_true(zcbor_uint32_expect(state_d, 1098), NULL);
+
+	zassert_false(zcbor_unordered_map_end_decode(state_d), NULL);
+	zassert_equal(ZCBOR_ERR_ELEMS_NOT_PROCESSED, zcbor_pop_error(state_d), NULL);
+
+	zassert_true(zcbor_unordered_map_search(ZCBOR_CAST_FP(zcbor_uint32_pexpect),
+			state_d, &((uint32_t){31})), NULL);
+	zassert_true(zcbor_uint32_expect(state_d, 1031), NULL);
+
+	/* All elements are processed. */
+	zassert_false(zcbor_unordered_map_search(ZCBOR_CAST_FP(zcbor_uint32_pexpect),
+			state_d, &((uint32_t){31})), NULL);
+	zassert_equal(ZCBOR_ERR_ELEM_NOT_FOUND, zcbor_pop_error(state_d), NULL);
+	zassert_true(zcbor_unordered_map_end_decode(state_d), NULL);
+#endif
+}
+
+
 ZTEST(zcbor_unit_tests, test_elem_state_backup2)
 {
 #ifdef ZCBOR_MAP_SMART_SEARCH
@@ -2232,8 +2317,10 @@ bool dummy_entry_function(zcbor_state_t *state, uint32_t *result)
 #ifdef ZCBOR_MAP_SMART_SEARCH
 	size_t elem_state_bytes = state->constant_state->map_search_elem_state_end
 				- state->decode_state.map_search_elem_state;
-	zassert_equal(elem_state_bytes, sizeof(zcbor_state_t) + 1, "%d != %d\n",
-		      elem_state_bytes, sizeof(zcbor_state_t) + 1);
+	size_t exp_elem_state_bytes = zcbor_flags_to_bytes((sizeof(zcbor_state_t) * 8) + 1);
+
+	zassert_equal(elem_state_bytes, exp_elem_state_bytes, "%d != %d\n",
+		      elem_state_bytes, exp_elem_state_bytes);
 #endif
 	return true;
 }
@@ -2281,6 +2368,79 @@ ZTEST(zcbor_unit_tests, test_entry_function)
 }
 
 
+#ifdef ZCBOR_TRUSTED_INPUT
+ZTEST(zcbor_unit_tests, test_trusted_input)
+{
+	uint8_t payload[] = {
+		0x9F, /* Non-canonical list start */
+		0x78, 0x01, 'a', /* Non-canonical 1 */
+		0x19, 0x00, 0x05, /* Non-canonical 5 */
+		0xFF,
+	};
+	ZCBOR_STATE_D(state_d, 2, payload, sizeof(payload), 1, 0);
+	struct zcbor_string str_result;
+	uint32_t u32_result;
+	size_t payload_len_out;
+#ifdef ZCBOR_MAP_SMART_SEARCH
+	zcbor_state_t states[6];
+#else
+	zcbor_state_t states[4]; /* 2 less since these aren't used for elem_state. */
+#endif
+	int err;
+
+	zassert_false(state_d->constant_state->trust_input, NULL);
+	state_d->constant_state->trust_input = true;
+
+	/* The canonical checks are skipped, even when ZCBOR_CANONICAL is defined. */
+	zassert_true(zcbor_list_start_decode(state_d), NULL);
+	zassert_true(zcbor_tstr_expect_lit(state_d, "a"), NULL);
+	zassert_true(zcbor_uint32_decode(state_d, &u32_result), NULL);
+	zassert_equal(u32_result, 5, NULL);
+	zassert_true(zcbor_list_end_decode(state_d), NULL);
+
+	/* Running out of elements is still detected. */
+	zassert_false(zcbor_uint32_decode(state_d, &u32_result), NULL);
+	zassert_equal(ZCBOR_ERR_NO_PAYLOAD, zcbor_pop_error(state_d), NULL);
+
+	/* Headers and strings are still checked against the end of the payload. */
+	zcbor_update_state(state_d, &payload[1], 2);
+	state_d->elem_count = 1;
+	zassert_false(zcbor_tstr_decode(state_d, &str_result), NULL);
+	zassert_equal(ZCBOR_ERR_NO_PAYLOAD, zcbor_pop_error(state_d), NULL);
+	zcbor_update_state(state_d, &payload[4], 2);
+	state_d->elem_count = 1;
+	zassert_false(zcbor_uint32_decode(state_d, &u32_result), NULL);
+	zassert_equal(ZCBOR_ERR_NO_PAYLOAD, zcbor_pop_error(state_d), NULL);
+
+	/* The payload is also checked up front. */
+	err = zcbor_trusted_entry_function_with_elem_states(NULL, sizeof(dummy_entry_func_payload),
+					&dummy_entry_func_result, &payload_len_out, states,
+					ZCBOR_CAST_FP(dummy_entry_function),
+					sizeof(states) / sizeof(zcbor_state_t), 1, (sizeof(zcbor_state_t) * 8) + 1);
+	zassert_equal(err, ZCBOR_ERR_NO_PAYLOAD, "err: %d\n", err);
+	err = zcbor_trusted_entry_function_with_elem_states(dummy_entry_func_payload, 0,
+					&dummy_entry_func_result, &payload_len_out, states,
+					ZCBOR_CAST_FP(dummy_entry_function),
+					sizeof(states) / sizeof(zcbor_state_t), 1, (sizeof(zcbor_state_t) * 8) + 1);
+	zassert_equal(err, ZCBOR_ERR_NO_PAYLOAD, "err: %d\n", err);
+
+	err = zcbor_trusted_entry_function_with_elem_states(dummy_entry_func_payload, sizeof(dummy_entry_func_payload),
+					&dummy_entry_func_result, &payload_len_out, states,
+					ZCBOR_CAST_FP(dummy_entry_function),
+					sizeof(states) / sizeof(zcbor_state_t), 1, (sizeof(zcbor_state_t) * 8) + 1);
+	zassert_equal(err, ZCBOR_SUCCESS, "err: %d\n", err);
+	zassert_equal(payload_len_out, 2, NULL);
+	zassert_true(states[0].constant_state->trust_input, NULL);
+
+	err = zcbor_entry_function_with_elem_states(dummy_entry_func_payload, sizeof(dummy_entry_func_payload),
+					&dummy_entry_func_result, &payload_len_out, states,
+					ZCBOR_CAST_FP(dummy_entry_function),
+					sizeof(states) / sizeof(zcbor_state_t), 1, (sizeof(zcbor_state_t) * 8) + 1);
+	zassert_equal(err, ZCBOR_SUCCESS, "err: %d\n", err);
+	zassert_false(states[0].constant_state->trust_input, NULL);
+}
+#endif /* ZCBOR_TRUSTED_INPUT */
+
 #ifdef ZCBOR_CANONICAL
 /* Allocate a large enough buffer for 65540 elements + header */
 static uint8_t huge_payload[66000];
@@ -2398,4 +2558,878 @@ ZTEST(zcbor_unit_tests, test_size_hint)
 #endif
 }
 
+
+/* Test that zcbor_index_items() finds the element boundaries of CBOR sequences
+ * and lists, and that the elements between two boundaries can be decoded
+ * independently with a separate state. */
+ZTEST(zcbor_unit_tests, test_index_items)
+{
+	uint8_t payload[] = {
+		0x01,
+		0x82, 0x61, 'a', 0xA1, 0x02, 0x03,
+		0xC1, 0x19, 0x01, 0x00,
+		0x43, 1, 2, 3,
+		0x83, 0x04, 0x05, 0x06,
+	};
+	uint8_t list_payload[] = {0x84, 0x01, 0x18, 0x20, 0x02, 0x19, 0x01, 0x00};
+	size_t exp_offsets[] = {0, 1, 7, 11, 15, 19};
+	size_t offsets[ZCBOR_ARRAY_SIZE(exp_offsets)];
+	size_t num_items;
+	uint32_t u32_result;
+	ZCBOR_STATE_D(state_d, 3, payload, sizeof(payload), ZCBOR_LARGE_ELEM_COUNT, 0);
+
+	/* Whole sequence. */
+	zassert_true(zcbor_index_items(state_d, offsets, ZCBOR_ARRAY_SIZE(offsets), &num_items), NULL);
+	zassert_equal(5, num_items, "%zu\n", num_items);
+	zassert_mem_equal(exp_offsets, offsets, sizeof(offsets), NULL);
+	zassert_true(zcbor_payload_at_end(state_d), NULL);
+
+	/* Stop at max_items. */
+	zcbor_update_state(state_d, payload, sizeof(payload));
+	state_d->elem_count = ZCBOR_LARGE_ELEM_COUNT;
+	zassert_true(zcbor_index_items(state_d, offsets, 2, &num_items), NULL);
+	zassert_equal(2, num_items, NULL);
+	zassert_mem_equal(exp_offsets, offsets, 3 * sizeof(offsets[0]), NULL);
+	zassert_equal_ptr(&payload[exp_offsets[2]], state_d->payload, NULL);
+
+	/* The items from index 2 and onward can be decoded on their own. */
+	ZCBOR_STATE_D(state_d2, 2, &payload[offsets[2]], sizeof(payload) - offsets[2],
+			ZCBOR_LARGE_ELEM_COUNT, 0);
+	zassert_true(zcbor_tag_expect(state_d2, 1), NULL);
+	zassert_true(zcbor_uint32_expect(state_d2, 256), NULL);
+
+	/* Elements of a list. */
+	ZCBOR_STATE_D(state_d3, 2, list_payload, sizeof(list_payload), 1, 0);
+	zassert_true(zcbor_list_start_decode(state_d3), NULL);
+	zassert_true(zcbor_index_items(state_d3, offsets, ZCBOR_ARRAY_SIZE(offsets), &num_items), NULL);
+	zassert_equal(4, num_items, NULL);
+	zassert_equal(0, offsets[0], NULL);
+	zassert_equal(1, offsets[1], NULL);
+	zassert_equal(3, offsets[2], NULL);
+	zassert_equal(4, offsets[3], NULL);
+	zassert_equal(7, offsets[4], NULL);
+	zassert_true(zcbor_list_end_decode(state_d3), NULL);
+
+	ZCBOR_STATE_D(state_d4, 0, &list_payload[1 + offsets[1]], offsets[3] - offsets[1], 2, 0);
+	zassert_true(zcbor_uint32_decode(state_d4, &u32_result), NULL);
+	zassert_equal(32, u32_result, NULL);
+	zassert_true(zcbor_uint32_decode(state_d4, &u32_result), NULL);
+	zassert_equal(2, u32_result, NULL);
+	zassert_true(zcbor_payload_at_end(state_d4), NULL);
+
+	/* Malformed elements stop the indexing. */
+	ZCBOR_STATE_D(state_d5, 2, payload, sizeof(payload) - 1, ZCBOR_LARGE_ELEM_COUNT, 0);
+	zassert_false(zcbor_index_items(state_d5, offsets, ZCBOR_ARRAY_SIZE(offsets), &num_items), NULL);
+	zassert_equal(4, num_items, NULL);
+	zassert_mem_equal(exp_offsets, offsets, 5 * sizeof(offsets[0]), NULL);
+}
+
+
+/* Test that zcbor_raw_decode() returns the exact encoded bytes of an element, and that
+ * zcbor_raw_put() writes them back verbatim. */
+ZTEST(zcbor_unit_tests, test_raw)
+{
+	uint8_t payload[] = {
+		0x01,
+		0xC1, 0x82, 0x61, 'a', 0xA1, 0x02, 0x03,
+		0x46, 1, 2, 3, 4, 5, 6,
+		0x04,
+	};
+	uint8_t payload2[sizeof(payload)];
+	struct zcbor_string raw[2];
+	uint32_t u32_result;
+	ZCBOR_STATE_D(state_d, 0, payload, sizeof(payload), 4, 0);
+	ZCBOR_STATE_E(state_e, 0, payload2, sizeof(payload2), 0);
+
+	zassert_true(zcbor_uint32_expect(state_d, 1), NULL);
+	zassert_true(zcbor_raw_decode(state_d, &raw[0]), NULL);
+	zassert_equal_ptr(&payload[1], raw[0].value, NULL);
+	zassert_equal(7, raw[0].len, "%zu\n", raw[0].len);
+	zassert_true(zcbor_raw_decode(state_d, &raw[1]), NULL);
+	zassert_equal_ptr(&payload[8], raw[1].value, NULL);
+	zassert_equal(7, raw[1].len, "%zu\n", raw[1].len);
+	zassert_equal(1, state_d->elem_count, NULL);
+	zassert_true(zcbor_uint32_decode(state_d, &u32_result), NULL);
+	zassert_true(zcbor_payload_at_end(state_d), NULL);
+
+	zassert_true(zcbor_uint32_put(state_e, 1), NULL);
+	zassert_true(zcbor_raw_encode(state_e, &raw[0]), NULL);
+	zassert_true(zcbor_raw_put(state_e, raw[1].value, raw[1].len), NULL);
+	zassert_true(zcbor_uint32_put(state_e, u32_result), NULL);
+	zassert_equal(4, state_e->elem_count, NULL);
+	zassert_equal(sizeof(payload), state_e->payload - payload2, NULL);
+	zassert_mem_equal(payload, payload2, sizeof(payload), NULL);
+
+	/* Not enough room. */
+	ZCBOR_STATE_E(state_e2, 0, payload2, 6, 0);
+	zassert_false(zcbor_raw_encode(state_e2, &raw[0]), NULL);
+	zassert_equal(ZCBOR_ERR_NO_PAYLOAD, zcbor_pop_error(state_e2), NULL);
+
+	/* Malformed elements are rejected. */
+	ZCBOR_STATE_D(state_d2, 0, &payload[1], 6, 1, 0);
+	zassert_false(zcbor_raw_decode(state_d2, &raw[0]), NULL);
+	zassert_equal_ptr(&payload[1], state_d2->payload, NULL);
+}
+
+
+ZTEST(zcbor_unit_tests, test_validate_utf8)
+{
+	const uint8_t valid[] = "ascii only, longer than a word."
+		"\xC2\x80" "\xDF\xBF" /* 2 bytes */
+		"\xE0\xA0\x80" "\xED\x9F\xBF" "\xEE\x80\x80" "\xEF\xBF\xBF" /* 3 bytes */
+		"\xF0\x90\x80\x80" "\xF4\x8F\xBF\xBF"; /* 4 bytes */
+	const char *invalid[] = {
+		"\x80", /* Lone continuation byte */
+		"\xC0\xAF", "\xE0\x9F\xBF", "\xF0\x8F\xBF\xBF", /* Overlong */
+		"\xED\xA0\x80", "\xED\xBF\xBF", /* Surrogates */
+		"\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xFF", /* Too large */
+		"\xC2", "aaaaaaaa\xE0\xA0", "\xF0\x90\x80", /* Truncated */
+		"\xC2\x41", "\xE1\x80\xC0", /* Bad continuation byte */
+	};
+
+	zassert_true(zcbor_validate_utf8(valid, sizeof(valid) - 1), NULL);
+	zassert_true(zcbor_validate_utf8(valid, 0), NULL);
+
+	for (size_t i = 0; i < ZCBOR_ARRAY_SIZE(invalid); i++) {
+		zassert_false(zcbor_validate_utf8((const uint8_t *)invalid[i], strlen(invalid[i])),
+			"%zu\n", i);
+	}
+
+	/* Split the strings in two at every point. */
+	for (size_t split = 0; split < sizeof(valid); split++) {
+		struct zcbor_utf8_state utf8 = {0};
+
+		zassert_true(zcbor_validate_utf8_partial(&utf8, valid, split), "%zu\n", split);
+		zassert_true(zcbor_validate_utf8_partial(&utf8, &valid[split], sizeof(valid) - 1 - split),
+			"%zu\n", split);
+		zassert_equal(0, utf8.num_cont, "%zu\n", split);
+	}
+	for (size_t i = 0; i < ZCBOR_ARRAY_SIZE(invalid); i++) {
+		size_t len = strlen(invalid[i]);
+
+		for (size_t split = 0; split <= len; split++) {
+			struct zcbor_utf8_state utf8 = {0};
+			const uint8_t *str = (const uint8_t *)invalid[i];
+
+			zassert_false(zcbor_validate_utf8_partial(&utf8, str, split)
+				&& zcbor_validate_utf8_partial(&utf8, &str[split], len - split)
+				&& (utf8.num_cont == 0), "%zu %zu\n", i, split);
+		}
+	}
+
+	uint8_t payload[] = {0x62, 0xC3, 0xA6, 0x62, 0xC3, 0x41, 0x62, 0xC3, 0x41};
+	struct zcbor_string str_result;
+	ZCBOR_STATE_D(state_d, 0, payload, sizeof(payload), 3, 0);
+
+	zassert_true(zcbor_tstr_decode(state_d, &str_result), NULL);
+	zassert_equal(2, str_result.len, NULL);
+#ifdef ZCBOR_VALIDATE_UTF8
+	zassert_false(zcbor_tstr_decode(state_d, &str_result), NULL);
+	zassert_equal(ZCBOR_ERR_INVALID_UTF8, zcbor_pop_error(state_d), NULL);
+	zassert_equal_ptr(&payload[3], state_d->payload, NULL);
+	zassert_equal(2, state_d->elem_count, NULL);
+	zassert_false(zcbor_tstr_expect_ptr(state_d, "\xC3\x41", 2), NULL);
+	zassert_equal(ZCBOR_ERR_INVALID_UTF8, zcbor_pop_error(state_d), NULL);
+
+	/* bstrs are not validated. */
+	payload[3] = 0x42;
+	zassert_true(zcbor_bstr_decode(state_d, &str_result), NULL);
+#else
+	zassert_true(zcbor_tstr_decode(state_d, &str_result), NULL);
+	zassert_true(zcbor_tstr_expect_ptr(state_d, "\xC3\x41", 2), NULL);
+#endif
+}
+
+
+/** A tstr is decoded in fragments that split a UTF-8 character. */
+ZTEST(zcbor_unit_tests, test_validate_utf8_fragments)
+{
+	uint8_t payload[] = {0x64, 'a', 0xE2, 0x82, 0xAC}; /* "a€" */
+	struct zcbor_string_fragment frag;
+	ZCBOR_STATE_D(state_d, 0, payload, 3, 1, 0);
+
+	zassert_true(zcbor_tstr_fragments_start_decode(state_d), NULL);
+	zassert_true(zcbor_str_fragment_decode(state_d, &frag), NULL);
+	zassert_equal(2, frag.fragment.len, NULL);
+	zcbor_update_state(state_d, &payload[3], 2);
+	zassert_true(zcbor_str_fragment_decode(state_d, &frag), NULL);
+	zassert_equal(2, frag.fragment.len, NULL);
+	zassert_true(zcbor_str_fragments_end_decode(state_d), NULL);
+
+	/* Bad continuation byte in the second fragment. */
+	payload[4] = 'c';
+	ZCBOR_STATE_D(state_d2, 0, payload, 3, 1, 0);
+
+	zassert_true(zcbor_tstr_fragments_start_decode(state_d2), NULL);
+	zassert_true(zcbor_str_fragment_decode(state_d2, &frag), NULL);
+	zcbor_update_state(state_d2, &payload[3], 2);
+#ifdef ZCBOR_VALIDATE_UTF8
+	zassert_false(zcbor_str_fragment_decode(state_d2, &frag), NULL);
+	zassert_equal(ZCBOR_ERR_INVALID_UTF8, zcbor_pop_error(state_d2), NULL);
+	zassert_equal_ptr(&payload[3], state_d2->payload, NULL);
+#else
+	zassert_true(zcbor_str_fragment_decode(state_d2, &frag), NULL);
+	zassert_true(zcbor_str_fragments_end_decode(state_d2), NULL);
+#endif
+
+	/* The string ends in the middle of a character. */
+	payload[0] = 0x62;
+	ZCBOR_STATE_D(state_d3, 0, payload, 3, 1, 0);
+
+	zassert_true(zcbor_tstr_fragments_start_decode(state_d3), NULL);
+	zassert_true(zcbor_str_fragment_decode(state_d3, &frag), NULL);
+#ifdef ZCBOR_VALIDATE_UTF8
+	zassert_false(zcbor_str_fragments_end_decode(state_d3), NULL);
+	zassert_equal(ZCBOR_ERR_INVALID_UTF8, zcbor_pop_error(state_d3), NULL);
+#else
+	zassert_true(zcbor_str_fragments_end_decode(state_d3), NULL);
+#endif
+
+	/* bstrs are not validated. */
+	ZCBOR_STATE_D(state_d4, 0, payload, 3, 1, 0);
+
+	payload[0] = 0x42;
+	zassert_true(zcbor_bstr_fragments_start_decode(state_d4), NULL);
+	zassert_true(zcbor_str_fragment_decode(state_d4, &frag), NULL);
+	zassert_true(zcbor_str_fragments_end_decode(state_d4), NULL);
+}
+
+
+ZTEST(zcbor_unit_tests, test_expect_encoded)
+{
+	uint8_t payload[] = {
+		0x63, 'f', 'o', 'o',
+		0x63, 'b', 'a', 'r',
+		0x64, 'f', 'o', 'o', 'd',
+		0x78, 0x03, 'f', 'o', 'o', /* Non-canonical */
+		0x43, 'f', 'o', 'o',
+		0x63, 'f', 'o',
+	};
+	struct zcbor_string foo = {.value = (const uint8_t *)"\x63" "foo", .len = 4};
+	struct zcbor_string foo_bstr = {.value = (const uint8_t *)"\x43" "foo", .len = 4};
+	ZCBOR_STATE_D(state_d, 0, payload, sizeof(payload), 6, 0);
+
+	zassert_true(zcbor_tstr_expect_encoded(state_d, &foo), NULL);
+	zassert_equal_ptr(&payload[4], state_d->payload, NULL);
+	zassert_equal(5, state_d->elem_count, NULL);
+
+	/* Same length, different contents. */
+	zassert_false(zcbor_tstr_expect_encoded(state_d, &foo), NULL);
+	zassert_equal(ZCBOR_ERR_WRONG_VALUE, zcbor_pop_error(state_d), NULL);
+	zassert_equal_ptr(&payload[4], state_d->payload, NULL);
+	zassert_equal(5, state_d->elem_count, NULL);
+	zassert_true(zcbor_tstr_expect_lit(state_d, "bar"), NULL);
+
+	/* Different length. */
+	zassert_false(zcbor_tstr_expect_encoded(state_d, &foo), NULL);
+	zassert_equal(ZCBOR_ERR_WRONG_VALUE, zcbor_pop_error(state_d), NULL);
+	zassert_true(zcbor_tstr_expect_lit(state_d, "food"), NULL);
+
+	/* Non-canonical header. */
+#ifdef ZCBOR_CANONICAL
+	zassert_false(zcbor_tstr_expect_encoded(state_d, &foo), NULL);
+	zassert_equal(ZCBOR_ERR_WRONG_VALUE, zcbor_pop_error(state_d), NULL);
+	zassert_equal_ptr(&payload[13], state_d->payload, NULL);
+	state_d->payload += 5;
+	state_d->elem_count--;
+#else
+	zassert_true(zcbor_tstr_expect_encoded(state_d, &foo), NULL);
+#endif
+	zassert_equal_ptr(&payload[18], state_d->payload, NULL);
+
+	/* Wrong type. */
+	zassert_false(zcbor_tstr_expect_encoded(state_d, &foo), NULL);
+	zassert_equal(ZCBOR_ERR_WRONG_TYPE, zcbor_pop_error(state_d), NULL);
+	zassert_true(zcbor_bstr_expect_encoded(state_d, &foo_bstr), NULL);
+
+	/* Payload too short. */
+	zassert_false(zcbor_tstr_expect_encoded(state_d, &foo), NULL);
+	zassert_equal(ZCBOR_ERR_WRONG_VALUE, zcbor_pop_error(state_d), NULL);
+	zassert_equal_ptr(&payload[22], state_d->payload, NULL);
+}
+
+
+#ifdef ZCBOR_HASH_REGION
+struct consumed {
+	uint8_t buf[20];
+	size_t len;
+	size_t calls;
+};
+
+
+static void consume_cb(void *ctx, const uint8_t *data, size_t len)
+{
+	struct consumed *consumed = ctx;
+
+	zassert_true(consumed->len + len <= sizeof(consumed->buf), NULL);
+	memcpy(&consumed->buf[consumed->len], data, len);
+	consumed->len += len;
+	consumed->calls++;
+}
+
+
+ZTEST(zcbor_unit_tests, test_hash_region)
+{
+	uint8_t payload[] = {
+		0x01,
+		0x82, 0x02, 0x43, 'f', 'o', 'o',
+		0x03,
+	};
+	uint8_t payload2[] = {0x82, 0x04, 0x41, 'x'};
+	struct consumed consumed = {0};
+	struct zcbor_string str;
+	ZCBOR_STATE_D(state_d, 2, payload, sizeof(payload), 4, 0);
+
+	zassert_false(zcbor_hash_region_end(state_d), NULL);
+	zassert_equal(ZCBOR_ERR_BAD_STATE, zcbor_pop_error(state_d), NULL);
+	zassert_false(zcbor_hash_region_start(state_d, NULL, NULL), NULL);
+	zassert_equal(ZCBOR_ERR_BAD_ARG, zcbor_pop_error(state_d), NULL);
+
+	zassert_true(zcbor_int32_expect(state_d, 1), NULL);
+	zassert_true(zcbor_hash_region_start(state_d, consume_cb, &consumed), NULL);
+	zassert_false(zcbor_hash_region_start(state_d, consume_cb, &consumed), NULL);
+	zassert_equal(ZCBOR_ERR_BAD_STATE, zcbor_pop_error(state_d), NULL);
+	zassert_equal(0, consumed.calls, NULL);
+
+	/* The bytes are passed as they are decoded, before the region ends. */
+	zassert_true(zcbor_list_start_decode(state_d), NULL);
+	zassert_equal(1, consumed.calls, NULL);
+	zassert_equal(1, consumed.len, NULL);
+	zassert_true(zcbor_int32_expect(state_d, 2), NULL);
+	zassert_equal(1, consumed.len, NULL);
+	zassert_true(zcbor_bstr_decode(state_d, &str), NULL);
+	zassert_equal(2, consumed.calls, NULL);
+	zassert_equal(6, consumed.len, NULL);
+	zassert_true(zcbor_list_end_decode(state_d), NULL);
+	zassert_true(zcbor_hash_region_end(state_d), NULL);
+	zassert_equal(2, consumed.calls, NULL);
+	zassert_equal(6, consumed.len, NULL);
+	zassert_mem_equal(&payload[1], consumed.buf, 6, NULL);
+
+	/* Nothing consumed. */
+	consumed = (struct consumed){0};
+	zassert_true(zcbor_hash_region_start(state_d, consume_cb, &consumed), NULL);
+	zassert_true(zcbor_hash_region_end(state_d), NULL);
+	zassert_equal(0, consumed.calls, NULL);
+
+	/* Region spanning two payload sections. */
+	consumed = (struct consumed){0};
+	zassert_true(zcbor_hash_region_start(state_d, consume_cb, &consumed), NULL);
+	zassert_true(zcbor_int32_expect(state_d, 3), NULL);
+	zassert_equal(0, consumed.calls, NULL);
+	zcbor_update_state(state_d, payload2, sizeof(payload2));
+	zassert_equal(1, consumed.calls, NULL);
+	zassert_true(zcbor_list_start_decode(state_d), NULL);
+	zassert_true(zcbor_int32_expect(state_d, 4), NULL);
+
+	/* Restoring a backup doesn't pass the bytes twice. */
+	zassert_true(zcbor_new_backup(state_d, 1), NULL);
+	zassert_true(zcbor_bstr_decode(state_d, &str), NULL);
+	zassert_equal(3, consumed.calls, NULL);
+	zassert_true(zcbor_process_backup(state_d, ZCBOR_FLAG_RESTORE | ZCBOR_FLAG_CONSUME, 1), NULL);
+	zassert_true(zcbor_bstr_decode(state_d, &str), NULL);
+	zassert_true(zcbor_list_end_decode(state_d), NULL);
+	zassert_true(zcbor_hash_region_end(state_d), NULL);
+	zassert_equal(3, consumed.calls, NULL);
+	zassert_equal(5, consumed.len, NULL);
+	zassert_mem_equal("\x03\x82\x04\x41x", consumed.buf, 5, NULL);
+}
+#endif /* ZCBOR_HASH_REGION */
+
+
+ZTEST(zcbor_unit_tests, test_str_chunks)
+{
+	uint8_t payload[30];
+	struct zcbor_string chunks[] = {
+		{.value = (const uint8_t *)"ab", .len = 2},
+		{.value = (const uint8_t *)"", .len = 0},
+		{.value = (const uint8_t *)"cde", .len = 3},
+	};
+	struct zcbor_string tstr_chunk = {.value = (const uint8_t *)"fg", .len = 2};
+	uint8_t exp_payload[] = {
+		0x5F, 0x42, 'a', 'b', 0x40, 0x43, 'c', 'd', 'e', 0xFF,
+		0x7F, 0x62, 'f', 'g', 0xFF,
+		0x43, 'h', 'i', 'j',
+	};
+	struct zcbor_str_chunk_iter iter;
+	struct zcbor_string chunk;
+	struct zcbor_string result;
+	uint8_t buf[5];
+	ZCBOR_STATE_E(state_e, 0, payload, sizeof(payload), 0);
+
+	zassert_true(zcbor_bstr_chunks_start_encode(state_e), NULL);
+	for (size_t i = 0; i < ZCBOR_ARRAY_SIZE(chunks); i++) {
+		zassert_true(zcbor_bstr_chunk_encode(state_e, &chunks[i]), NULL);
+	}
+	zassert_true(zcbor_str_chunks_end_encode(state_e), NULL);
+	zassert_true(zcbor_tstr_chunks_start_encode(state_e), NULL);
+	zassert_true(zcbor_tstr_chunk_encode(state_e, &tstr_chunk), NULL);
+	zassert_true(zcbor_str_chunks_end_encode(state_e), NULL);
+	zassert_true(zcbor_bstr_put_lit(state_e, "hij"), NULL);
+	zassert_equal(3, state_e->elem_count, NULL);
+	zassert_equal(sizeof(exp_payload), state_e->payload - payload, NULL);
+	zassert_mem_equal(exp_payload, payload, sizeof(exp_payload), NULL);
+
+	ZCBOR_STATE_D(state_d, 0, payload, sizeof(exp_payload), 3, 0);
+
+#ifdef ZCBOR_CANONICAL
+	zassert_false(zcbor_bstr_chunks_start_decode(state_d, &iter), NULL);
+	zassert_equal(ZCBOR_ERR_INVALID_VALUE_ENCODING, zcbor_pop_error(state_d), NULL);
+	state_d->constant_state->enforce_canonical = false;
+#endif
+
+	/* Wrong type. */
+	zassert_false(zcbor_tstr_chunks_start_decode(state_d, &iter), NULL);
+	zassert_equal(ZCBOR_ERR_WRONG_TYPE, zcbor_pop_error(state_d), NULL);
+
+	zassert_true(zcbor_bstr_chunks_start_decode(state_d, &iter), NULL);
+	for (size_t i = 0; i < ZCBOR_ARRAY_SIZE(chunks); i++) {
+		zassert_false(zcbor_str_chunks_at_end(state_d, &iter), NULL);
+		zassert_false(zcbor_str_chunks_end_decode(state_d, &iter), NULL);
+		zassert_equal(ZCBOR_ERR_NOT_AT_END, zcbor_pop_error(state_d), NULL);
+		zassert_true(zcbor_str_chunk_decode(state_d, &iter, &chunk), NULL);
+		zassert_true(zcbor_compare_strings(&chunks[i], &chunk), NULL);
+	}
+	zassert_equal_ptr(&payload[6], chunk.value, NULL); /* Points into the payload. */
+	zassert_true(zcbor_str_chunks_at_end(state_d, &iter), NULL);
+	zassert_true(zcbor_str_chunks_end_decode(state_d, &iter), NULL);
+	zassert_equal(2, state_d->elem_count, NULL);
+
+	zassert_false(zcbor_tstr_coalesce_decode(state_d, buf, 1, &result), NULL);
+	zassert_equal(ZCBOR_ERR_TOO_LARGE_FOR_STRING, zcbor_pop_error(state_d), NULL);
+	zassert_equal_ptr(&payload[10], state_d->payload, NULL);
+	zassert_equal(2, state_d->elem_count, NULL);
+	zassert_true(zcbor_tstr_coalesce_decode(state_d, buf, sizeof(buf), &result), NULL);
+	zassert_equal_ptr(buf, result.value, NULL);
+	zassert_equal(2, result.len, NULL);
+	zassert_mem_equal("fg", buf, 2, NULL);
+
+	/* A definite length string is returned as a single chunk. */
+	zassert_true(zcbor_bstr_chunks_start_decode(state_d, &iter), NULL);
+	zassert_false(zcbor_str_chunks_at_end(state_d, &iter), NULL);
+	zassert_true(zcbor_str_chunk_decode(state_d, &iter, &chunk), NULL);
+	zassert_equal_ptr(&payload[16], chunk.value, NULL);
+	zassert_equal(3, chunk.len, NULL);
+	zassert_true(zcbor_str_chunks_at_end(state_d, &iter), NULL);
+	zassert_false(zcbor_str_chunk_decode(state_d, &iter, &chunk), NULL);
+	zassert_equal(ZCBOR_ERR_LOW_ELEM_COUNT, zcbor_pop_error(state_d), NULL);
+	zassert_true(zcbor_str_chunks_end_decode(state_d, &iter), NULL);
+	zassert_true(zcbor_payload_at_end(state_d), NULL);
+	zassert_equal(0, state_d->elem_count, NULL);
+
+	/* Skip the strings, and coalesce all of them. */
+	ZCBOR_STATE_D(state_d2, 0, payload, sizeof(exp_payload), 3, 0);
+#ifdef ZCBOR_CANONICAL
+	state_d2->constant_state->enforce_canonical = false;
+#endif
+	zassert_true(zcbor_any_skip(state_d2, NULL), NULL);
+	zassert_true(zcbor_any_skip(state_d2, NULL), NULL);
+	zassert_true(zcbor_bstr_coalesce_decode(state_d2, buf, sizeof(buf), &result), NULL);
+	zassert_mem_equal("hij", buf, 3, NULL);
+	zassert_true(zcbor_payload_at_end(state_d2), NULL);
+
+	/* The chunks must have the same type as the string. */
+	payload[11] = 0x42;
+	state_d2->payload = &payload[10];
+	state_d2->elem_count = 1;
+	zassert_false(zcbor_tstr_coalesce_decode(state_d2, buf, sizeof(buf), &result), NULL);
+	zassert_equal(ZCBOR_ERR_WRONG_TYPE, zcbor_pop_error(state_d2), NULL);
+	zassert_false(zcbor_any_skip(state_d2, NULL), NULL);
+	zassert_equal(ZCBOR_ERR_WRONG_TYPE, zcbor_pop_error(state_d2), NULL);
+	zassert_equal_ptr(&payload[10], state_d2->payload, NULL);
+	payload[11] = 0x62;
+
+	/* The normal decoding functions accept indefinite length strings. */
+	ZCBOR_STATE_D(state_d3, 0, payload, sizeof(exp_payload), 3, 0);
+#ifdef ZCBOR_CANONICAL
+	zassert_false(zcbor_bstr_decode(state_d3, &result), NULL);
+	zassert_equal(ZCBOR_ERR_INVALID_VALUE_ENCODING, zcbor_pop_error(state_d3), NULL);
+	state_d3->constant_state->enforce_canonical = false;
+#endif
+	/* More than one non-empty chunk needs an arena. */
+	zassert_false(zcbor_bstr_decode(state_d3, &result), NULL);
+	zassert_equal(ZCBOR_ERR_NO_ARENA_MEM, zcbor_pop_error(state_d3), NULL);
+	zassert_equal_ptr(payload, state_d3->payload, NULL);
+#ifdef ZCBOR_ARENA
+	_Alignas(ZCBOR_ARENA_ALIGN) uint8_t arena_buf[8];
+	struct zcbor_arena arena;
+
+	zcbor_arena_init(&arena, arena_buf, sizeof(arena_buf));
+	state_d3->decode_state.arena = &arena;
+	zassert_true(zcbor_bstr_decode(state_d3, &result), NULL);
+	zassert_equal_ptr(arena_buf, result.value, NULL);
+	zassert_equal(5, result.len, NULL);
+	zassert_mem_equal("abcde", result.value, 5, NULL);
+	zassert_equal(8, arena.used, NULL);
+#else
+	zassert_true(zcbor_any_skip(state_d3, NULL), NULL);
+#endif
+	/* A single non-empty chunk is returned without copying. */
+	zassert_true(zcbor_tstr_decode(state_d3, &result), NULL);
+	zassert_equal_ptr(&payload[12], result.value, NULL);
+	zassert_equal(2, result.len, NULL);
+	zassert_equal(1, state_d3->elem_count, NULL);
+	state_d3->payload = &payload[10];
+	state_d3->elem_count++;
+	zassert_true(zcbor_tstr_expect_lit(state_d3, "fg"), NULL);
+	zassert_true(zcbor_bstr_expect_lit(state_d3, "hij"), NULL);
+	zassert_true(zcbor_payload_at_end(state_d3), NULL);
+}
+
+
+#ifdef ZCBOR_STATS
+ZTEST(zcbor_unit_tests, test_stats)
+{
+	uint8_t payload[20];
+	struct zcbor_stats stats;
+	ZCBOR_STATE_E(state_e, 2, payload, sizeof(payload), 0);
+
+	zcbor_stats_reset();
+	zcbor_stats_read(&stats);
+	zassert_equal(0, stats.backups_created, NULL);
+	zassert_equal(0, stats.skip_calls, NULL);
+
+	/* {1: [2, "ab"]}. The size hint of the list is too large, so with
+	 * ZCBOR_CANONICAL, the list body must be moved to fit the shorter header. */
+	zassert_true(zcbor_map_start_encode(state_e, 1), NULL);
+	zassert_true(zcbor_uint32_put(state_e, 1), NULL);
+	zassert_true(zcbor_list_start_encode(state_e, 30), NULL);
+	zassert_true(zcbor_uint32_put(state_e, 2), NULL);
+	zassert_true(zcbor_tstr_put_lit(state_e, "ab"), NULL);
+	zassert_true(zcbor_list_end_encode(state_e, 30), NULL);
+	zassert_true(zcbor_map_end_encode(state_e, 1), NULL);
+	size_t len = (size_t)(state_e->payload - payload);
+
+	zcbor_stats_read(&stats);
+#ifdef ZCBOR_CANONICAL
+	/* Backups are only needed to fix up the headers. */
+	zassert_equal(2, stats.backups_created, NULL);
+	zassert_equal(2, stats.backups_restored, NULL);
+	zassert_equal(2 * sizeof(zcbor_state_t), stats.backup_bytes, NULL);
+	zassert_equal(1, stats.canonical_memmoves, NULL);
+	zassert_equal(4, stats.canonical_bytes_moved, NULL);
+#else
+	zassert_equal(0, stats.backups_created, NULL);
+	zassert_equal(0, stats.canonical_memmoves, NULL);
+#endif
+
+	/* Skipping counts every element, and every byte exactly once. */
+	ZCBOR_STATE_D(state_d, 2, payload, len, 1, 4);
+
+	zcbor_stats_reset();
+	zassert_true(zcbor_any_skip(state_d, NULL), NULL);
+	zcbor_stats_read(&stats);
+	zassert_equal(5, stats.skip_calls, NULL);
+	zassert_equal(len, stats.skip_bytes, NULL);
+
+	/* A union with a failed first alternative. */
+	state_d->payload = payload;
+	state_d->elem_count = 1;
+	zcbor_stats_reset();
+	zassert_true(zcbor_union_start_code(state_d), NULL);
+	zassert_false(zcbor_list_start_decode(state_d), NULL);
+	zassert_true(zcbor_union_elem_code(state_d), NULL);
+	zassert_true(zcbor_map_start_decode(state_d), NULL);
+	zassert_true(zcbor_union_end_code(state_d), NULL);
+	zcbor_stats_read(&stats);
+	zassert_equal(2, stats.union_alternatives, NULL);
+	zassert_true(stats.backups_restored >= 1, NULL);
+
+#ifdef ZCBOR_MAP_SMART_SEARCH
+	uint32_t key = 1;
+
+	state_d->payload = payload;
+	state_d->elem_count = 1;
+	zassert_true(zcbor_unordered_map_start_decode(state_d), NULL);
+	zcbor_stats_reset();
+	zassert_true(zcbor_unordered_map_search(
+		ZCBOR_CAST_FP(zcbor_uint32_pexpect), state_d, &key), NULL);
+	zcbor_stats_read(&stats);
+	zassert_equal(1, stats.map_search_iterations, NULL);
+	zassert_true(stats.map_flag_ops >= 1, NULL);
+#endif
+}
+#endif
+
+
+#ifdef ZCBOR_WORK_BUDGET
+ZTEST(zcbor_unit_tests, test_work_budget)
+{
+	uint8_t payload[] = {0x83, 0x01, 0x02, 0x03}; /* [1, 2, 3] */
+	uint32_t val;
+	ZCBOR_STATE_D(state_d, 2, payload, sizeof(payload), 1, 0);
+
+	zassert_equal(ZCBOR_WORK_BUDGET_BASE + sizeof(payload) * ZCBOR_WORK_BUDGET_PER_BYTE,
+		state_d->decode_state.work_budget, NULL);
+
+	/* Each element costs one step. */
+	state_d->decode_state.work_budget = 5;
+	zassert_true(zcbor_list_start_decode(state_d), NULL);
+	zassert_true(zcbor_uint32_decode(state_d, &val), NULL);
+	zassert_equal(3, state_d->decode_state.work_budget, NULL);
+
+	/* Restoring a backup does not refund the work done since it was made,
+	 * and costs a step itself. */
+	zassert_true(zcbor_new_backup(state_d, ZCBOR_MAX_ELEM_COUNT), NULL);
+	zassert_true(zcbor_uint32_decode(state_d, &val), NULL);
+	zassert_true(zcbor_process_backup(state_d,
+		ZCBOR_FLAG_RESTORE | ZCBOR_FLAG_CONSUME, ZCBOR_MAX_ELEM_COUNT), NULL);
+	zassert_equal(1, state_d->decode_state.work_budget, NULL);
+
+	zassert_true(zcbor_uint32_decode(state_d, &val), NULL);
+	zassert_equal(2, val, NULL);
+	zassert_false(zcbor_uint32_decode(state_d, &val), NULL);
+	zassert_equal(ZCBOR_ERR_WORK_BUDGET, zcbor_pop_error(state_d), NULL);
+	zassert_equal(0, state_d->decode_state.work_budget, NULL);
+	zassert_equal(payload + 3, state_d->payload, NULL);
+
+	/* Updating the state with more payload adds to the budget. */
+	zcbor_update_state(state_d, payload, sizeof(payload));
+	zassert_equal(sizeof(payload) * ZCBOR_WORK_BUDGET_PER_BYTE,
+		state_d->decode_state.work_budget, NULL);
+}
+#endif
+
+
+#ifdef ZCBOR_ARENA
+struct arena_list {
+	uint32_t *vals;
+	size_t vals_count;
+};
+
+static bool decode_arena_list(zcbor_state_t *state, struct arena_list *list)
+{
+	return zcbor_list_start_decode(state)
+		&& zcbor_multi_decode_arena(0, 10, &list->vals_count, ZCBOR_CAST_FP(zcbor_uint32_decode),
+			state, &list->vals, sizeof(uint32_t))
+		&& zcbor_list_end_decode(state);
+}
+
+static bool decode_arena_lists(zcbor_state_t *state, struct arena_list **lists,
+		size_t *num_lists)
+{
+	return zcbor_list_start_decode(state)
+		&& zcbor_multi_decode_arena(0, 10, num_lists, (zcbor_decoder_t *)decode_arena_list,
+			state, lists, sizeof(struct arena_list))
+		&& zcbor_list_end_decode(state);
+}
+
+ZTEST(zcbor_unit_tests, test_multi_decode_arena)
+{
+	/* [[1, 2], [], [3, 4, 5]] */
+	uint8_t payload[] = {0x83, 0x82, 0x01, 0x02, 0x80, 0x83, 0x03, 0x04, 0x05};
+	_Alignas(ZCBOR_ARENA_ALIGN) uint8_t arena_buf[256];
+	struct zcbor_arena arena;
+	struct arena_list *lists;
+	size_t num_lists;
+	ZCBOR_STATE_D(state_d, 2, payload, sizeof(payload), 1, 0);
+	ZCBOR_STATE_D(state_d2, 2, payload, sizeof(payload), 1, 0);
+	ZCBOR_STATE_D(state_d3, 2, payload, sizeof(payload), 1, 0);
+	ZCBOR_STATE_D(state_d4, 2, payload, sizeof(payload), 1, 0);
+
+	/* Without an arena. */
+	zassert_false(decode_arena_lists(state_d, &lists, &num_lists), NULL);
+	zassert_equal(ZCBOR_ERR_NO_ARENA_MEM, zcbor_pop_error(state_d), NULL);
+
+	/* The counting pass stores nothing, but finds the arena size. */
+	zcbor_arena_count_init(&arena, arena_buf, sizeof(arena_buf));
+	state_d2->decode_state.arena = &arena;
+	zassert_true(decode_arena_lists(state_d2, &lists, &num_lists), NULL);
+	zassert_equal(3, num_lists, NULL);
+	zassert_is_null(lists, NULL);
+	zassert_equal(0, arena.scratch, NULL);
+
+	/* The nested arrays are placed before the outer array. */
+	zcbor_arena_init(&arena, arena_buf, arena.peak);
+	state_d3->decode_state.arena = &arena;
+	zassert_true(decode_arena_lists(state_d3, &lists, &num_lists), NULL);
+	zassert_equal(3, num_lists, NULL);
+	zassert_equal(2, lists[0].vals_count, NULL);
+	zassert_equal(1, lists[0].vals[0], NULL);
+	zassert_equal(2, lists[0].vals[1], NULL);
+	zassert_equal(0, lists[1].vals_count, NULL);
+	zassert_is_null(lists[1].vals, NULL);
+	zassert_equal(3, lists[2].vals_count, NULL);
+	zassert_equal(3, lists[2].vals[0], NULL);
+	zassert_equal(4, lists[2].vals[1], NULL);
+	zassert_equal(5, lists[2].vals[2], NULL);
+	zassert_equal_ptr(arena_buf, lists[0].vals, NULL);
+	zassert_true((uint8_t *)lists > (uint8_t *)lists[2].vals, NULL);
+	zassert_equal(0, arena.scratch, NULL);
+	zassert_true(arena.used <= arena.size, NULL);
+
+	/* The counted size is exact. */
+	zcbor_arena_init(&arena, arena_buf, arena.size - ZCBOR_ARENA_ALIGN);
+	state_d4->decode_state.arena = &arena;
+	zassert_false(decode_arena_lists(state_d4, &lists, &num_lists), NULL);
+	zassert_equal(ZCBOR_ERR_NO_ARENA_MEM, zcbor_pop_error(state_d4), NULL);
+	zassert_equal(0, arena.used, NULL);
+	zassert_equal(0, arena.scratch, NULL);
+}
+#endif
+
+
+ZTEST(zcbor_unit_tests, test_string_off)
+{
+	const uint8_t buf[10] = {0};
+	struct zcbor_string str = {.value = &buf[3], .len = 4};
+	struct zcbor_string_off str_off = {.offset = 1, .len = 1};
+	struct zcbor_string str2;
+
+	zassert_equal(8, sizeof(struct zcbor_string_off), NULL);
+	zassert_true(zcbor_string_off_set(&str_off, buf, &str), NULL);
+	zassert_equal(3, str_off.offset, NULL);
+	zassert_equal(4, str_off.len, NULL);
+	zassert_equal_ptr(&buf[3], zcbor_string_off_ptr(buf, &str_off), NULL);
+	str2 = zcbor_string_off_get(buf, &str_off);
+	zassert_equal_ptr(&buf[3], str2.value, NULL);
+	zassert_equal(4, str2.len, NULL);
+
+	/* The string starts before the base. */
+	zassert_false(zcbor_string_off_set(&str_off, &buf[4], &str), NULL);
+	zassert_equal(3, str_off.offset, NULL);
+
+#if SIZE_MAX > UINT32_MAX
+	str.len = (size_t)UINT32_MAX + 1;
+	zassert_false(zcbor_string_off_set(&str_off, buf, &str), NULL);
+	zassert_equal(4, str_off.len, NULL);
+#endif
+}
+
+
+#ifdef ZCBOR_STRING_OFFSETS
+ZTEST(zcbor_unit_tests, test_string_off_code)
+{
+	uint8_t payload[20] = {0};
+	uint8_t payload2[20];
+	const uint8_t strings[] = "xxhellohi";
+	struct zcbor_string_off bstr_off = {.offset = 2, .len = 5};
+	struct zcbor_string_off tstr_off = {.offset = 7, .len = 2};
+	struct zcbor_string_off result[2];
+	ZCBOR_STATE_E(state_e, 0, payload, sizeof(payload), 0);
+	ZCBOR_STATE_D(state_d, 0, payload, sizeof(payload), 3, 0);
+
+	zassert_equal_ptr(payload, state_e->string_base, NULL);
+	state_e->string_base = strings;
+	zassert_true(zcbor_bstr_off_encode(state_e, &bstr_off), NULL);
+	zassert_true(zcbor_tstr_off_encode(state_e, &tstr_off), NULL);
+	zassert_equal(9, state_e->payload - payload, NULL);
+	zassert_mem_equal("\x45hello\x62hi", payload, 9, NULL);
+
+	/* Offsets are relative to the start of the payload. */
+	zassert_true(zcbor_bstr_off_decode(state_d, &result[0]), NULL);
+	zassert_true(zcbor_tstr_off_decode(state_d, &result[1]), NULL);
+	zassert_equal(1, result[0].offset, NULL);
+	zassert_equal(5, result[0].len, NULL);
+	zassert_equal(7, result[1].offset, NULL);
+	zassert_equal(2, result[1].len, NULL);
+	zassert_mem_equal("hi", zcbor_string_off_ptr(payload, &result[1]), 2, NULL);
+
+	/* Wrong type. */
+	zassert_false(zcbor_bstr_off_decode(state_d, &result[0]), NULL);
+	zassert_equal(ZCBOR_ERR_WRONG_TYPE, zcbor_pop_error(state_d), NULL);
+
+	/* The string is before the base. */
+	zcbor_new_decode_state(state_d, ZCBOR_ARRAY_SIZE(state_d), payload, 9, 1, NULL, 0);
+	state_d->string_base = &payload[2];
+	zassert_false(zcbor_bstr_off_decode(state_d, &result[0]), NULL);
+	zassert_equal(ZCBOR_ERR_INT_SIZE, zcbor_pop_error(state_d), NULL);
+	zassert_equal_ptr(payload, state_d->payload, NULL);
+
+	/* Encode from the decoded offsets, into another payload. */
+	zcbor_new_encode_state(state_e, ZCBOR_ARRAY_SIZE(state_e), payload2, sizeof(payload2), 0);
+	state_e->string_base = payload;
+	zassert_true(zcbor_tstr_off_encode(state_e, &result[1]), NULL);
+	zassert_mem_equal("\x62hi", payload2, 3, NULL);
+}
+#endif
+
+
+/* Values that are encoded entirely in the header byte. With ZCBOR_INLINE, these are
+ * handled by the inline functions themselves. */
+ZTEST(zcbor_unit_tests, test_header_values)
+{
+	uint8_t payload[20];
+	uint8_t exp_payload[] = {0x17, 0x18, 0x18, 0x37, 0x38, 0x18, 0x00, 0x05, 0x07, 0x20};
+	uint8_t u8 = 7;
+	int64_t i64 = -1;
+	int32_t i32;
+	uint8_t u8_result;
+	size_t size_result;
+	ZCBOR_STATE_E(state_e, 0, payload, sizeof(payload), 0);
+	ZCBOR_STATE_D(state_d, 0, payload, sizeof(exp_payload), 10, 0);
+
+	zassert_true(zcbor_uint32_put(state_e, 23), NULL);
+	zassert_true(zcbor_uint32_put(state_e, 24), NULL);
+	zassert_true(zcbor_int32_put(state_e, -24), NULL);
+	zassert_true(zcbor_int32_put(state_e, -25), NULL);
+	zassert_true(zcbor_int8_put(state_e, 0), NULL);
+	zassert_true(zcbor_size_put(state_e, 5), NULL);
+	zassert_true(zcbor_uint8_encode(state_e, &u8), NULL);
+	zassert_true(zcbor_int64_encode(state_e, &i64), NULL);
+	zassert_equal(8, state_e->elem_count, NULL);
+	zassert_equal(sizeof(exp_payload), state_e->payload - payload, NULL);
+	zassert_mem_equal(exp_payload, payload, sizeof(exp_payload), NULL);
+
+	zassert_true(zcbor_uint32_expect(state_d, 23), NULL);
+	zassert_equal_ptr(payload, state_d->payload_bak, NULL);
+	zassert_true(zcbor_uint32_expect(state_d, 24), NULL);
+	zassert_true(zcbor_int32_decode(state_d, &i32), NULL);
+	zassert_equal(-24, i32, NULL);
+	zassert_equal_ptr(&payload[3], state_d->payload_bak, NULL);
+	zassert_true(zcbor_int32_expect(state_d, -25), NULL);
+
+	/* A wrong value or type leaves the state untouched. */
+	zassert_false(zcbor_uint8_expect(state_d, 1), NULL);
+	zassert_equal(ZCBOR_ERR_WRONG_VALUE, zcbor_pop_error(state_d), NULL);
+	zassert_false(zcbor_int32_expect(state_d, -1), NULL);
+	zassert_equal(ZCBOR_ERR_WRONG_VALUE, zcbor_pop_error(state_d), NULL);
+	zassert_equal_ptr(&payload[6], state_d->payload, NULL);
+	zassert_equal(6, state_d->elem_count, NULL);
+	zassert_true(zcbor_uint8_decode(state_d, &u8_result), NULL);
+	zassert_equal(0, u8_result, NULL);
+	zassert_true(zcbor_size_decode(state_d, &size_result), NULL);
+	zassert_equal(5, size_result, NULL);
+	zassert_true(zcbor_uint8_pexpect(state_d, &u8), NULL);
+	zassert_false(zcbor_uint32_decode(state_d, (uint32_t *)&i32), NULL);
+	zassert_equal(ZCBOR_ERR_WRONG_TYPE, zcbor_pop_error(state_d), NULL);
+	zassert_true(zcbor_int64_pexpect(state_d, &i64), NULL);
+	zassert_equal(2, state_d->elem_count, NULL);
+
+	/* The payload ends. */
+	zassert_false(zcbor_uint32_expect(state_d, 23), NULL);
+	zassert_equal(ZCBOR_ERR_NO_PAYLOAD, zcbor_pop_error(state_d), NULL);
+
+	/* The element count is exhausted. */
+	zcbor_new_decode_state(state_d, ZCBOR_ARRAY_SIZE(state_d), payload, sizeof(exp_payload), 1, NULL, 0);
+	zassert_true(zcbor_uint32_expect(state_d, 23), NULL);
+	zassert_false(zcbor_uint32_expect(state_d, 24), NULL);
+	zassert_equal(ZCBOR_ERR_LOW_ELEM_COUNT, zcbor_pop_error(state_d), NULL);
+	zassert_equal_ptr(&payload[1], state_d->payload, NULL);
+
+	/* The payload is full. */
+	zcbor_new_encode_state(state_e, ZCBOR_ARRAY_SIZE(state_e), payload, 1, 0);
+	zassert_true(zcbor_uint32_put(state_e, 1), NULL);
+	zassert_false(zcbor_uint32_put(state_e, 2), NULL);
+	zassert_equal(ZCBOR_ERR_NO_PAYLOAD, zcbor_pop_error(state_e), NULL);
+	zassert_equal(1, state_e->elem_count, NULL);
+
+#ifdef ZCBOR_STOP_ON_ERROR
+	/* A stored error stops the processing. */
+	zcbor_new_decode_state(state_d, ZCBOR_ARRAY_SIZE(state_d), payload, sizeof(exp_payload), 2, NULL, 0);
+	state_d->constant_state->stop_on_error = true;
+	zassert_false(zcbor_uint32_expect(state_d, 2), NULL);
+	zassert_false(zcbor_uint32_expect(state_d, 1), NULL);
+	zassert_equal(ZCBOR_ERR_WRONG_VALUE, zcbor_pop_error(state_d), NULL);
+	zassert_true(zcbor_uint32_expect(state_d, 1), NULL);
+
+	zcbor_new_encode_state(state_e, ZCBOR_ARRAY_SIZE(state_e), payload, 1, 0);
+	state_e->constant_state->stop_on_error = true;
+	zcbor_error(state_e, ZCBOR_ERR_UNKNOWN);
+	zassert_false(zcbor_uint32_put(state_e, 1), NULL);
+	zassert_equal_ptr(payload, state_e->payload, NULL);
+#endif
+}
+
+
 ZTEST_SUITE(zcbor_unit_tests, NULL, NULL, NULL, NULL, NULL);
@@ -7,7 +7,10 @@
 #include <zcbor_decode.h>
 #include <zcbor_encode.h>
 #include <stdio.h>
+#include <string.h>
 #include <pet_decode.h>
+#include <pet.hpp>
+#include <corner_cases.hpp>
 
 int main(void)
 {
@@ -118,6 +121,113 @@ int main(void)
 		return 1;
 	}
 
+	/* The same through the C++ layer (--cpp). */
+	struct Pet pet2;
+	std::optional<pet::Pet> view = zcbor::decode<pet::Pet_codec>(input, pet2);
+
+	if (!view || view->names().size() != 2 || view->names()[0] != "foo"
+			|| view->names()[1] != "bar" || view->birthday().size() != 8
+			|| view->birthday()[7] != 0x08
+			|| view->species_choice() != Pet_species_dog_c) {
+		printf("C++ decode error\r\n");
+		return 1;
+	}
+
+	size_t names_len = 0;
+
+	for (std::string_view name : view->names()) {
+		names_len += name.size();
+	}
+
+	if (names_len != 6) {
+		printf("C++ list_view error\r\n");
+		return 1;
+	}
+
+	uint8_t output[30];
+	std::optional<zcbor::bytes> encoded = zcbor::encode<pet::Pet_codec>(output, pet2);
+	struct Pet pet3;
+	std::optional<pet::Pet> view3;
+
+	if (encoded) {
+		view3 = zcbor::decode<pet::Pet_codec>(*encoded, pet3);
+	}
+
+	if (!view3 || view3->names().size() != 2 || view3->names()[1] != "bar"
+			|| memcmp(view3->birthday().data(), &input[11], 8) != 0
+			|| view3->species_choice() != Pet_species_dog_c) {
+		printf("C++ encode error\r\n");
+		return 1;
+	}
+
+	if (zcbor::decode<pet::Pet_codec>(zcbor::bytes(input, sizeof(input) - 1), pet2)
+			|| zcbor::encode<pet::Pet_codec>(zcbor::span<uint8_t>(output, 5), pet2)) {
+		printf("C++ error not reported\r\n");
+		return 1;
+	}
+
+	/* A map with a union and a repeated member. */
+	uint8_t map_input[] = {
+		0xA4, 0x82, 0x05, 0x06, 0xF5, /* [5,6] => true */
+		0x27, 0x03, /* -8 => 3 */
+		0xF6, 0x40, /* nil => h'' */
+		0xF6, 0x41, 0x01, /* nil => h'01' */
+	};
+	struct Map map;
+	std::optional<corner_cases::Map> map_view = zcbor::decode<corner_cases::Map_codec>(map_input, map);
+
+	if (!map_view || !map_view->listkey() || map_view->Union_choice() != union_nint8uint_c
+			|| map_view->uint7uint() || map_view->nint8uint() != 3u
+			|| map_view->twotothree().size() != 2
+			|| !map_view->twotothree()[0].twotothree().empty()
+			|| map_view->twotothree()[1].twotothree().size() != 1
+			|| map_view->twotothree()[1].twotothree()[0] != 0x01) {
+		printf("C++ map decode error\r\n");
+		return 1;
+	}
+
+	struct Map map2;
+	std::optional<corner_cases::Map> map_view2;
+
+	encoded = zcbor::encode<corner_cases::Map_codec>(output, map);
+
+	if (encoded) {
+		map_view2 = zcbor::decode<corner_cases::Map_codec>(*encoded, map2);
+	}
+
+	if (!map_view2 || map_view2->nint8uint() != 3u || map_view2->twotothree().size() != 2
+			|| map_view2->twotothree()[1].twotothree()[0] != 0x01) {
+		printf("C++ map encode error\r\n");
+		return 1;
+	}
+
+	/* A list with optional members. */
+	uint8_t optional_input[] = {0x85, 0xCA, 0xF5, 0x02, 0x03, 0x08, 0x08};
+	struct Optional optional;
+	std::optional<corner_cases::Optional> optional_view =
+		zcbor::decode<corner_cases::Optional_codec>(optional_input, optional);
+
+	if (!optional_view || !optional_view->boolval() || optional_view->optbool()
+			|| !optional_view->opttwo_present() || optional_view->manduint() != 3
+			|| optional_view->multi8_count() != 2) {
+		printf("C++ optional decode error\r\n");
+		return 1;
+	}
+
+	optional.optbool_present = true;
+	optional.optbool = false;
+	encoded = zcbor::encode<corner_cases::Optional_codec>(output, optional);
+
+	if (encoded) {
+		optional_view = zcbor::decode<corner_cases::Optional_codec>(*encoded, optional);
+	}
+
+	if (!optional_view || optional_view->optbool() != false
+			|| !optional_view->opttwo_present() || optional_view->multi8_count() != 2) {
+		printf("C++ optional encode error\r\n");
+		return 1;
+	}
+
 	printf("Success!\r\n");
 
 	return 0;
@@ -34,6 +34,7 @@ import sys
 from textwrap import wrap, indent
 from codecs import decode as codec_decode
 from math import prod
+from struct import Struct
 
 regex_cache = {}
 indentation = "\t"
@@ -113,6 +114,47 @@ def sizeof(num):
         raise ValueError("Number too large (more than 64 bits).")
 
 
+def min_int_type(min_val, max_val):
+    """The smallest C integer type that can hold all values from min_val to max_val."""
+    for bits in (8, 16, 32, 64):
+        if min_val >= 0 and max_val <= UINT_MAX[bits]:
+            return f"uint{bits}_t"
+        if min_val >= INT_MIN[bits] and max_val <= -INT_MIN[bits] - 1:
+            return f"int{bits}_t"
+    raise ValueError("Number too large (more than 64 bits).")
+
+
+# The alignment of the types used in the generated structs, used for ordering the members with
+# --compact-types. Other structs and pointers get the largest alignment.
+type_alignments = {
+    "bool": 1,
+    "uint8_t": 1,
+    "int8_t": 1,
+    "uint16_t": 2,
+    "int16_t": 2,
+    "uint32_t": 4,
+    "int32_t": 4,
+    "float": 4,
+    "struct zcbor_string_off": 4,
+}
+
+
+def member_alignment(member):
+    """Estimate the alignment of a struct member from the lines of its declaration.
+
+    Bitfields get 0, so they are placed last, next to each other.
+    """
+    first = member[0]
+    if first.endswith("{"):
+        return 4 if first.startswith("enum") else 8
+    if ":" in first:
+        return 0
+    var_type = first.rsplit(" ", 1)[0]
+    if "*" in first:
+        return 8
+    return type_alignments.get(var_type, 8)
+
+
 def verbose_print(verbose_flag, *things):
     """Print only if verbose"""
     if verbose_flag:
@@ -214,6 +256,52 @@ def assign_tmp_str(value):
     return f"(tmp_str.value = (uint8_t *){value}, tmp_str.len = sizeof({value}) - 1, &tmp_str)"
 
 
+def c_str_literal_len(literal):
+    """Return the number of bytes in a C string literal (excluding the null terminator).
+
+    Return None if the literal contains something this function doesn't understand."""
+    if not (len(literal) >= 2 and literal[0] == '"' and literal[-1] == '"'):
+        return None
+    body = literal[1:-1]
+    length = 0
+    pos = 0
+    escape_re = getrp(r"\\(x[\da-fA-F]+|u[\da-fA-F]{4}|U[\da-fA-F]{8}|[0-7]{1,3}|[abfnrtv\\'\"?])")
+    while pos < len(body):
+        if body[pos] != "\\":
+            length += len(body[pos].encode("utf-8"))
+            pos += 1
+            continue
+        match = escape_re.match(body, pos)
+        if not match:
+            return None
+        esc = match.group(1)
+        if esc[0] in "uU":
+            length += len(chr(int(esc[1:], 16)).encode("utf-8"))
+        else:
+            length += 1
+        pos = match.end()
+    return length
+
+
+def encoded_str_literal(literal, major_type):
+    """Return a C string literal containing a CBOR bstr or tstr (header + contents) with the value
+    of the given C string literal.
+
+    Return None if the length of the literal could not be determined."""
+    length = c_str_literal_len(literal)
+    if length is None:
+        return None
+    header_byte = major_type << 5
+    if length <= 23:
+        header = bytes([header_byte | length])
+    else:
+        num_bytes = 1 if length <= 0xFF else 2 if length <= 0xFFFF else 4
+        header = bytes([header_byte | {1: 24, 2: 25, 4: 26}[num_bytes]]) + length.to_bytes(
+            num_bytes, "big"
+        )
+    return '"' + "".join(f"\\x{b:02x}" for b in header) + '" ' + literal
+
+
 def deref_if_not_null(access):
     return access if access == "NULL" else "&" + access
 
@@ -244,6 +332,15 @@ def struct_ptr_name(mode):
     return "result" if mode == "decode" else "input"
 
 
+def cpp_c_type(c_type):
+    """Return how the C++ code (--cpp) refers to a C type, i.e. with the struct or enum in the
+    global namespace instead of the elaborated type specifier."""
+    for prefix in ("struct ", "enum "):
+        if c_type.startswith(prefix):
+            return "::" + c_type.removeprefix(prefix)
+    return c_type
+
+
 def ternary_if_chain(access, names, xcode_strings):
     return "((%s == %s) ? %s%s: %s)" % (
         access,
@@ -2513,6 +2610,8 @@ class XcoderTuple(NamedTuple):
     body: list
     func_name: str
     type_name: str
+    # Whether the function also takes the index of the element in a struct-of-arrays.
+    soa: bool = False
 
 
 class CddlTypes(NamedTuple):
@@ -2532,6 +2631,12 @@ class CodeGenerator(CddlXcoder):
         default_bit_size=defaults["default_bit_size"],
         default_max_qty_define="ZCBOR_DEFAULT_MAX_QTY",
         unordered_maps=False,
+        repeated_arena=False,
+        raw_types=(),
+        soa_types=(),
+        compact_types=False,
+        string_offsets=False,
+        cpp=False,
         **kwargs,
     ):
         super(CodeGenerator, self).__init__(**kwargs)
@@ -2541,15 +2646,61 @@ class CodeGenerator(CddlXcoder):
         self.default_bit_size = default_bit_size
         self.default_max_qty_define = default_max_qty_define
         self.unordered_maps = unordered_maps
+        # Whether repeated members are pointers into a struct zcbor_arena instead of arrays.
+        self.repeated_arena = repeated_arena
+        # Whether to pass the contents to a callback instead of returning them (decode only).
+        # Set on the bstr types listed in --stream-bstr-types.
+        self.stream_bstr = False
+        # The types listed in --raw-types. "any" means all "any" elements.
+        self.raw_types = raw_types
+        # Whether this type was listed in --raw-types. See set_raw().
+        self.raw = False
+        # The types listed in --soa-types.
+        self.soa_types = soa_types
+        # Whether to make the generated structs smaller (--compact-types).
+        self.compact_types = compact_types
+        # Whether strings are stored as struct zcbor_string_off instead of struct zcbor_string.
+        self.string_offsets = string_offsets
+        # Whether the generated types are also used from C++ (--cpp). See choice_var().
+        self.cpp = cpp
+        # Whether to declare the "choice" enum outside the struct, like with --cpp. Set on the
+        # members of the types listed in --view-entry-types, see set_named_choice_enums().
+        self.named_choice_enum = False
+        # The size of the arrays in the struct-of-arrays for this type, if it is repeated
+        # somewhere and listed in --soa-types. See set_soa_max_qty().
+        self.soa_max_qty = None
+        # The index variable to add to the accesses of this element's variables, when it is a
+        # member of a type listed in --soa-types, and its struct-of-arrays function is generated.
+        self.soa_index = None
 
     @classmethod
     def from_cddl(cddl_class, *, mode, **kwargs):
         cddl_res = super(CodeGenerator, cddl_class).from_cddl(mode=mode, **kwargs)
 
+        for name in kwargs.get("raw_types", ()):
+            if name == "any":
+                continue
+            if name not in cddl_res.my_types:
+                raise CddlParsingError(f"--raw-types: {name} is not a type.")
+            cddl_res.my_types[name].set_raw()
+
         # set access prefix (struct access paths) for all the definitions.
         for my_type in cddl_res.my_types:
             cddl_res.my_types[my_type].set_access_prefix(f"(*{struct_ptr_name(mode)})")
 
+        for name in kwargs.get("soa_types", ()):
+            if name not in cddl_res.my_types:
+                raise CddlParsingError(f"--soa-types: {name} is not a type.")
+            if error := cddl_res.my_types[name].soa_error():
+                raise CddlParsingError(f"--soa-types: Cannot use {name} because {error}.")
+        for my_type in cddl_res.my_types.values():
+            for site in my_type.soa_sites():
+                cddl_res.my_types[site.value].set_soa_max_qty(site)
+
+        if kwargs.get("string_offsets"):
+            for my_type in cddl_res.my_types.values():
+                my_type.check_string_offsets()
+
         return cddl_res
 
     def is_entry_type(self):
@@ -2575,8 +2726,140 @@ class CodeGenerator(CddlXcoder):
             "default_bit_size": self.default_bit_size,
             "default_max_qty_define": self.default_max_qty_define,
             "unordered_maps": self.unordered_maps,
+            "repeated_arena": self.repeated_arena,
+            "raw_types": self.raw_types,
+            "soa_types": self.soa_types,
+            "compact_types": self.compact_types,
+            "string_offsets": self.string_offsets,
+            "cpp": self.cpp,
         }
 
+    def set_named_choice_enums(self):
+        """Declare the "choice" enums of this element and its children outside the struct, so
+        the member structs of a view (--view-entry-types) can use the same enums as the result
+        struct. Anonymous enums can't be declared twice, since their values would collide.
+        """
+        self.named_choice_enum = True
+        self.recurse(self.__class__.set_named_choice_enums)
+
+    def set_raw(self):
+        """Make this type definition capture the encoded bytes of its value instead of
+        decoding it (--raw-types). The value is then only checked for being well-formed.
+        """
+        if self.type == "GROUP" or self.min_qty != 1 or self.max_qty != 1:
+            raise CddlParsingError(f"--raw-types: {self} is not a single data item.")
+        self.type = "ANY"
+        self.value = None
+        self.tags = []
+        self.cbor = None
+        self.size = self.min_size = self.max_size = None
+        self.min_value = self.max_value = None
+        self.raw = True
+
+    def is_raw(self):
+        """Whether this element's value is returned as its encoded bytes (--raw-types)."""
+        return self.type == "ANY" and (self.raw or "any" in self.raw_types)
+
+    def is_unambiguous_value(self):
+        """Override the is_unambiguous_value() function, since raw elements have a value."""
+        return super().is_unambiguous_value() and not self.is_raw()
+
+    def soa_error(self):
+        """Return why this type can't be used with --soa-types, or None if it can.
+
+        Only flat records are supported, i.e. lists or maps of single scalar values, so each
+        member can be placed in an array of its own.
+        """
+        if self.type not in ["LIST", "MAP"] or self.key or self.cbor or self.is_raw():
+            return "it is not a plain list or map"
+        if self.min_qty != 1 or self.max_qty != 1:
+            return "it is repeated"
+        for child in self.value:
+            if (
+                child.type not in ["INT", "UINT", "NINT", "FLOAT", "BSTR", "TSTR", "BOOL"]
+                or child.cbor
+                or child.count_var_condition()
+                or (child.key and not child.key.is_unambiguous())
+                or child.is_delegated_type()
+            ):
+                return f"its member {child.get_base_name()} is not a single scalar value"
+            if child.repeated_single_func_impl_condition():
+                return f"its member {child.get_base_name()} is optional and has a key"
+        if all(child.is_unambiguous() for child in self.value):
+            return "it has no members to store"
+        return None
+
+    def is_soa(self):
+        """Whether this element is a repetition of a type listed in --soa-types."""
+        return self.type == "OTHER" and self.value in self.soa_types and self.count_var_condition()
+
+    def soa_sites(self):
+        """Return the repetitions of types listed in --soa-types in this element."""
+        if self.is_soa():
+            if self.repeated_single_func_impl_condition():
+                raise CddlParsingError(
+                    f"--soa-types: The repetition of {self.value} must not have a key or tags."
+                )
+            yield self
+        if self.type in ["LIST", "MAP", "GROUP", "UNION"]:
+            for child in self.value:
+                yield from child.soa_sites()
+        for elem in (self.key, self.cbor):
+            if elem:
+                yield from elem.soa_sites()
+
+    def set_soa_max_qty(self, site):
+        """Size the arrays of this type's struct-of-arrays after the repetition at site."""
+        max_qty = site.max_qty if site.max_qty is not None else site.default_max_qty_define
+        if self.soa_max_qty not in (None, max_qty):
+            raise CddlParsingError(
+                f"--soa-types: {site.value} is repeated with different maximums "
+                f"({self.soa_max_qty} and {max_qty})."
+            )
+        self.soa_max_qty = max_qty
+
+    def access_append(self, *suffix):
+        """Override the access_append() function to index the arrays in a struct-of-arrays."""
+        access = super().access_append(*suffix)
+        return f"{access}[{self.soa_index}]" if self.soa_index and suffix else access
+
+    def soa_type_name(self):
+        return f"{self.raw_type_name()}_soa"
+
+    def soa_func_name(self):
+        return f"{self.xcode_func_name()}_soa"
+
+    def soa_bitmap_access(self):
+        """The "present" bitmap of this element in a struct-of-arrays."""
+        return super().access_append(self.present_var_name())
+
+    def soa_declaration(self):
+        """Declaration of the struct-of-arrays for this type (--soa-types).
+
+        Each member gets an array, and each optional member a bitmap of which elements have it.
+        """
+        decl = []
+        for child in self.value:
+            if not child.is_unambiguous_repeated():
+                decl.append(f"{child.val_type_name()} {child.var_name()}[{self.soa_max_qty}];")
+            if child.present_var_condition():
+                decl.append(
+                    f"uint8_t {child.present_var_name()}[ZCBOR_SOA_BITMAP_LEN({self.soa_max_qty})];"
+                )
+        return self.enclose("struct", self.struct_members(decl))
+
+    def xcode_soa(self):
+        """Return the body of the function that encodes/decodes a single element of this type
+        from/to a struct-of-arrays, at the index given by the "index" argument.
+        """
+        for child in self.value:
+            child.soa_index = "index"
+        try:
+            return self.xcode()
+        finally:
+            for child in self.value:
+                child.soa_index = None
+
     def delegate_type_condition(self):
         """Whether to use the C type of the first child as this type's C type"""
         ret = self.skip_condition() and (
@@ -2592,23 +2875,64 @@ class CodeGenerator(CddlXcoder):
 
     def present_var(self):
         """Declaration of the "present" variable for this element."""
+        if self.compact_types:
+            return ["bool %s : 1;" % self.present_var_name()]
         return ["bool %s;" % self.present_var_name()]
 
+    def count_type_name(self):
+        """The type of the "count" variable. With --compact-types, it is the smallest type that
+        can hold the maximum quantity, if that is known."""
+        if self.compact_types and isinstance(self.max_qty, int):
+            return min_int_type(0, self.max_qty)
+        return "size_t"
+
     def count_var(self):
         """Declaration of the "count" variable for this element."""
-        return ["size_t %s;" % self.count_var_name()]
+        return [f"{self.count_type_name()} {self.count_var_name()};"]
 
     def anonymous_choice_var(self):
         """Declaration of the "choice" variable for this element."""
         int_vals = self.all_children_int_disambiguated()
         return self.enclose("enum", [val.enum_var(int_vals) + "," for val in self.value])
 
+    def choice_enum_type_name(self):
+        """With --compact-types or --cpp, or in a view (see set_named_choice_enums()), the enum
+        is declared outside the struct, with this name."""
+        return f"enum {self.id()}_choice"
+
+    def choice_type_name(self):
+        """The type of the "choice" variable with --compact-types, i.e. the smallest type that
+        can hold all the enum values."""
+        if self.all_children_int_disambiguated():
+            values = [child.int_val() for child in self.value]
+            return min_int_type(min(values), max(values))
+        return min_int_type(0, len(self.value) - 1)
+
     def choice_var(self):
         """Declaration of the "choice" variable for this element."""
+        if self.compact_types:
+            return [f"{self.choice_type_name()} {self.choice_var_name()};"]
+        if self.cpp or self.named_choice_enum:
+            # C++ doesn't allow declaring enums inside anonymous structs.
+            return [f"{self.choice_enum_type_name()} {self.choice_var_name()};"]
         var = self.anonymous_choice_var()
         var[-1] += f" {self.choice_var_name()};"
         return var
 
+    def struct_members(self, decl):
+        """With --compact-types, order the members of a struct by decreasing alignment, to
+        minimize padding. The order is kept for members with the same alignment."""
+        if not self.compact_types:
+            return decl
+        members = []
+        for line in decl:
+            if members and (line.startswith(indentation) or line.startswith("}")):
+                members[-1].append(line)
+            else:
+                members.append([line])
+        members.sort(key=lambda member: -member_alignment(member))
+        return [line for member in members for line in member]
+
     def child_declarations(self):
         """Declaration of the variables of all children."""
         decl = [line for child in self.value for line in child.full_declaration()]
@@ -2703,12 +3027,12 @@ class CodeGenerator(CddlXcoder):
             "UINT": lambda: f"uint{self.bit_size()}_t",
             "NINT": lambda: f"int{self.bit_size()}_t",
             "FLOAT": lambda: self.float_type(),
-            "BSTR": lambda: "struct zcbor_string",
-            "TSTR": lambda: "struct zcbor_string",
+            "BSTR": lambda: self.string_type_name(),
+            "TSTR": lambda: self.string_type_name(),
             "BOOL": lambda: "bool",
             "NIL": lambda: None,
             "UNDEF": lambda: None,
-            "ANY": lambda: None,
+            "ANY": lambda: "struct zcbor_string" if self.is_raw() else None,
             "LIST": lambda: self.value[0].type_name() if len(self.value) >= 1 else None,
             "MAP": lambda: self.value[0].type_name() if len(self.value) >= 1 else None,
             "GROUP": lambda: self.value[0].type_name() if len(self.value) >= 1 else None,
@@ -2743,14 +3067,18 @@ class CodeGenerator(CddlXcoder):
     def add_var_name(self, var_type, full=False, anonymous=False):
         """Take a multi member type name and create a variable declaration.
 
-        Make it an array if the element is repeated.
+        Make it an array if the element is repeated, or a pointer into the arena with
+        --repeated-arena.
         """
         if var_type:
             assert var_type[-1][-1] == "}" or len(var_type) == 1, f"Expected single var: {var_type!r}"
             if not anonymous or var_type[-1][-1] != "}":
                 var_name = self.var_name()
-                max_qty = self.max_qty if self.max_qty is not None else self.default_max_qty_define
-                var_type[-1] += f' {var_name}{f"[{max_qty}]" if full and self.max_qty != 1 else ""}'
+                if full and self.max_qty != 1 and self.repeated_arena:
+                    var_type[-1] += f" *{var_name}"
+                else:
+                    max_qty = self.max_qty if self.max_qty is not None else self.default_max_qty_define
+                    var_type[-1] += f' {var_name}{f"[{max_qty}]" if full and self.max_qty != 1 else ""}'
             var_type = add_semicolon(var_type)
         return var_type
 
@@ -2821,6 +3149,8 @@ class CodeGenerator(CddlXcoder):
         if self.multi_var_condition():
             if self.is_unambiguous_repeated():
                 decl = []
+            elif self.is_soa():
+                decl = [f"{self.my_types[self.value].soa_type_name()} {self.var_name()};"]
             else:
                 decl = self.add_var_name(
                     [self.repeated_type_name()] if self.repeated_type_name() is not None else [],
@@ -2851,9 +3181,9 @@ class CodeGenerator(CddlXcoder):
         repeated part is used.
         """
         if full and self.multi_member():
-            return self.enclose("struct", self.full_declaration())
+            return self.enclose("struct", self.struct_members(self.full_declaration()))
         elif not full and self.repeated_multi_var_condition():
-            return self.enclose("struct", self.repeated_declaration())
+            return self.enclose("struct", self.struct_members(self.repeated_declaration()))
         else:
             return self.var_type()
 
@@ -2866,6 +3196,8 @@ class CodeGenerator(CddlXcoder):
             )
         if self.bits:
             ret_val.extend(self.my_control_groups[self.bits.value].type_def_bits())
+        if (self.compact_types or self.cpp or self.named_choice_enum) and self.choice_var_condition():
+            ret_val.extend([(self.anonymous_choice_var(), self.choice_enum_type_name())])
         if self.cbor_var_condition():
             ret_val.extend(self.cbor.type_def())
         if self.reduced_key_var_condition():
@@ -2880,6 +3212,8 @@ class CodeGenerator(CddlXcoder):
             type_def_list = self.single_var_type()
             if type_def_list:
                 ret_val.extend([(type_def_list, self.type_name())])
+        if self.soa_max_qty is not None:
+            ret_val.extend([(self.soa_declaration(), self.soa_type_name())])
         return ret_val
 
     def type_def_bits(self):
@@ -2908,6 +3242,33 @@ class CodeGenerator(CddlXcoder):
         else:
             raise ValueError("Floats must have 2, 4 or 8 bytes of precision.")
 
+    def is_string_off(self):
+        """Whether this element is a string stored as a struct zcbor_string_off
+        (--string-offsets).
+
+        CBOR-encoded bstrs (.cbor) are kept as struct zcbor_string, since they are decoded
+        and encoded with zcbor_bstr_start_*(), which need a pointer to the contents.
+        """
+        return (
+            self.string_offsets
+            and self.type in ["BSTR", "TSTR"]
+            and not self.stream_bstr
+            and self.cbor is None
+            and not self.is_unambiguous_value()
+        )
+
+    def check_string_offsets(self):
+        """Raise an error for elements that cannot be stored as struct zcbor_string_off."""
+        if self.is_string_off() and self.default is not None:
+            raise CddlParsingError(
+                f"--string-offsets: {self.get_base_name()} has a .default value, which cannot be "
+                "an offset into the payload."
+            )
+        self.recurse(CodeGenerator.check_string_offsets)
+
+    def string_type_name(self):
+        return "struct zcbor_string_off" if self.is_string_off() else "struct zcbor_string"
+
     def single_func_prim_prefix(self):
         if self.type == "OTHER":
             return self.my_types[self.value].single_func_prim_prefix()
@@ -2938,7 +3299,11 @@ class CodeGenerator(CddlXcoder):
         func_prefix = self.single_func_prim_prefix()
         if self.mode == "decode":
             if self.type == "ANY":
-                func = "zcbor_any_skip"
+                func = "zcbor_raw_decode" if self.is_raw() else "zcbor_any_skip"
+            elif self.stream_bstr:
+                func = "zcbor_bstr_stream_decode"
+            elif self.is_string_off():
+                func = f"{func_prefix}_off_decode"
             elif not self.is_unambiguous_value():
                 func = f"{func_prefix}_decode"
             elif not union_int:
@@ -2950,7 +3315,9 @@ class CodeGenerator(CddlXcoder):
                 return None
         else:
             if self.type == "ANY":
-                func = "zcbor_nil_put"
+                func = "zcbor_raw_encode" if self.is_raw() else "zcbor_nil_put"
+            elif self.is_string_off():
+                func = f"{func_prefix}_off_encode"
             elif (not self.is_unambiguous_value()) or self.type in ["TSTR", "BSTR"] or ptr_variant:
                 func = f"{func_prefix}_encode"
             else:
@@ -2977,12 +3344,18 @@ class CodeGenerator(CddlXcoder):
         if func_name is None:
             return (None, None)
 
-        if self.type in ["NIL", "UNDEF", "ANY"]:
+        if self.type in ["NIL", "UNDEF", "ANY"] and not self.is_raw():
             arg = "NULL"
         elif not self.is_unambiguous_value():
             arg = deref_if_not_null(access)
         elif self.type in ["BSTR", "TSTR"]:
             arg = assign_tmp_str(self.val_define_name_or_lit("VAL"))
+            if func_name == "zcbor_tstr_expect":
+                # Match against the whole encoded string instead of decoding the header.
+                encoded = encoded_str_literal(self.val_define_value("VAL"), 3)
+                if encoded is not None:
+                    func_name = "zcbor_tstr_expect_encoded"
+                    arg = assign_tmp_str(encoded)
         elif self.type in ["UINT", "INT", "NINT", "FLOAT", "BOOL"]:
             value = self.val_define_name_or_lit("VAL")
             arg = f"&({self.val_type_name()}){{{value}}}" if ptr_result else value
@@ -3066,13 +3439,13 @@ class CodeGenerator(CddlXcoder):
                 return str(prod(int(x) for x in filtered_it))
             return " * ".join(filtered_it) if filtered_it else "1"
 
-        def s_round_bits_to_nearest_byte(bits_str):
+        def s_round_bits_to_nearest_word(bits_str):
             if bits_str in ("", "0"):
                 return ""
             elif bits_str.isdigit():
-                return str(divide_round_up(int(bits_str), 8) * 8)
+                return str(divide_round_up(int(bits_str), 32) * 32)
             else:
-                return f"ZCBOR_ROUND_UP({bits_str}, 8)"
+                return f"ZCBOR_ROUND_UP({bits_str}, 32)"
 
         total_this = ""  # Number of flags needed for the current map
         total_nested = ""  # Number of flags needed for nested maps
@@ -3097,10 +3470,10 @@ class CodeGenerator(CddlXcoder):
             )
             total_nested = s_max([total_nested] + list(c_nested_flags))
             if self.type == "MAP":
-                # Round up to the nearest byte because only whole bytes worth of flags can be
-                # reserved per map.
+                # Round up to the nearest 32 bits because only whole words of flags
+                # (zcbor_flag_word_t) can be reserved per map.
                 # Also, this is where the flag count is moved from "this" map to a "nested" map.
-                c_flags_rounded = s_round_bits_to_nearest_byte(s_sum(c_flags))
+                c_flags_rounded = s_round_bits_to_nearest_word(s_sum(c_flags))
                 if c_flags_rounded not in ("", "0"):
                     if self.unordered_maps:
                         multiplier = 1 + max(c_total_multi_decode) + max(c_total_unions)
@@ -3261,8 +3634,13 @@ class CodeGenerator(CddlXcoder):
             if self.cbor.elem_needs_map_smart_search(False):
                 return True
 
-    def xcode_list(self):
-        """Return the full code needed to encode/decode a "LIST" or "MAP" element with children."""
+    def xcode_list(self, view_members=None):
+        """Return the full code needed to encode/decode a "LIST" or "MAP" element with children.
+
+        If view_members is given (see view_members()), record the position of those children
+        in the view struct, and decode each of them with its view function into its own member
+        of the member_tmp union (see render_view_functions()).
+        """
         start_func = f"zcbor_{self.type.lower()}_start_{self.mode}"
         end_func = f"zcbor_{self.type.lower()}_end_{self.mode}"
         end_func_force = f"zcbor_list_map_end_force_{self.mode}"
@@ -3288,9 +3666,18 @@ class CodeGenerator(CddlXcoder):
             zip(*(child.list_counts() for child in self.value)) if self.value else ((0,), (0,))
         )
         count_arg = f", {sum_or_none(max_counts, default=0)}" if self.mode == "encode" else ""
+        view_names = {id(child): name for name, child in (view_members or {}).items()}
+
+        def child_xcode(child):
+            if id(child) not in view_names:
+                return child.full_xcode()
+            name = view_names[id(child)]
+            record = f"zcbor_view_pos_record(state, view->raw.value, &view->{name})"
+            return f"({record}{newl_ind}&& {self.view_func_name(name)}(state, &member_tmp.{name}))"
+
         with_children = "(%s && ((%s) || (%s, false)) && %s)" % (
             f"{start_func}(state{count_arg})",
-            f"{newl_ind}&& ".join(child.full_xcode() for child in self.value),
+            f"{newl_ind}&& ".join(child_xcode(child) for child in self.value),
             f"{end_func_force}(state)",
             f"{end_func}(state{count_arg})",
         )
@@ -3656,6 +4043,27 @@ class CodeGenerator(CddlXcoder):
         else:
             return "sizeof(%s)" % self.repeated_type_name()
 
+    def count_arg(self):
+        """The size_t pointer to pass to zcbor_multi_decode() etc. for the "count" variable.
+
+        With --compact-types, the "count" variable might not be a size_t, so a temporary
+        variable is used instead.
+        """
+        if self.count_type_name() == "size_t":
+            return f"&{self.count_var_access()}"
+        if self.mode == "decode":
+            return "&tmp_count"
+        return f"&(size_t){{{self.count_var_access()}}}"
+
+    def assign_count(self, multi_call):
+        """Assign the temporary variable from count_arg() to the "count" variable, if used."""
+        if self.mode == "decode" and self.count_type_name() != "size_t":
+            return (
+                f"({multi_call} && (({self.count_var_access()} = "
+                f"({self.count_type_name()})tmp_count), true))"
+            )
+        return multi_call
+
     def multi_decode_w_backup_condition(self):
         return (
             self.count_var_condition() or self.present_var_condition()
@@ -3667,9 +4075,14 @@ class CodeGenerator(CddlXcoder):
         Including children, key, cbor, and repetitions.
         """
         if self.present_var_condition():
+            present = (
+                f"ZCBOR_SOA_PRESENT({self.soa_bitmap_access()}, {self.soa_index})"
+                if self.soa_index
+                else self.present_var_access()
+            )
             if self.mode == "encode":
                 func, *arguments = self.repeated_single_func(ptr_result=False)
-                return f"(!{self.present_var_access()} || {func}({xcode_args(*arguments)}))"
+                return f"(!{present} || {func}({xcode_args(*arguments)}))"
             else:
                 assert (
                     self.mode == "decode"
@@ -3700,34 +4113,72 @@ class CodeGenerator(CddlXcoder):
                     default_assignment = f"({access} = {default_value})"
                 if assign:
                     decode_str = self.repeated_xcode(union_int)
+                    if self.soa_index:
+                        return comma_operator(
+                            default_assignment,
+                            f"zcbor_soa_present_set({self.soa_bitmap_access()}, "
+                            f"{self.soa_index}, {decode_str})",
+                        )
                     return comma_operator(
                         default_assignment, f"{self.present_var_access()} = {decode_str}", "true"
                     )
+                assert not self.soa_index, "Optional members with their own function can't be in a SoA."
                 func, *arguments = self.repeated_single_func(ptr_result=True)
                 present_func = (
                     "zcbor_present_decode"
                     if not self.multi_decode_w_backup_condition()
                     else "zcbor_present_decode_w_backup"
                 )
+                if self.compact_types:
+                    # The "present" variable is a bitfield, which can't be passed by pointer.
+                    return comma_operator(
+                        default_assignment,
+                        f"({present_func}(&tmp_present, ZCBOR_CUSTOM_CAST_FP({func}), {xcode_args(*arguments)})"
+                        f" && (({self.present_var_access()} = tmp_present), true))",
+                    )
                 return comma_operator(
                     default_assignment,
                     f"({present_func}(&({self.present_var_access()}), ZCBOR_CUSTOM_CAST_FP({func}), {xcode_args(*arguments)}))",
                 )
 
+        elif self.is_soa():
+            multi_func = (
+                "zcbor_multi_decode_soa" if self.mode == "decode" else "zcbor_multi_encode_soa_minmax"
+            )
+            equal = self.min_qty == self.max_qty and self.min_qty is not None
+            return self.assign_count(
+                f"{multi_func}(%s, %s, %s, ZCBOR_CUSTOM_CAST_FP(%s), %s)"
+                % (
+                    self.val_define_name_or_lit("MIN_QTY" if not equal else "QTY"),
+                    self.val_define_name_or_lit("MAX_QTY" if not equal else "QTY"),
+                    self.count_arg(),
+                    self.my_types[self.value].soa_func_name(),
+                    xcode_args(f"&{self.repeated_val_access()}"),
+                )
+            )
         elif self.count_var_condition():
             func, arg = self.repeated_single_func(ptr_result=True)
 
+            stored = arg != "NULL" and self.result_len() != "0"
+            # With --repeated-arena, the decoder places the elements in the arena and
+            # assigns the pointer, so it gets the address of the pointer.
+            arena = self.mode == "decode" and self.repeated_arena and stored
             multi_func = "zcbor_multi_decode" if self.mode == "decode" else "zcbor_multi_encode_minmax"
+            if arena:
+                multi_func += "_arena"
             if self.mode == "decode" and self.multi_decode_w_backup_condition():
-                multi_func = "zcbor_multi_decode_w_backup"
+                multi_func += "_w_backup"
             equal = self.min_qty == self.max_qty and self.min_qty is not None
-            return f"{multi_func}(%s, %s, &%s, ZCBOR_CUSTOM_CAST_FP(%s), %s, %s)" % (
-                self.val_define_name_or_lit("MIN_QTY" if not equal else "QTY"),
-                self.val_define_name_or_lit("MAX_QTY" if not equal else "QTY"),
-                self.count_var_access(),
-                func,
-                xcode_args("*" + arg if arg != "NULL" and self.result_len() != "0" else arg),
-                self.result_len(),
+            return self.assign_count(
+                f"{multi_func}(%s, %s, %s, ZCBOR_CUSTOM_CAST_FP(%s), %s, %s)"
+                % (
+                    self.val_define_name_or_lit("MIN_QTY" if not equal else "QTY"),
+                    self.val_define_name_or_lit("MAX_QTY" if not equal else "QTY"),
+                    self.count_arg(),
+                    func,
+                    xcode_args(arg if arena else "*" + arg if stored else arg),
+                    self.result_len(),
+                )
             )
         else:
             return self.repeated_xcode(union_int=union_int, top_level=top_level)
@@ -3762,6 +4213,96 @@ class CodeGenerator(CddlXcoder):
         if self.single_func_impl_condition():
             xcode_body = self.xcode()
             yield XcoderTuple(xcode_body, self.xcode_func_name(), self.type_name())
+        if self.soa_max_qty is not None:
+            yield XcoderTuple(self.xcode_soa(), self.soa_func_name(), self.soa_type_name(), soa=True)
+
+    def view_error(self):
+        """Return why this element can't be used with --view-entry-types, or None if it can."""
+        if self.mode != "decode":
+            return "views are only generated for decoding"
+        if self.type not in ["LIST", "MAP"] or self.key or self.tags or self.cbor:
+            return "it is not a plain list or map"
+        if self.min_qty != 1 or self.max_qty != 1 or not self.type_name().startswith("struct "):
+            return "it is not decoded into a struct"
+        if self.type == "MAP" and self.unordered_maps:
+            return "its members can come in any order (--unordered-maps)"
+        if not self.view_members():
+            return "it has no members to access"
+        return None
+
+    def view_members(self):
+        """Return the children that get a position and an accessor in the view struct, by name.
+
+        These are the children that store their result in the struct. The others are only
+        validated.
+        """
+        members = dict()
+        for child in self.value:
+            if struct_ptr_name(self.mode) not in child.full_xcode():
+                continue
+            name = child.get_base_name()
+            if name in c_keywords:
+                name = name.capitalize()
+            elif name in c_keywords_underscore:
+                name = "_" + name
+            if name in members or name == "raw":
+                name = f"{name}_{len(members)}"
+            members[name] = child
+        return members
+
+    def view_type_name(self):
+        return f"{self.type_name()}_view"
+
+    def view_func_name(self, member=None):
+        return f"{self.xcode_func_name()}_view" + (f"_{member}" if member else "")
+
+    def view_member_has_struct(self, member):
+        """Whether the member is decoded into its own struct. It isn't if this type's struct
+        is the member's struct (a list or map with a single struct member)."""
+        return not self.view_members()[member].is_delegated_type()
+
+    def view_member_type_name(self, member):
+        if not self.view_member_has_struct(member):
+            return self.type_name()
+        return f"{self.view_type_name()}_{member}"
+
+    def view_member_declaration(self, member):
+        """The declaration of the struct that a member of the view is decoded into. It has the
+        same variables as the member has in the result struct, so the member's code can be
+        used with either."""
+        child = self.view_members()[member]
+        return self.enclose(
+            self.view_member_type_name(member), self.struct_members(child.full_declaration())
+        )
+
+    def xcode_view(self):
+        """Return the body of the function that validates this element, and records the
+        positions of its members in the view struct (--view-entry-types).
+        """
+        return self.xcode_list(view_members=self.view_members())
+
+    def public_view_func_sig(self, member=None):
+        if member:
+            return f"""
+int cbor_{self.view_func_name(member)}(
+		const {self.view_type_name()} *view, {self.view_member_type_name(member)} *{struct_ptr_name(self.mode)})"""
+        return f"""
+int cbor_{self.view_func_name()}(
+		const uint8_t *payload, size_t payload_len,
+		{self.view_type_name()} *view,
+		size_t *payload_len_out)"""
+
+    def arena_arg(self):
+        """The extra entry function argument with --repeated-arena."""
+        return (
+            ",\n\t\tstruct zcbor_arena *arena" if self.mode == "decode" and self.repeated_arena else ""
+        )
+
+    def string_base_arg(self):
+        """The extra entry function argument with --string-offsets."""
+        return (
+            ",\n\t\tconst uint8_t *string_base" if self.mode == "encode" and self.string_offsets else ""
+        )
 
     def public_xcode_func_sig(self):
         type_name = self.type_name() if struct_ptr_name(self.mode) in self.full_xcode() else "void"
@@ -3769,7 +4310,167 @@ class CodeGenerator(CddlXcoder):
 int cbor_{self.xcode_func_name()}(
 		{"const " if self.mode == "decode" else ""}uint8_t *payload, size_t payload_len,
 		{"" if self.mode == "decode" else "const "}{type_name} *{struct_ptr_name(self.mode)},
-		{"size_t *payload_len_out"})"""
+		{"size_t *payload_len_out"}{self.arena_arg()}{self.string_base_arg()})"""
+
+    def public_states_func_sig(self):
+        type_name = self.type_name() if struct_ptr_name(self.mode) in self.full_xcode() else "void"
+        return f"""
+int cbor_{self.xcode_func_name()}_with_states(
+		{"const " if self.mode == "decode" else ""}uint8_t *payload, size_t payload_len,
+		{"" if self.mode == "decode" else "const "}{type_name} *{struct_ptr_name(self.mode)},
+		size_t *payload_len_out, zcbor_state_t *states, size_t n_states{self.arena_arg()}{self.string_base_arg()})"""
+
+    def public_stream_func_sig(self):
+        type_name = self.type_name() if struct_ptr_name(self.mode) in self.full_xcode() else "void"
+        return f"""
+int cbor_{self.xcode_func_name()}_stream(
+		const uint8_t *payload, size_t payload_len,
+		{type_name} *{struct_ptr_name(self.mode)},
+		size_t *payload_len_out, zcbor_chunk_cb_t chunk_cb, void *chunk_ctx)"""
+
+    def num_states_define_name(self):
+        return f"CBOR_{self.xcode_func_name().upper()}_NUM_STATES"
+
+    def public_seq_func_sig(self):
+        type_name = self.type_name() if struct_ptr_name(self.mode) in self.full_xcode() else "void"
+        return f"""
+int cbor_{self.xcode_func_name()}_seq(
+		{"const " if self.mode == "decode" else ""}uint8_t *payload, size_t payload_len,
+		{"" if self.mode == "decode" else "const "}{type_name} *{struct_ptr_name(self.mode)}, size_t max_results,
+		size_t *num_results, size_t *payload_len_out)"""
+
+    def cpp_str_type(self):
+        """The CDDL type of the value that this element's string variable holds."""
+        if self.type == "OTHER":
+            return self.my_types[self.value].cpp_str_type()
+        if self.type in ["LIST", "MAP", "GROUP"] and self.value:
+            return self.value[0].cpp_str_type()
+        return self.type
+
+    def cpp_type(self, c_type, namespace):
+        """The C++ type that a variable of this element with the C type c_type is returned as by
+        the C++ views (--cpp), or None if it is returned as a reference to the C variable.
+
+        Strings are returned as std::string_view or zcbor::bytes, structs as their views, and
+        other values as they are.
+        """
+        if c_type == "struct zcbor_string":
+            return "std::string_view" if self.cpp_str_type() == "TSTR" else "zcbor::bytes"
+        if c_type == "struct zcbor_string_off" or self.is_soa():
+            return None
+        if c_type.startswith("struct "):
+            return f"::{namespace}::{c_type.removeprefix('struct ')}"
+        return cpp_c_type(c_type)
+
+    def cpp_value_accessor(self, c_type, namespace):
+        """The accessor of the variable declared by add_var_name()."""
+        name = self.var_name()
+        cpp_type = self.cpp_type(c_type, namespace)
+        if cpp_type is None:
+            return (name, "const auto &", f"c_->{name}")
+        return (name, cpp_type, f"zcbor::value<{cpp_type}>(c_->{name})")
+
+    def cpp_union_accessors(self, namespace):
+        """The accessors of the members of the union declared by union_type(). They return
+        std::nullopt unless the member is the chosen one."""
+        accessors = []
+        for child in self.value:
+            if child.is_unambiguous_repeated():
+                continue
+            chosen = f"c_->{self.choice_var_name()} == ::{child.enum_var_name()}"
+            if child.multi_member():
+                # The members of the anonymous struct are accessed as members of the union.
+                child_accessors = child.cpp_accessors(namespace)
+            else:
+                c_type = child.val_type_name()
+                child_accessors = [child.cpp_value_accessor(c_type, namespace)] if c_type else []
+            for name, cpp_type, expr in child_accessors:
+                value_prefix = f"zcbor::value<{cpp_type}>("
+                if expr.startswith(value_prefix):
+                    cpp_type = f"std::optional<{cpp_type}>"
+                    expr = expr.replace(value_prefix, f"zcbor::optional<{cpp_type[14:-1]}>({chosen}, ")
+                accessors.append((name, cpp_type, expr))
+        return accessors
+
+    def cpp_accessors(self, namespace, full=True):
+        """Return the accessors of the C++ view (--cpp) of the variables that
+        full_declaration() declares for this element, or repeated_declaration() if full is False.
+
+        Each accessor is a (name, return type, expression) tuple, where the expression accesses
+        the C struct through c_. Optional values are returned as std::optional and repeated values
+        as zcbor::list_view. The "present" and "count" variables are only accessed directly if
+        the value itself is.
+        """
+        if full:
+            if self.is_unambiguous():
+                return []
+            if not self.multi_var_condition():
+                return self.cpp_accessors(namespace, full=False)
+            name = self.var_name()
+            c_type = None if self.is_unambiguous_repeated() else self.repeated_type_name()
+            cpp_type = c_type and self.cpp_type(c_type, namespace)
+            if cpp_type and self.count_var_condition():
+                return [
+                    (
+                        name,
+                        f"zcbor::list_view<{cpp_type}, {cpp_c_type(c_type)}>",
+                        f"{{c_->{name}, c_->{self.count_var_name()}}}",
+                    )
+                ]
+            if cpp_type and self.present_var_condition():
+                return [
+                    (
+                        name,
+                        f"std::optional<{cpp_type}>",
+                        f"zcbor::optional<{cpp_type}>(c_->{self.present_var_name()}, c_->{name})",
+                    )
+                ]
+            accessors = [(name, "const auto &", f"c_->{name}")] if c_type else []
+            if self.count_var_condition():
+                count_name = self.count_var_name()
+                accessors.append((count_name, "size_t", f"c_->{count_name}"))
+            if self.present_var_condition():
+                present_name = self.present_var_name()
+                accessors.append((present_name, "bool", f"c_->{present_name}"))
+            return accessors
+
+        if self.is_unambiguous_repeated():
+            return []
+        accessors = []
+        if not self.skip_condition():
+            if not self.multi_val_condition() and self.val_type_name() is not None:
+                accessors.append(self.cpp_value_accessor(self.val_type_name(), namespace))
+            elif self.type == "UNION":
+                accessors.extend(self.cpp_union_accessors(namespace))
+        if self.type in ["LIST", "MAP", "GROUP"]:
+            accessors.extend(chain(*(child.cpp_accessors(namespace) for child in self.value)))
+        if self.reduced_key_var_condition():
+            accessors[0:0] = self.key.cpp_accessors(namespace)
+        if self.choice_var_condition():
+            choice_name = self.choice_var_name()
+            accessors.append((choice_name, "auto", f"c_->{choice_name}"))
+        if self.cbor_var_condition():
+            accessors.extend(self.cbor.cpp_accessors(namespace))
+        return accessors
+
+    def cpp_structs(self):
+        """Return the named structs that type_def() declares, as (type name, element, full)
+        tuples, where full says whether the struct was declared from full_declaration() or
+        repeated_declaration()."""
+        structs = []
+        if self.type in ["LIST", "MAP", "GROUP", "UNION"]:
+            structs.extend(chain(*(child.cpp_structs() for child in self.value)))
+        if self.cbor_var_condition():
+            structs.extend(self.cbor.cpp_structs())
+        if self.reduced_key_var_condition():
+            structs.extend(self.key.cpp_structs())
+        if self.type == "OTHER":
+            structs.extend(self.my_types[self.value].cpp_structs())
+        if self.repeated_type_def_condition() and self.single_var_type(full=False):
+            structs.append((self.repeated_type_name(), self, False))
+        if self.type_def_condition() and self.single_var_type():
+            structs.append((self.type_name(), self, True))
+        return structs
 
 
 class CodeRenderer:
@@ -3783,17 +4484,35 @@ class CodeRenderer:
         git_sha="",
         file_header="",
         default_max_qty_define="ZCBOR_DEFAULT_MAX_QTY",
+        trusted_entry_types=(),
+        sequence_entry_types=None,
+        external_state_entry_types=None,
+        stream_entry_types=(),
+        profile_prefix=None,
+        repeated_arena=False,
+        view_entry_types=(),
+        string_offsets=False,
     ):
         super(CodeRenderer, self).__init__()
         self.entry_types = entry_types
+        self.trusted_entry_types = trusted_entry_types
+        self.sequence_entry_types = sequence_entry_types or {mode: [] for mode in modes}
+        self.external_state_entry_types = external_state_entry_types or {mode: [] for mode in modes}
+        self.stream_entry_types = stream_entry_types
         self.print_time = print_time
         self.default_max_qty = default_max_qty
         self.default_max_qty_define = default_max_qty_define
+        self.profile_prefix = profile_prefix
+        self.repeated_arena = repeated_arena
+        self.view_entry_types = view_entry_types
+        self.string_offsets = string_offsets
 
         self.sorted_types = dict()
         self.functions = dict()
         self.type_defs = dict()
         self.defines = dict()
+        self.rule_names = dict()
+        self.profile_rules = dict()
 
         if isinstance(modes, str):
             modes = [modes]
@@ -3810,8 +4529,26 @@ class CodeRenderer:
 
             self.functions[mode] = self.unique_funcs(mode)
             self.functions[mode] = self.used_funcs(mode)
+            if mode == "decode":
+                # The functions that decode a single member of a view.
+                self.functions[mode] += [
+                    XcoderTuple(
+                        child.full_xcode(),
+                        xcoder.view_func_name(name),
+                        xcoder.view_member_type_name(name),
+                    )
+                    for xcoder in self.view_entry_types
+                    for name, child in xcoder.view_members().items()
+                ]
             self.type_defs[mode] = self.unique_types(mode)
             self.defines[mode] = self.used_defines(mode)
+            self.rule_names[mode] = {
+                rule.replace("-", "_"): rule
+                for rule in (self.entry_types[mode][0].my_types if self.entry_types[mode] else {})
+            }
+            self.profile_rules[mode] = list(
+                dict.fromkeys(self.profile_rule(xcoder, mode) for xcoder in self.functions[mode])
+            )
 
             if mode == "decode":
                 self.needs_map_smart_search[mode] = any(
@@ -3828,6 +4565,47 @@ class CodeRenderer:
 https://github.com/nordicsemi/zcbor{'''
 at: ''' + datetime.now().strftime('%Y-%m-%d %H:%M:%S') if self.print_time else ''}"""
 
+    def func_rule(self, func_name, mode):
+        """Return the name of the CDDL rule that the function was generated from.
+
+        Function names start with the (C-ified) name of the rule. Return None for functions that are
+        not named after a rule, e.g. because --short-names is used.
+        """
+        rule_names = self.rule_names[mode]
+        name = func_name.removeprefix(f"{mode}_").removeprefix("repeated_")
+        matches = [c_name for c_name in rule_names if name == c_name or name.startswith(c_name + "_")]
+        return rule_names[max(matches, key=len)] if matches else None
+
+    def trace_functions(self, mode):
+        """Return the generated functions with their ids for zcbor_trace_enter()/_exit()."""
+        return enumerate(self.functions[mode], start=1)
+
+    def render_trace_ids_file(self, modes):
+        """Render a JSON file with the function name and CDDL rule of each trace id, per mode.
+
+        This is read by "zcbor trace".
+        """
+        return (
+            json_dump(
+                {
+                    mode: {
+                        str(trace_id): {
+                            "function": xcoder.func_name,
+                            "rule": self.func_rule(xcoder.func_name, mode),
+                        }
+                        for trace_id, xcoder in self.trace_functions(mode)
+                    }
+                    for mode in modes
+                },
+                indent=2,
+            )
+            + "\n"
+        )
+
+    def profile_rule(self, xcoder, mode):
+        """Return the name of the profile table entry that the function's time is added to."""
+        return self.func_rule(xcoder.func_name, mode) or xcoder.func_name
+
     def header_guard(self, file_name):
         return path.basename(file_name).replace(".", "_").replace("-", "_").upper() + "__"
 
@@ -3910,7 +4688,8 @@ and
         return f"""
 static bool {xcoder.func_name}(zcbor_state_t *state, {"" if mode == "decode" else "const "}{
             xcoder.type_name
-            if struct_ptr_name(mode) in xcoder.body else "void"} *{struct_ptr_name(mode)});
+            if struct_ptr_name(mode) in xcoder.body else "void"} *{struct_ptr_name(mode)}{
+            ", size_t index" if xcoder.soa else ""});
             """.strip()
 
     def find_cast_func_calls(self, body):
@@ -3923,7 +4702,8 @@ static bool {xcoder.func_name}(zcbor_state_t *state, {"" if mode == "decode" els
         # Match a triplet of function pointer, state arg, and result arg.
         call_re = rf"{func_re}, (?P<state>{arg_re}), (?P<arg>{arg_re})"
         multi_re = (
-            rf"{paren_re}zcbor_multi_(en|de)code(_minmax)?(_w_backup)?\(({arg_re},){{3}} {call_re}"
+            rf"{paren_re}zcbor_multi_(en|de)code(?P<soa>_soa)?(_minmax)?(?P<arena>_arena)?(_w_backup)?"
+            rf"\(({arg_re},){{3}} {call_re}"
         )
         present_re = rf"{paren_re}zcbor_present_(en|de)code(_w_backup)?\({arg_re}, {call_re}\)"
         map_re = rf"{paren_re}zcbor_unordered_map_search\({call_re}\)"
@@ -3932,7 +4712,18 @@ static bool {xcoder.func_name}(zcbor_state_t *state, {"" if mode == "decode" els
             getrp(present_re).finditer(body),
             getrp(map_re).finditer(body),
         )
-        return list((m.group("func"), m.group("state"), m.group("arg")) for m in all_funcs)
+        # The _arena functions get the address of the pointer to the elements, and the _soa
+        # functions also pass the index of the element.
+        return list(
+            (
+                m.group("func"),
+                m.group("state"),
+                ("*" if m.groupdict().get("arena") else "")
+                + m.group("arg")
+                + (", 0" if m.groupdict().get("soa") else ""),
+            )
+            for m in all_funcs
+        )
 
     def render_arg_check(self, calls):
         """Check that the arguments to the calls have the right type.
@@ -3953,21 +4744,38 @@ static bool {xcoder.func_name}(zcbor_state_t *state, {"" if mode == "decode" els
 	}}
 """
 
-    def render_function(self, xcoder, mode):
+    def render_function(self, xcoder, mode, trace_id):
         body = xcoder.body
+        profile_enter, profile_exit = "", ""
+        if self.profile_prefix:
+            index = self.profile_rules[mode].index(self.profile_rule(xcoder, mode))
+            profile_enter = (
+                "struct zcbor_profile_frame profile_frame;"
+                + linesep
+                + "\tzcbor_profile_enter(&profile_current, &profile_frame, "
+                + f"&{self.profile_table_name(mode)}[{index}]);"
+            )
+            profile_exit = "zcbor_profile_exit(&profile_current, &profile_frame);"
         return f"""
 static bool {xcoder.func_name}(
 		zcbor_state_t *state, {"" if mode == "decode" else "const "}{
             xcoder.type_name
-            if struct_ptr_name(mode) in body else "void"} *{struct_ptr_name(mode)})
+            if struct_ptr_name(mode) in body else "void"} *{struct_ptr_name(mode)}{
+            ", size_t index" if xcoder.soa else ""})
 {{
 	zcbor_log("%s\\r\\n", __func__);
+	zcbor_trace_enter(state, {trace_id});
+	{profile_enter}
 	{"struct zcbor_string tmp_str;" if "tmp_str" in body else ""}
 	{"bool int_res;" if "int_res" in body else ""}
+	{"bool tmp_present;" if "tmp_present" in body else ""}
+	{"size_t tmp_count;" if "tmp_count" in body else ""}
 
 	bool res = ({body});
 {self.render_arg_check(self.find_cast_func_calls(body))}
+	{profile_exit}
 	log_result(state, res, __func__);
+	zcbor_trace_exit(state, {trace_id}, res);
 	return res;
 }}""".replace("	\n", "")  # call replace() to remove empty lines.
 
@@ -3990,8 +4798,12 @@ static bool {xcoder.func_name}(
 
         return num_flags_var, total_states, entry_func, extra_args
 
-    def render_entry_function(self, xcoder, mode):
-        """Render a single entry function (API function) with signature and body."""
+    def render_entry_function(self, xcoder, mode, external_states=False, stream=False):
+        """Render a single entry function (API function) with signature and body.
+
+        If external_states is True, render the variant that takes the state array as an argument.
+        If stream is True, render the variant that takes a callback for streamed bstrs.
+        """
         func_name, func_arg = (xcoder.xcode_func_name(), struct_ptr_name(mode))
         elem_count = "ZCBOR_LARGE_ELEM_COUNT" if mode == "decode" else "0"
 
@@ -4002,7 +4814,7 @@ static bool {xcoder.func_name}(
             "payload_len_out",
             "states",
             f"(zcbor_decoder_t *)ZCBOR_CUSTOM_CAST_FP({func_name})",
-            "sizeof(states) / sizeof(zcbor_state_t)",
+            "n_states" if external_states else "sizeof(states) / sizeof(zcbor_state_t)",
             f"{elem_count}",
         ]
 
@@ -4011,8 +4823,32 @@ static bool {xcoder.func_name}(
         )
         arg_list += extra_args
 
+        if stream:
+            entry_func = entry_func.replace("zcbor_", "zcbor_stream_", 1)
+            arg_list[4:4] = ["chunk_cb", "chunk_ctx"]
+        elif mode == "decode" and xcoder.repeated_arena:
+            entry_func = entry_func.replace("zcbor_", "zcbor_arena_", 1)
+            arg_list[4:4] = ["arena"]
+        elif mode == "encode" and xcoder.string_offsets:
+            entry_func = entry_func.replace("zcbor_", "zcbor_string_base_", 1)
+            arg_list[4:4] = ["string_base"]
+        elif mode == "decode" and xcoder in self.trusted_entry_types:
+            entry_func = entry_func.replace("zcbor_", "zcbor_trusted_", 1)
+
+        if external_states:
+            return f"""
+{xcoder.public_states_func_sig()}
+{{
+	{num_flags_var}
+	if (n_states < {xcoder.num_states_define_name()}) {{
+		return ZCBOR_ERR_NO_BACKUP_MEM;
+	}}
+{self.render_arg_check(((func_name, "states", func_arg),))}
+	return {entry_func}({', '.join(arg_list)});
+}}""".replace("	\n", "")  # call replace() to remove empty lines.
+
         return f"""
-{xcoder.public_xcode_func_sig()}
+{xcoder.public_stream_func_sig() if stream else xcoder.public_xcode_func_sig()}
 {{
 	{num_flags_var}
 	zcbor_state_t states[{num_states}];
@@ -4020,6 +4856,156 @@ static bool {xcoder.func_name}(
 	return {entry_func}({', '.join(arg_list)});
 }}""".replace("	\n", "")  # call replace() to remove empty lines.
 
+    def render_view_functions(self, xcoder, mode):
+        """Render the function that validates a payload and fills a view struct, its entry
+        function, and the entry functions that decode single members of the view.
+        """
+        func_name, func_arg = (xcoder.view_func_name(), struct_ptr_name(mode))
+        body = xcoder.xcode_view()
+        num_flags_var, num_states, entry_func, extra_args = self._calculate_elem_state_requirements(
+            xcoder, mode
+        )
+        # The members are validated one at a time, so they share one temporary.
+        member_tmps = "".join(
+            f"{linesep}\t\t{xcoder.view_member_type_name(name)} {name};"
+            for name in xcoder.view_members()
+        )
+        view_func = f"""
+static bool {func_name}(
+		zcbor_state_t *state, {xcoder.view_type_name()} *view)
+{{
+	zcbor_log("%s\\r\\n", __func__);
+	union {{{member_tmps}
+	}} member_tmp;
+	{"struct zcbor_string tmp_str;" if "tmp_str" in body else ""}
+	{"bool int_res;" if "int_res" in body else ""}
+	{"bool tmp_present;" if "tmp_present" in body else ""}
+	{"size_t tmp_count;" if "tmp_count" in body else ""}
+
+	view->raw.value = state->payload;
+	bool res = ({body});
+{self.render_arg_check(self.find_cast_func_calls(body))}
+	view->raw.len = (size_t)(state->payload - view->raw.value);
+	log_result(state, res, __func__);
+	return res;
+}}""".replace("	\n", "")  # call replace() to remove empty lines.
+
+        arg_list = [
+            "payload",
+            "payload_len",
+            "(void *)view",
+            "payload_len_out",
+            "states",
+            f"(zcbor_decoder_t *)ZCBOR_CUSTOM_CAST_FP({func_name})",
+            "sizeof(states) / sizeof(zcbor_state_t)",
+            "ZCBOR_LARGE_ELEM_COUNT",
+        ] + extra_args
+        entry_funcs = [f"""
+{xcoder.public_view_func_sig()}
+{{
+	{num_flags_var}
+	zcbor_state_t states[{num_states}];
+
+	return {entry_func}({', '.join(arg_list)});
+}}"""]
+        view_entry_func = entry_func.replace("zcbor_", "zcbor_view_", 1)
+        for name in xcoder.view_members():
+            member_arg_list = [
+                "view->raw.value",
+                "view->raw.len",
+                f"&view->{name}",
+                f"(void *){func_arg}",
+                "states",
+                f"(zcbor_decoder_t *)ZCBOR_CUSTOM_CAST_FP({xcoder.view_func_name(name)})",
+                "sizeof(states) / sizeof(zcbor_state_t)",
+            ] + extra_args
+            entry_funcs.append(f"""
+{xcoder.public_view_func_sig(name)}
+{{
+	{num_flags_var}
+	zcbor_state_t states[{num_states}];
+
+	return {view_entry_func}({', '.join(member_arg_list)});
+}}""")
+        return view_func, [f.replace("	\n", "") for f in entry_funcs]
+
+    def render_view_member_struct(self, xcoder, name):
+        """Render the struct that a member of a view is decoded into, see --view-entry-types."""
+        declaration = xcoder.view_member_declaration(name)
+        return f"""
+/** The {name} member of a {xcoder.type_name()}, decoded on demand from a
+ *  {xcoder.view_type_name()}. See --view-entry-types.
+ */
+{declaration[0].removesuffix(" {")} {{
+{linesep.join(declaration[1:])};"""
+
+    def render_view_struct(self, xcoder):
+        """Render the view struct of an entry type, see --view-entry-types."""
+        members = "".join(f"{linesep}\tstruct zcbor_view_pos {name};" for name in xcoder.view_members())
+        return f"""
+/** The positions of the members of a {xcoder.type_name()} in a payload, for decoding them on
+ *  demand. See --view-entry-types.
+ */
+{xcoder.view_type_name()} {{
+	struct zcbor_string raw; /**< The whole encoded value, e.g. to pass it on unchanged. */{members}
+}};"""
+
+    def render_view_decls(self, xcoder):
+        return (linesep * 2).join(
+            [self.render_view_struct(xcoder), f"{xcoder.public_view_func_sig()};"]
+            + [
+                (
+                    f"{self.render_view_member_struct(xcoder, name)}{linesep * 2}"
+                    f"{xcoder.public_view_func_sig(name)};"
+                    if xcoder.view_member_has_struct(name)
+                    else f"{xcoder.public_view_func_sig(name)};"
+                )
+                for name in xcoder.view_members()
+            ]
+        )
+
+    def render_states_func_decl(self, xcoder, mode):
+        """Render the declaration of an entry function with caller-provided states, together with
+        the define for the number of states it needs."""
+        num_flags_var, num_states, _, _ = self._calculate_elem_state_requirements(xcoder, mode)
+        if num_flags_var:
+            num_states = num_states.replace("num_flags", f"({xcoder.num_map_search_flags()})")
+        return f"""
+#define {xcoder.num_states_define_name()} ({num_states})
+{xcoder.public_states_func_sig()};"""
+
+    def render_seq_entry_function(self, xcoder, mode):
+        """Render a sequence entry function (API function) with signature and body."""
+        func_name, func_arg = (xcoder.xcode_func_name(), struct_ptr_name(mode))
+        has_result = func_arg in xcoder.full_xcode()
+        seq_func = "zcbor_entry_function_seq" + ("_encode" if mode == "encode" else "")
+
+        num_flags_var, num_states, entry_func, extra_args = self._calculate_elem_state_requirements(
+            xcoder, mode
+        )
+
+        arg_list = [
+            "payload",
+            "payload_len",
+            f"({'const ' if mode == 'encode' else ''}void *){func_arg}",
+            f"sizeof(*{func_arg})" if has_result else "0",
+            "max_results",
+            "num_results",
+            "payload_len_out",
+            "states",
+            f"(zcbor_decoder_t *)ZCBOR_CUSTOM_CAST_FP({func_name})",
+            "sizeof(states) / sizeof(zcbor_state_t)",
+        ] + (extra_args or ["0"])
+
+        return f"""
+{xcoder.public_seq_func_sig()}
+{{
+	{num_flags_var}
+	zcbor_state_t states[{num_states}];
+
+	return {seq_func}_with_elem_states({', '.join(arg_list)});
+}}""".replace("	\n", "")  # call replace() to remove empty lines.
+
     def render_file_header(self, line_prefix):
         lp = line_prefix
         return (f"\n{lp} " + self.file_header.replace("\n", f"\n{lp} ")).replace(" \n", "\n")
@@ -4031,6 +5017,79 @@ static bool {xcoder.func_name}(
 #endif
 """
 
+    def render_string_offsets_check(self):
+        return """
+#ifndef ZCBOR_STRING_OFFSETS
+#error "This file needs ZCBOR_STRING_OFFSETS to function"
+#endif
+"""
+
+    def render_trusted_input_check(self):
+        return """
+#ifndef ZCBOR_TRUSTED_INPUT
+#error "This file needs ZCBOR_TRUSTED_INPUT to function"
+#endif
+"""
+
+    def render_bstr_stream_check(self):
+        return """
+#ifndef ZCBOR_BSTR_STREAM
+#error "This file needs ZCBOR_BSTR_STREAM to function"
+#endif
+"""
+
+    def render_arena_check(self):
+        return """
+#ifndef ZCBOR_ARENA
+#error "This file needs ZCBOR_ARENA to function"
+#endif
+"""
+
+    def profile_table_name(self, mode):
+        return f"{self.profile_prefix}_{mode}_profile"
+
+    def profile_len_define_name(self, mode):
+        return f"{self.profile_table_name(mode).upper()}_LEN"
+
+    def render_profile_table(self, mode):
+        """Render the profile table and the functions for printing and resetting it."""
+        table, len_define = self.profile_table_name(mode), self.profile_len_define_name(mode)
+        entries = "".join(f'{linesep}\t{{.rule = "{rule}"}},' for rule in self.profile_rules[mode])
+        return f"""
+#ifndef ZCBOR_PROFILE_CLOCK
+#error "This file was generated with --profile, and needs ZCBOR_PROFILE_CLOCK() to be defined"
+#endif
+
+struct zcbor_profile_entry {table}[{len_define}] = {{{entries}
+}};
+
+static struct zcbor_profile_frame *profile_current;
+
+void {table}_dump(void)
+{{
+	zcbor_profile_print({table}, {len_define});
+}}
+
+
+void {table}_reset(void)
+{{
+	zcbor_profile_reset({table}, {len_define});
+}}
+"""
+
+    def render_profile_decls(self, mode):
+        table, len_define = self.profile_table_name(mode), self.profile_len_define_name(mode)
+        return f"""#define {len_define} {len(self.profile_rules[mode])}
+
+/** Calls to, and time spent in, each CDDL rule. See --profile. */
+extern struct zcbor_profile_entry {table}[{len_define}];
+
+/** Print a flat profile of the CDDL rules. */
+void {table}_dump(void);
+
+/** Zero the profile counters. */
+void {table}_reset(void);"""
+
     def render_c_file(self, header_file_name, mode):
         """Render the entire generated C file contents."""
         log_result_define = """#define log_result(state, result, func) \
@@ -4042,6 +5101,10 @@ do { \\
 		zcbor_log("%s success\\r\\n", func); \\
 	} \\
 } while(0)"""
+        view_funcs = [
+            self.render_view_functions(xcoder, mode)
+            for xcoder in (self.view_entry_types if mode == "decode" else [])
+        ]
         return f"""/*{self.render_file_header(" *")}
  */
 
@@ -4055,14 +5118,29 @@ do { \\
 
 {self.render_cast_macro(mode)}
 
-{self.render_smart_search_check() if self.needs_map_smart_search[mode] else ''}
+{self.render_smart_search_check() if self.needs_map_smart_search[mode] else ''}\
+{self.render_arena_check() if self.repeated_arena and mode == "decode" else ''}\
+{self.render_string_offsets_check() if self.string_offsets else ''}\
+{self.render_trusted_input_check() if self.trusted_entry_types and mode == "decode" else ''}\
+{self.render_bstr_stream_check() if self.stream_entry_types and mode == "decode" else ''}
 {log_result_define}
-
+{self.render_profile_table(mode) + linesep if self.profile_prefix else ''}
 {linesep.join([self.render_forward_declaration(xcoder, mode) for xcoder in self.functions[mode]])}
 
-{linesep.join([self.render_function(xcoder, mode) for xcoder in self.functions[mode]])}
-
-{linesep.join([self.render_entry_function(xcoder, mode) for xcoder in self.entry_types[mode]])}
+{linesep.join([self.render_function(xcoder, mode, trace_id)
+    for trace_id, xcoder in self.trace_functions(mode)]
+    + [view_func for view_func, _ in view_funcs])}
+
+{linesep.join([self.render_entry_function(xcoder, mode) for xcoder in self.entry_types[mode]]
+               + [self.render_seq_entry_function(xcoder, mode) for xcoder in self.entry_types[mode]
+                  if xcoder in self.sequence_entry_types[mode]]
+               + [self.render_entry_function(xcoder, mode, external_states=True)
+                  for xcoder in self.entry_types[mode]
+                  if xcoder in self.external_state_entry_types[mode]]
+               + [self.render_entry_function(xcoder, mode, stream=True)
+                  for xcoder in self.entry_types[mode]
+                  if mode == "decode" and xcoder in self.stream_entry_types]
+               + list(chain(*(entry_funcs for _, entry_funcs in view_funcs))))}
 """
 
     def render_h_file(self, type_def_file, header_guard, mode):
@@ -4077,13 +5155,22 @@ do { \\
 #include <stdbool.h>
 #include <stddef.h>
 #include <string.h>
-#include "{type_def_file}"
+#include "{type_def_file}"{linesep + '#include "zcbor_common.h"' if self.profile_prefix or (self.view_entry_types and mode == "decode") else ""}
 
 #ifdef __cplusplus
 extern "C" {{
 #endif
-{((linesep * 2) + (linesep).join(self.defines[mode]) + (linesep)) if self.defines[mode] else ""}
-{(linesep * 2).join([f"{xcoder.public_xcode_func_sig()};" for xcoder in self.entry_types[mode]])}
+{linesep + "struct zcbor_arena;" + linesep if self.repeated_arena and mode == "decode" else ""}{((linesep * 2) + (linesep).join(self.defines[mode]) + (linesep)) if self.defines[mode] else ""}
+{(linesep * 2).join([f"{xcoder.public_xcode_func_sig()};" for xcoder in self.entry_types[mode]]
+                    + [f"{xcoder.public_seq_func_sig()};" for xcoder in self.entry_types[mode]
+                       if xcoder in self.sequence_entry_types[mode]]
+                    + [self.render_states_func_decl(xcoder, mode) for xcoder in self.entry_types[mode]
+                       if xcoder in self.external_state_entry_types[mode]]
+                    + [f"{xcoder.public_stream_func_sig()};" for xcoder in self.entry_types[mode]
+                       if mode == "decode" and xcoder in self.stream_entry_types]
+                    + [self.render_view_decls(xcoder) for xcoder in self.view_entry_types
+                       if mode == "decode"]
+                    + ([self.render_profile_decls(mode)] if self.profile_prefix else []))}
 
 
 #ifdef __cplusplus
@@ -4098,9 +5185,26 @@ extern "C" {{
         if not self.type_defs[mode]:
             return ""
         c = "" if mode == "decode" else "const "
-        lines = list(f"bool(*)(zcbor_state_t *, {c}{n} *): " for _, n in self.type_defs[mode])
-        maxline = max(len(line) for line in lines)
-        lines = (line.ljust(maxline) + f"((zcbor_{mode}r_t *)func)" for line in lines)
+        soa_names = [xcoder.type_name for xcoder in self.functions[mode] if xcoder.soa]
+        # Enums are left out, since they are compatible with an integer type, so several of them
+        # would match the same functions.
+        type_names = [
+            n for _, n in self.type_defs[mode] if n not in soa_names and not n.startswith("enum ")
+        ]
+        if mode == "decode":
+            type_names += [xcoder.view_type_name() for xcoder in self.view_entry_types]
+            type_names += [
+                xcoder.view_member_type_name(name)
+                for xcoder in self.view_entry_types
+                for name in xcoder.view_members()
+                if xcoder.view_member_has_struct(name)
+            ]
+        lines = [(f"bool(*)(zcbor_state_t *, {c}{n} *): ", f"zcbor_{mode}r_t") for n in type_names]
+        lines += [
+            (f"bool(*)(zcbor_state_t *, {c}{n} *, size_t): ", f"zcbor_soa_{mode}r_t") for n in soa_names
+        ]
+        maxline = max(len(line) for line, _ in lines)
+        lines = (line.ljust(maxline) + f"(({cast} *)func)" for line, cast in lines)
         body = ", \\\n\t".join(lines)
         return f"""#define ZCBOR_CUSTOM_CAST_FP(func) _Generic((func), \\
 	{body}, \\
@@ -4122,7 +5226,7 @@ extern "C" {{
 #include <stdint.h>
 #include <stdbool.h>
 #include <stddef.h>
-{'#include <zcbor_common.h>' if "struct zcbor_string" in body else ""}
+{'#include <zcbor_common.h>' if "struct zcbor_string" in body or "ZCBOR_SOA_" in body else ""}
 
 #ifdef __cplusplus
 extern "C" {{
@@ -4142,6 +5246,106 @@ extern "C" {{
 }}
 #endif
 
+#endif /* {header_guard} */
+"""
+
+    def cpp_namespace(self, project, mode):
+        """The namespace of the generated C++ code (--cpp), i.e. the project name, unless that is
+        also the name of a C type."""
+        c_types = [cpp_c_type(name).removeprefix("::") for _, name in self.type_defs[mode]]
+        return project + "_cpp" if project in c_types else project
+
+    def render_cpp_view(self, type_name, xcoder, full, namespace):
+        """Render the C++ class that gives typed access to a generated struct (--cpp)."""
+        class_name = cpp_c_type(type_name).removeprefix("::")
+        accessors = "".join(
+            f"{linesep}	{ret}{'' if ret.endswith('&') else ' '}{name if name != class_name else name + '_'}() "
+            f"const {{ return {expr}; }}"
+            for name, ret, expr in xcoder.cpp_accessors(namespace, full)
+        )
+        return f"""
+/** Typed read-only access to a {type_name}. */
+class {class_name} {{
+public:
+	using c_type = {cpp_c_type(type_name)};
+
+	explicit constexpr {class_name}(const c_type &c) : c_(&c) {{}}
+
+	/** The C struct that this view reads from. */
+	constexpr const c_type &c_struct() const {{ return *c_; }}
+{accessors}
+
+private:
+	const c_type *c_;
+}};"""
+
+    def render_cpp_codec(self, xcoders, namespace, views):
+        """Render the C++ codec of an entry type (--cpp), given the entry type's xcoder in each
+        mode."""
+        xcoder = next(iter(xcoders.values()))
+        rule_name = next(name for name, my_type in xcoder.my_types.items() if my_type is xcoder)
+        codec_name = rule_name.replace("-", "_")
+        type_name = xcoder.type_name()
+        has_result = struct_ptr_name(xcoder.mode) in xcoder.full_xcode()
+        c_type = cpp_c_type(type_name) if has_result else "zcbor::none"
+        cpp_type = xcoder.cpp_type(type_name, namespace) if has_result else None
+        # Structs without views, e.g. with --soa-types, are returned as they are.
+        if cpp_type is None or (type_name not in views and cpp_type.startswith(f"::{namespace}::")):
+            cpp_type = c_type
+        funcs = []
+        for mode, mode_xcoder in xcoders.items():
+            arg = struct_ptr_name(mode)
+            extra_args = [
+                extra_arg.strip(",\n\t") for extra_arg in (mode_xcoder.arena_arg(),) if extra_arg
+            ]
+            funcs.append(f"""
+	static int {mode}({"const " if mode == "decode" else ""}uint8_t *payload, size_t payload_len,
+			{"" if mode == "decode" else "const "}c_type *{arg}, size_t *payload_len_out\
+{"".join(", " + extra_arg for extra_arg in extra_args)})
+	{{
+		return cbor_{mode_xcoder.xcode_func_name()}(payload, payload_len, {arg}, payload_len_out\
+{"".join(", " + extra_arg.split("*")[-1] for extra_arg in extra_args)});
+	}}""")
+        return f"""
+/** The codec of the entry type {rule_name}, for zcbor::decode() and zcbor::encode(). */
+struct {codec_name}_codec {{
+	using c_type = {c_type};
+	using view_type = {cpp_type};
+
+	static constexpr bool can_decode = {str("decode" in xcoders).lower()};
+	static constexpr bool can_encode = {str("encode" in xcoders).lower()};
+{linesep.join(funcs)}
+
+	static view_type view(const c_type &c) {{ return zcbor::value<view_type>(c); }}
+}};"""
+
+    def render_cpp_file(self, header_guard, h_names, project, mode):
+        """Render the generated C++ header (--cpp)."""
+        namespace = self.cpp_namespace(project, mode)
+        views = dict()
+        for xcoder in self.sorted_types[mode]:
+            for type_name, elem, full in xcoder.cpp_structs():
+                views.setdefault(type_name, (elem, full))
+        codecs = [
+            self.render_cpp_codec({m: self.entry_types[m][i] for m in h_names.keys()}, namespace, views)
+            for i in range(len(self.entry_types[mode]))
+        ]
+        return f"""/*{self.render_file_header(" *")}
+ */
+
+#ifndef {header_guard}
+#define {header_guard}
+
+#include "zcbor.hpp"
+{linesep.join(f'#include "{h_name}"' for h_name in h_names.values())}
+
+/** Typed C++ access to the types generated from the CDDL, see zcbor.hpp. */
+namespace {namespace} {{
+{linesep.join(self.render_cpp_view(name, elem, full, namespace) for name, (elem, full) in views.items())}
+{linesep.join(codecs)}
+
+}} /* namespace {namespace} */
+
 #endif /* {header_guard} */
 """
 
@@ -4159,6 +5363,10 @@ extern "C" {{
         )
         add_smart_search = any(self.needs_map_smart_search[mode] for mode in ("decode", "encode"))
         smart_search = f"\ntarget_compile_definitions({target_name} PUBLIC ZCBOR_MAP_SMART_SEARCH)\n"
+        arena = f"\ntarget_compile_definitions({target_name} PUBLIC ZCBOR_ARENA)\n"
+        string_offsets = f"\ntarget_compile_definitions({target_name} PUBLIC ZCBOR_STRING_OFFSETS)\n"
+        trusted_input = f"\ntarget_compile_definitions({target_name} PUBLIC ZCBOR_TRUSTED_INPUT)\n"
+        bstr_stream = f"\ntarget_compile_definitions({target_name} PUBLIC ZCBOR_BSTR_STREAM)\n"
 
         def relativify(p):
             try:
@@ -4184,7 +5392,10 @@ target_sources({target_name} PRIVATE
 target_include_directories({target_name} PUBLIC
     {(linesep + "    ").join(((str(relativify(f)) for f in include_dirs)))}
     )
-{f'{smart_search}' if add_smart_search else ''}"""
+{f'{smart_search}' if add_smart_search else ''}{arena if self.repeated_arena else ''}\
+{string_offsets if self.string_offsets else ''}\
+{trusted_input if self.trusted_entry_types else ''}\
+{bstr_stream if self.stream_entry_types else ''}"""
 
     def render(
         self,
@@ -4197,6 +5408,9 @@ target_include_directories({target_name} PUBLIC
         output_c_dir=None,
         output_h_dir=None,
         quiet=False,
+        cpp_file=None,
+        cpp_namespace=None,
+        trace_ids_file=None,
     ):
         for mode in modes:
             h_name = Path(include_prefix, Path(h_files[mode].name).name)
@@ -4217,6 +5431,21 @@ target_include_directories({target_name} PUBLIC
         print_unless_quiet(quiet, "Writing to " + type_file.name)
         type_file.write(self.render_type_file(self.header_guard(type_file.name), mode))
 
+        if cpp_file:
+            print_unless_quiet(quiet, "Writing to " + cpp_file.name)
+            cpp_file.write(
+                self.render_cpp_file(
+                    self.header_guard(cpp_file.name),
+                    {m: Path(include_prefix, Path(h_files[m].name).name) for m in modes},
+                    cpp_namespace,
+                    mode,
+                )
+            )
+
+        if trace_ids_file:
+            print_unless_quiet(quiet, "Writing to " + trace_ids_file.name)
+            trace_ids_file.write(self.render_trace_ids_file(modes))
+
         if cmake_file:
             print_unless_quiet(quiet, "Writing to " + cmake_file.name)
             cmake_file.write(
@@ -4374,6 +5603,14 @@ files' folders as include_directories.
 Add it to your project via include() in your CMakeLists.txt file, and link the
 target to your program.
 This option works with or without the --copy-sources option.""",
+    )
+    code_parser.add_argument(
+        "--output-trace-ids",
+        required=False,
+        type=str,
+        help="""Path to output JSON file with the name and CDDL rule of the generated function
+for each function id recorded with ZCBOR_TRACE_BUFFER. Pass this file to
+"zcbor trace" to decode a trace from the generated code.""",
     )
     code_parser.add_argument(
         "-t",
@@ -4472,6 +5709,204 @@ cmake file if so.
 Enabling --unordered-maps places some restrictions on the level of ambiguity allowed between map
 keys in a map.
 This option only affects decoding (--decode/-d).""",
+    )
+    code_parser.add_argument(
+        "--repeated-arena",
+        required=False,
+        action="store_true",
+        default=False,
+        help="""Make repeated members (with a maximum of more than 1) pointers instead of arrays
+of the maximum size, so the result structs are proportional to the actual
+message instead of the worst case. When decoding, the elements are placed in a
+struct zcbor_arena that is passed as the last argument to the decoding entry
+functions. To size the arena exactly, first decode the payload with an arena
+initialized with zcbor_arena_count_init(), see the docs in zcbor_common.h.
+Indefinite length strings with more than one chunk are also coalesced into the
+arena when decoding.
+The generated decoding code needs ZCBOR_ARENA to be defined, and it is added
+to the generated cmake file.
+Cannot be combined with --trusted-entry-types, --sequence-entry-types,
+--stream-bstr-types, --view-entry-types or --soa-types.""",
+    )
+    code_parser.add_argument(
+        "--trusted-entry-types",
+        required=False,
+        type=str,
+        nargs="+",
+        default=[],
+        help="""Names of entry types (from --entry-types) whose decoding functions should assume
+that the input is well-formed, e.g. because it was produced by a conforming
+encoder and its integrity has been verified before decoding.
+The generated entry functions for these types skip the per-value canonical
+checks. Headers and strings are still checked against the end of the payload,
+so truncated data is rejected rather than read out of bounds.
+Do not use this for data from untrusted sources, since non-canonical data is
+accepted.
+The generated decoding code needs ZCBOR_TRUSTED_INPUT to be defined, and it is
+added to the generated cmake file.
+This option only affects decoding (--decode/-d).""",
+    )
+    code_parser.add_argument(
+        "--sequence-entry-types",
+        required=False,
+        type=str,
+        nargs="+",
+        default=[],
+        help="""Names of entry types (from --entry-types) to also generate sequence functions
+for. The sequence functions for a type are called cbor_decode_<Type>_seq() and
+cbor_encode_<Type>_seq(), and decode/encode consecutive items of a CBOR
+sequence (RFC 8742) from/to an array of structs, using a single state that is
+only initialized once.""",
+    )
+    code_parser.add_argument(
+        "--external-state-entry-types",
+        required=False,
+        type=str,
+        nargs="+",
+        default=[],
+        help="""Names of entry types (from --entry-types) to also generate entry functions
+with caller-provided state arrays for. These functions are called
+cbor_decode_<Type>_with_states() and cbor_encode_<Type>_with_states(), and
+the minimum number of states they need is given by the
+CBOR_DECODE_<TYPE>_NUM_STATES and CBOR_ENCODE_<TYPE>_NUM_STATES defines.
+This allows keeping the state arrays off the stack, e.g. in thread-local or
+statically allocated storage.""",
+    )
+    code_parser.add_argument(
+        "--stream-bstr-types",
+        required=False,
+        type=str,
+        nargs="+",
+        default=[],
+        help="""Names of bstr types (e.g. "Image = bstr") whose contents should be passed to a
+callback when decoding, instead of being returned as a pointer into the payload.
+The callback receives the contents in chunks, one per payload section, and can
+introduce new payload sections (zcbor_update_state()) when a chunk ends a section,
+so large strings can be received into a small buffer and e.g. written straight to
+flash. When this is used, cbor_decode_<Type>_stream() functions are generated for
+all entry types, which take the callback as an argument. In the result struct, the
+string's value is NULL and its len is the total length.
+The generated decoding code needs ZCBOR_BSTR_STREAM to be defined, and it is
+added to the generated cmake file.
+This option only affects decoding (--decode/-d).""",
+    )
+    code_parser.add_argument(
+        "--raw-types",
+        required=False,
+        type=str,
+        nargs="+",
+        default=[],
+        help="""Names of types whose values should be returned as their encoded bytes instead
+of being decoded, and that are encoded by copying such bytes verbatim. Use
+"any" to do this for all "any" values, which are otherwise skipped when
+decoding and encoded as nil. The values are struct zcbor_string in the
+generated structs, pointing to the whole encoded data item, including tags,
+so e.g. a proxy can forward data items that it doesn't understand without
+decoding and reencoding them. The contents are only checked for being
+well-formed CBOR. See zcbor_raw_decode() and zcbor_raw_encode().
+The types must be single data items, not groups.""",
+    )
+    code_parser.add_argument(
+        "--soa-types",
+        required=False,
+        type=str,
+        nargs="+",
+        default=[],
+        help="""Names of record types to place in a struct-of-arrays layout where they are
+repeated, e.g. "Record" in "Records = [* Record]". Instead of an array of struct
+Record, the repeated member is then a struct Record_soa, which has an array per
+member of Record, and a bitmap per optional member with one bit per element (see
+ZCBOR_SOA_PRESENT()). The elements are decoded directly into, and encoded
+directly from, these arrays, so loops over a single member of many elements
+don't need to transpose the results first.
+The types must be lists or maps of single scalar values (ints, floats, strings
+and bools), and all the repetitions of a type must have the same maximum
+quantity.""",
+    )
+    code_parser.add_argument(
+        "--compact-types",
+        required=False,
+        action="store_true",
+        default=False,
+        help="""Make the generated structs smaller: Order the members of each struct by
+decreasing alignment to minimize padding, make the "present" variables 1-bit
+bitfields, and make the "count" variables (when the maximum quantity is known)
+and the "choice" variables the smallest integer types that can hold their
+values. The enums with the values of the "choice" variables are then declared
+outside the structs, as enum <name>_choice.
+Note that code that initializes the structs without designated initializers,
+or takes the address of these members, must be adapted.""",
+    )
+    code_parser.add_argument(
+        "--string-offsets",
+        required=False,
+        action="store_true",
+        default=False,
+        help="""Store bstrs and tstrs as struct zcbor_string_off (a 32-bit offset and a 32-bit
+length) instead of struct zcbor_string (a pointer and a size_t), which halves
+their size on 64-bit platforms. When decoding, the offsets are relative to the
+start of the payload. When encoding, the base pointer of the offsets is passed
+as the last argument to the encoding entry functions.
+CBOR-encoded bstrs (.cbor) are still stored as struct zcbor_string.
+The generated code needs ZCBOR_STRING_OFFSETS to be defined, and it is added
+to the generated cmake file.
+Cannot be combined with --sequence-entry-types or --cpp.""",
+    )
+    code_parser.add_argument(
+        "--view-entry-types",
+        required=False,
+        type=str,
+        nargs="+",
+        default=[],
+        help="""Names of entry types (from --entry-types) to also generate views for. A view
+is a small struct with the offsets of the members of a list or map in the
+payload. cbor_decode_<Type>_view() validates the payload like
+cbor_decode_<Type>() and records the offsets in a struct <Type>_view, without
+returning the decoded data. Each member can then be decoded on demand with
+cbor_decode_<Type>_view_<member>(), into a struct <Type>_view_<member> with the
+same variables as the member has in struct <Type>. The view's raw member holds
+the whole encoded value, so it can be passed on unchanged without reencoding it.
+The types must be lists or maps (without tags) that are decoded into a struct,
+and maps can't be used with --unordered-maps.
+This option only affects decoding (--decode/-d).""",
+    )
+    code_parser.add_argument(
+        "--profile",
+        required=False,
+        action="store_true",
+        default=False,
+        help="""Time each generated function and accumulate the time and the number of calls
+per CDDL rule, in a table called <project>_decode_profile/<project>_encode_profile.
+<project>_decode_profile_dump() prints a flat profile, sorted by the time spent in
+each rule itself (excluding the rules it refers to), and
+<project>_decode_profile_reset() zeroes the table. <project> is the name of the
+--output-cmake file, or else of the first CDDL file, like in the
+ZCBOR_<project>_DEFAULT_MAX_QTY define.
+The time is taken with ZCBOR_PROFILE_CLOCK(), which defaults to the time stamp
+counter (rdtsc) on x86. On other architectures, ZCBOR_PROFILE_CLOCK() must be
+defined to an expression that returns a uint64_t timestamp, e.g. from a cycle
+counter. The profile is not thread safe.""",
+    )
+    code_parser.add_argument(
+        "--cpp",
+        required=False,
+        action="store_true",
+        default=False,
+        help="""Also generate a header-only C++17 layer on top of the generated C code, in a
+namespace named after the project (see --profile). The header is placed next to
+the generated headers, with the name of the --output-h file or the --output-cmake
+file, and the extension .hpp. It contains:
+A class for each generated struct, which refers to a decoded (or to be encoded)
+struct and has an accessor for each of its members. Strings are returned as
+std::string_view (tstr) or zcbor::bytes (bstr), optional members as
+std::optional, repeated members as a zcbor::list_view of the members' C++
+types, members of unions as std::optional, and nested structs as their classes,
+all without copying out of the struct.
+A <Type>_codec struct for each entry type, for decoding and encoding with
+zcbor::decode<<Type>_codec>() and zcbor::encode<<Type>_codec>() from zcbor.hpp,
+which take std::span-like payloads.
+The header needs C++17, and uses std::span with C++20.
+Cannot be combined with --string-offsets.""",
     )
     code_parser.set_defaults(process=process_code)
 
@@ -4585,14 +6020,101 @@ entire declaration is a single line.""",
     )
     convert_parser.set_defaults(process=process_convert)
 
+    trace_parser = subparsers.add_parser(
+        "trace",
+        description="""Print a trace recorded by generated code built with ZCBOR_TRACE_BUFFER,
+annotated with the names of the generated functions and the CDDL rules they come from.""",
+    )
+    trace_parser.add_argument(
+        "-i",
+        "--input",
+        required=True,
+        type=str,
+        help="""File containing a dump of the events array of the struct zcbor_trace_buffer.
+Use "-" to indicate stdin.""",
+    )
+    trace_parser.add_argument(
+        "--next",
+        required=False,
+        type=int,
+        help="""The value of 'next' in the struct zcbor_trace_buffer, i.e. the total number of
+recorded events. Needed to put the events in order if the buffer has wrapped. If omitted, the
+events are printed in the order they appear in the dump.""",
+    )
+    trace_parser.add_argument(
+        "--big-endian",
+        required=False,
+        action="store_true",
+        default=False,
+        help="The dump comes from a big-endian target.",
+    )
+    trace_parser.add_argument(
+        "--trace-ids",
+        required=True,
+        type=str,
+        help="""The file written with --output-trace-ids when generating the code that recorded
+the trace.""",
+    )
+    trace_mode = trace_parser.add_mutually_exclusive_group(required=True)
+    trace_mode.add_argument(
+        "-d",
+        "--decode",
+        action="store_true",
+        default=False,
+        help="The trace was recorded by decoding code.",
+    )
+    trace_mode.add_argument(
+        "-e",
+        "--encode",
+        action="store_true",
+        default=False,
+        help="The trace was recorded by encoding code.",
+    )
+    trace_parser.set_defaults(process=process_trace)
+
     args = parser.parse_args()
 
-    if not args.no_prelude:
+    if hasattr(args, "cddl") and not args.no_prelude:
         args.cddl.append(str(PRELUDE_PATH))
 
     if hasattr(args, "decode") and not args.decode and not args.encode:
         parser.error("Please specify at least one of --decode or --encode.")
 
+    if hasattr(args, "trusted_entry_types"):
+        if not set(args.trusted_entry_types).issubset(args.entry_types):
+            parser.error("All --trusted-entry-types must also be listed in --entry-types.")
+
+    if hasattr(args, "sequence_entry_types"):
+        if not set(args.sequence_entry_types).issubset(args.entry_types):
+            parser.error("All --sequence-entry-types must also be listed in --entry-types.")
+
+    if hasattr(args, "external_state_entry_types"):
+        if not set(args.external_state_entry_types).issubset(args.entry_types):
+            parser.error("All --external-state-entry-types must also be listed in --entry-types.")
+
+    if hasattr(args, "view_entry_types"):
+        if not set(args.view_entry_types).issubset(args.entry_types):
+            parser.error("All --view-entry-types must also be listed in --entry-types.")
+
+    if getattr(args, "string_offsets", False) and args.sequence_entry_types:
+        parser.error("--string-offsets cannot be combined with --sequence-entry-types.")
+
+    if getattr(args, "string_offsets", False) and args.cpp:
+        parser.error("--string-offsets cannot be combined with --cpp.")
+
+    if getattr(args, "repeated_arena", False):
+        if (
+            args.trusted_entry_types
+            or args.sequence_entry_types
+            or args.stream_bstr_types
+            or args.view_entry_types
+            or args.soa_types
+        ):
+            parser.error(
+                "--repeated-arena cannot be combined with --trusted-entry-types, "
+                "--sequence-entry-types, --stream-bstr-types, --view-entry-types or --soa-types."
+            )
+
     if hasattr(args, "output_c"):
         if not args.output_c or not args.output_h:
             if not args.output_cmake:
@@ -4642,6 +6164,12 @@ def process_code(args):
                 add_defines=args.defines,
                 default_bit_size=args.default_bit_size,
                 unordered_maps=args.unordered_maps,
+                repeated_arena=args.repeated_arena,
+                raw_types=args.raw_types,
+                soa_types=args.soa_types,
+                compact_types=args.compact_types,
+                string_offsets=args.string_offsets,
+                cpp=args.cpp,
                 short_names=args.short_names,
                 default_max_qty_define=default_max_qty_define,
             )
@@ -4649,6 +6177,26 @@ def process_code(args):
             print(format_parsing_error(e))
             sys.exit(1)
 
+    if args.decode:
+        for name in args.stream_bstr_types:
+            stream_type = cddl_res["decode"].my_types.get(name)
+            if (
+                stream_type is None
+                or stream_type.type != "BSTR"
+                or stream_type.cbor
+                or stream_type.value is not None
+            ):
+                print(f"--stream-bstr-types: {name} is not a bstr type without a value or .cbor.")
+                sys.exit(1)
+            stream_type.stream_bstr = True
+
+        for name in args.view_entry_types:
+            if error := cddl_res["decode"].my_types[name].view_error():
+                print(f"--view-entry-types: Cannot make a view of {name} because {error}.")
+                sys.exit(1)
+            for mode in modes:
+                cddl_res[mode].my_types[name].set_named_choice_enums()
+
     # Parsing is done, pretty print the result.
     verbose_print(args.verbose, "Parsed CDDL types:")
     for mode in modes:
@@ -4701,6 +6249,13 @@ def process_code(args):
         or Path(cmake_dir, "include", filenames + "_types.h")
     )
 
+    output_cpp = None
+    if args.cpp:
+        output_cpp = create_and_open(
+            (args.output_h and Path(args.output_h).with_suffix(".hpp"))
+            or Path(cmake_dir, "include", filenames + ".hpp")
+        )
+
     renderer = CodeRenderer(
         entry_types={
             mode: [cddl_res[mode].my_types[entry] for entry in args.entry_types] for mode in modes
@@ -4711,6 +6266,32 @@ def process_code(args):
         git_sha=git_sha,
         file_header=args.file_header,
         default_max_qty_define=default_max_qty_define,
+        trusted_entry_types=(
+            [cddl_res["decode"].my_types[entry] for entry in args.trusted_entry_types]
+            if args.decode
+            else []
+        ),
+        sequence_entry_types={
+            mode: [cddl_res[mode].my_types[entry] for entry in args.sequence_entry_types]
+            for mode in modes
+        },
+        external_state_entry_types={
+            mode: [cddl_res[mode].my_types[entry] for entry in args.external_state_entry_types]
+            for mode in modes
+        },
+        stream_entry_types=(
+            [cddl_res["decode"].my_types[entry] for entry in args.entry_types]
+            if args.decode and args.stream_bstr_types
+            else []
+        ),
+        profile_prefix=proj_name_as_symbol if args.profile else None,
+        repeated_arena=args.repeated_arena,
+        view_entry_types=(
+            [cddl_res["decode"].my_types[entry] for entry in args.view_entry_types]
+            if args.decode
+            else []
+        ),
+        string_offsets=args.string_offsets,
     )
 
     c_code_dir = C_SRC_PATH
@@ -4725,9 +6306,16 @@ def process_code(args):
         copyfile(Path(c_code_dir, "zcbor_print.c"), Path(new_c_code_dir, "zcbor_print.c"))
         copyfile(Path(h_code_dir, "zcbor_decode.h"), Path(new_h_code_dir, "zcbor_decode.h"))
         copyfile(Path(h_code_dir, "zcbor_encode.h"), Path(new_h_code_dir, "zcbor_encode.h"))
+        copyfile(
+            Path(h_code_dir, "zcbor_decode_inline.h"), Path(new_h_code_dir, "zcbor_decode_inline.h")
+        )
+        copyfile(
+            Path(h_code_dir, "zcbor_encode_inline.h"), Path(new_h_code_dir, "zcbor_encode_inline.h")
+        )
         copyfile(Path(h_code_dir, "zcbor_common.h"), Path(new_h_code_dir, "zcbor_common.h"))
         copyfile(Path(h_code_dir, "zcbor_tags.h"), Path(new_h_code_dir, "zcbor_tags.h"))
         copyfile(Path(h_code_dir, "zcbor_print.h"), Path(new_h_code_dir, "zcbor_print.h"))
+        copyfile(Path(h_code_dir, "zcbor.hpp"), Path(new_h_code_dir, "zcbor.hpp"))
         c_code_dir = new_c_code_dir
         h_code_dir = new_h_code_dir
 
@@ -4741,6 +6329,9 @@ def process_code(args):
         c_code_dir,
         h_code_dir,
         quiet=args.quiet,
+        cpp_file=output_cpp,
+        cpp_namespace=proj_name_as_symbol,
+        trace_ids_file=args.output_trace_ids and create_and_open(args.output_trace_ids),
     )
 
 
@@ -4813,6 +6404,56 @@ def process_convert(args):
     write_data(args, cddl, cbor_str)
 
 
+def process_trace(args):
+    mode = "decode" if args.decode else "encode"
+    trace_ids = json_load(Path(args.trace_ids).read_text(encoding="utf-8"))
+    if mode not in trace_ids:
+        print(f"{args.trace_ids} has no {mode} functions.")
+        sys.exit(1)
+    funcs = {int(trace_id): func for trace_id, func in trace_ids[mode].items()}
+    error_names = {0: "ZCBOR_SUCCESS"}
+    for name, val in getrp(r"#define (ZCBOR_ERR_\w+) (-?\d+)").findall(
+        Path(C_INCLUDE_PATH, "zcbor_common.h").read_text(encoding="utf-8")
+    ):
+        error_names.setdefault(int(val), name)
+
+    f = sys.stdin.buffer if args.input == "-" else open(args.input, "rb")
+    dump = f.read()
+    event_struct = Struct(">IIHBb" if args.big_endian else "<IIHBb")
+    events = list(event_struct.iter_unpack(dump[: len(dump) - len(dump) % event_struct.size]))
+
+    first = 0
+    if args.next is not None and args.next > len(events):
+        # The buffer has wrapped, so the oldest event is the one that will be overwritten next.
+        first = args.next - len(events)
+        start = args.next % len(events)
+        events = events[start:] + events[:start]
+    elif args.next is not None:
+        events = events[: args.next]
+
+    type_names = {1: "enter", 2: "success", 3: "fail", 4: "error"}
+    depth = 0
+    for i, (offset, elem_count, func_id, ev_type, error) in enumerate(events, start=first):
+        if ev_type not in type_names:
+            continue
+        if ev_type == 4:
+            what = error_names.get(error, f"error {error}")
+        elif func_id in funcs:
+            rule = funcs[func_id]["rule"]
+            what = funcs[func_id]["function"] + (f" ({rule})" if rule else "")
+        else:
+            what = f"unknown function id {func_id}"
+        if ev_type in (2, 3):
+            depth = max(depth - 1, 0)
+        print(
+            f"{i:6} {'  ' * depth}{type_names[ev_type]:7} {what}  "
+            f"offset={offset} elem_count={elem_count}"
+            + (f" error={error_names.get(error, error)}" if error and ev_type != 4 else "")
+        )
+        if ev_type == 1:
+            depth += 1
+
+
 def main():
     args = parse_args()
     args.process(args)